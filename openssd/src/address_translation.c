@@ -48,6 +48,7 @@
 #include <assert.h>
 #include "debug.h"
 #include "xil_printf.h"
+#include "xtime_l.h"
 
 #include "memory_map.h"
 #include "address_translation.h"
@@ -59,6 +60,9 @@ P_VIRTUAL_BLOCK_MAP virtualBlockMapPtr;
 P_VIRTUAL_DIE_MAP virtualDieMapPtr;
 P_PHY_BLOCK_MAP phyBlockMapPtr;
 P_BAD_BLOCK_TABLE_INFO_MAP bbtInfoMapPtr;
+GROWN_BAD_BLOCK_STAT grownBadBlockStat;
+
+static XTime bbtPendingTick; // when the oldest unpersisted grown bad block was marked
 
 unsigned int mbPerbadBlockSpace;
 
@@ -279,6 +283,7 @@ void InitDieMap()
         virtualDieMapPtr->die[dieNo].headFreeBlock = BLOCK_NONE;
         virtualDieMapPtr->die[dieNo].tailFreeBlock = BLOCK_NONE;
         virtualDieMapPtr->die[dieNo].freeBlockCnt  = 0;
+        virtualDieMapPtr->die[dieNo].pairedBlock   = BLOCK_NONE;
     }
 }
 
@@ -325,6 +330,7 @@ void InitBlockMap()
             virtualBlockMapPtr->block[dieNo][virtualBlockNo].invalidSliceCnt = 0;
             virtualBlockMapPtr->block[dieNo][virtualBlockNo].currentPage     = 0;
             virtualBlockMapPtr->block[dieNo][virtualBlockNo].eraseCnt        = 0;
+            virtualBlockMapPtr->block[dieNo][virtualBlockNo].inFlightProgCnt = 0;
 
             // bad block should not be added to free block list
             if (virtualBlockMapPtr->block[dieNo][virtualBlockNo].bad)
@@ -346,6 +352,31 @@ void InitBlockMap()
             pr_info("C/W[%u/%u] has %u free blocks", iCh, iWay, VDIE_ENTRY(PCH2VDIE(iCh, iWay))->freeBlockCnt);
 }
 
+#if (PLANE_PAIRED_BLOCKS)
+/**
+ * @brief Take a free block on another plane than the given block from the free block list.
+ *
+ * @param dieNo the die number of the given block.
+ * @param blockNo VBN of the block to be paired.
+ * @return unsigned int VBN of the paired block, or `BLOCK_NONE` if not found.
+ */
+static unsigned int GetPlanePairedFreeBlock(unsigned int dieNo, unsigned int blockNo)
+{
+    unsigned int plane, vba, depth;
+
+    if (VDIE_ENTRY(dieNo)->freeBlockCnt <= RESERVED_FREE_BLOCK_COUNT)
+        return BLOCK_NONE;
+
+    plane = Pblock2PlaneTranslation(PBLK_ENTRY(dieNo, VBA2PBA_TBS(blockNo))->remappedPhyBlock);
+    for (vba = VDIE_ENTRY(dieNo)->headFreeBlock, depth = 0; vba != BLOCK_NONE && depth < PLANE_PAIR_SCAN_DEPTH;
+         vba = VBLK_NEXT_IDX(dieNo, vba), depth++)
+        if (Pblock2PlaneTranslation(PBLK_ENTRY(dieNo, VBA2PBA_TBS(vba))->remappedPhyBlock) != plane)
+            return SelectiveGetFromFbList(dieNo, vba, GET_FREE_BLOCK_NORMAL);
+
+    return BLOCK_NONE;
+}
+#endif
+
 /**
  * @brief Get a default free block for each die.
  */
@@ -365,6 +396,9 @@ void InitCurrentBlockOfDieMap()
         }
 
         pr_info("Allocate VBlk %u for Die[%u]", VDIE_ENTRY(dieNo)->currentBlock, dieNo);
+#if (PLANE_PAIRED_BLOCKS)
+        VDIE_ENTRY(dieNo)->pairedBlock = GetPlanePairedFreeBlock(dieNo, VDIE_ENTRY(dieNo)->currentBlock);
+#endif
     }
 }
 
@@ -407,12 +441,12 @@ void ReadBadBlockTable(unsigned int tempBbtBufAddr[], unsigned int tempBbtBufEnt
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
 
-            reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.addr = tempBbtBufAddr[dieNo] + loop * tempBbtBufEntrySize;
+            REQ_DATA_BUF_INFO(reqSlotTag).addr = tempBbtBufAddr[dieNo] + loop * tempBbtBufEntrySize;
 
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh    = Vdie2PchTranslation(dieNo);
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay   = Vdie2PwayTranslation(dieNo);
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock = bbtInfoMapPtr->bbtInfo[dieNo].phyBlock;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage  = Vpage2PlsbPageTranslation(tempPage);
+            REQ_NAND_INFO(reqSlotTag).physicalCh    = Vdie2PchTranslation(dieNo);
+            REQ_NAND_INFO(reqSlotTag).physicalWay   = Vdie2PwayTranslation(dieNo);
+            REQ_NAND_INFO(reqSlotTag).physicalBlock = bbtInfoMapPtr->bbtInfo[dieNo].phyBlock;
+            REQ_NAND_INFO(reqSlotTag).physicalPage  = Vpage2PlsbPageTranslation(tempPage);
 
             SelectLowLevelReqQ(reqSlotTag);
         }
@@ -484,12 +518,12 @@ void FindBadBlock(unsigned char dieState[], unsigned int tempBbtBufAddr[], unsig
                 reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
                 reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
 
-                reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.addr = tempReadBufAddr[dieNo];
+                REQ_DATA_BUF_INFO(reqSlotTag).addr = tempReadBufAddr[dieNo];
 
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh    = Vdie2PchTranslation(dieNo);
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay   = Vdie2PwayTranslation(dieNo);
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock = phyBlockNo;
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage  = BAD_BLOCK_MARK_PAGE0;
+                REQ_NAND_INFO(reqSlotTag).physicalCh    = Vdie2PchTranslation(dieNo);
+                REQ_NAND_INFO(reqSlotTag).physicalWay   = Vdie2PwayTranslation(dieNo);
+                REQ_NAND_INFO(reqSlotTag).physicalBlock = phyBlockNo;
+                REQ_NAND_INFO(reqSlotTag).physicalPage  = BAD_BLOCK_MARK_PAGE0;
 
                 SelectLowLevelReqQ(reqSlotTag);
             }
@@ -520,12 +554,12 @@ void FindBadBlock(unsigned char dieState[], unsigned int tempBbtBufAddr[], unsig
                         REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace = REQ_OPT_BLOCK_SPACE_TOTAL;
 
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.addr = tempReadBufAddr[dieNo];
+                    REQ_DATA_BUF_INFO(reqSlotTag).addr = tempReadBufAddr[dieNo];
 
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh    = chNo;
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay   = wayNo;
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock = phyBlockNo;
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage  = BAD_BLOCK_MARK_PAGE1;
+                    REQ_NAND_INFO(reqSlotTag).physicalCh    = chNo;
+                    REQ_NAND_INFO(reqSlotTag).physicalWay   = wayNo;
+                    REQ_NAND_INFO(reqSlotTag).physicalBlock = phyBlockNo;
+                    REQ_NAND_INFO(reqSlotTag).physicalPage  = BAD_BLOCK_MARK_PAGE1;
 
                     SelectLowLevelReqQ(reqSlotTag);
                 }
@@ -610,11 +644,10 @@ void SaveBadBlockTable(unsigned char dieState[], unsigned int tempBbtBufAddr[],
                         REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace = REQ_OPT_BLOCK_SPACE_TOTAL;
 
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh  = Vdie2PchTranslation(dieNo);
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay = Vdie2PwayTranslation(dieNo);
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock =
-                        bbtInfoMapPtr->bbtInfo[dieNo].phyBlock;
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage = 0; // dummy
+                    REQ_NAND_INFO(reqSlotTag).physicalCh    = Vdie2PchTranslation(dieNo);
+                    REQ_NAND_INFO(reqSlotTag).physicalWay   = Vdie2PwayTranslation(dieNo);
+                    REQ_NAND_INFO(reqSlotTag).physicalBlock = bbtInfoMapPtr->bbtInfo[dieNo].phyBlock;
+                    REQ_NAND_INFO(reqSlotTag).physicalPage  = 0; // dummy
 
                     SelectLowLevelReqQ(reqSlotTag);
                 }
@@ -630,13 +663,12 @@ void SaveBadBlockTable(unsigned char dieState[], unsigned int tempBbtBufAddr[],
                 reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
                 reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
 
-                reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.addr =
-                    tempBbtBufAddr[dieNo] + loop * tempBbtBufEntrySize;
+                REQ_DATA_BUF_INFO(reqSlotTag).addr = tempBbtBufAddr[dieNo] + loop * tempBbtBufEntrySize;
 
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh    = Vdie2PchTranslation(dieNo);
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay   = Vdie2PwayTranslation(dieNo);
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock = bbtInfoMapPtr->bbtInfo[dieNo].phyBlock;
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage  = Vpage2PlsbPageTranslation(tempPage);
+                REQ_NAND_INFO(reqSlotTag).physicalCh    = Vdie2PchTranslation(dieNo);
+                REQ_NAND_INFO(reqSlotTag).physicalWay   = Vdie2PwayTranslation(dieNo);
+                REQ_NAND_INFO(reqSlotTag).physicalBlock = bbtInfoMapPtr->bbtInfo[dieNo].phyBlock;
+                REQ_NAND_INFO(reqSlotTag).physicalPage  = Vpage2PlsbPageTranslation(tempPage);
 
                 SelectLowLevelReqQ(reqSlotTag);
             }
@@ -780,10 +812,10 @@ void EraseTotalBlockSpace()
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
 
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh    = Vdie2PchTranslation(dieNo);
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay   = Vdie2PwayTranslation(dieNo);
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock = blockNo;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage  = 0;
+            REQ_NAND_INFO(reqSlotTag).physicalCh    = Vdie2PchTranslation(dieNo);
+            REQ_NAND_INFO(reqSlotTag).physicalWay   = Vdie2PwayTranslation(dieNo);
+            REQ_NAND_INFO(reqSlotTag).physicalBlock = blockNo;
+            REQ_NAND_INFO(reqSlotTag).physicalPage  = 0;
 
             SelectLowLevelReqQ(reqSlotTag);
         }
@@ -814,7 +846,7 @@ void EraseUserBlockSpace()
                 reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
                 reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_MAIN;
 
-                reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr = Vorg2VsaTranslation(dieNo, blockNo, 0);
+                REQ_NAND_INFO(reqSlotTag).virtualSliceAddr = Vorg2VsaTranslation(dieNo, blockNo, 0);
 
                 SelectLowLevelReqQ(reqSlotTag);
             }
@@ -990,6 +1022,12 @@ unsigned int AddrTransWrite(unsigned int logicalSliceAddr)
  *      Current implementation just selects the free page sequentially from the current
  *      working block.
  *
+ *  - `VIRTUAL_DIE_ENTRY::pairedBlock`:
+ *
+ *      If `PLANE_PAIRED_BLOCKS` is enabled, the paired block is filled up to the page
+ *      offset of the current block before the current block moves on, so the two writes
+ *      of the same page offset can be programmed by one multi-plane program.
+ *
  * @sa `VIRTUAL_DIE_ENTRY`, `VIRTUAL_BLOCK_ENTRY`, `FindDieForFreeSliceAllocation()`.
  *
  * @warning why the `currentPage` might be full after GC?
@@ -1000,10 +1038,28 @@ unsigned int AddrTransWrite(unsigned int logicalSliceAddr)
 unsigned int FindFreeVirtualSlice()
 {
     unsigned int currentBlock, virtualSliceAddr, dieNo;
+#if (PLANE_PAIRED_BLOCKS)
+    unsigned int pairedBlock;
+#endif
 
     dieNo        = sliceAllocationTargetDie;
     currentBlock = virtualDieMapPtr->die[dieNo].currentBlock;
 
+#if (PLANE_PAIRED_BLOCKS)
+    // keep the paired block at the same page offset as the current block
+    pairedBlock = virtualDieMapPtr->die[dieNo].pairedBlock;
+    if (pairedBlock != BLOCK_NONE && !nmcInterleaving &&
+        virtualBlockMapPtr->block[dieNo][pairedBlock].currentPage <
+            virtualBlockMapPtr->block[dieNo][currentBlock].currentPage)
+    {
+        virtualSliceAddr =
+            Vorg2VsaTranslation(dieNo, pairedBlock, virtualBlockMapPtr->block[dieNo][pairedBlock].currentPage);
+        virtualBlockMapPtr->block[dieNo][pairedBlock].currentPage++;
+        sliceAllocationTargetDie = FindDieForFreeSliceAllocation();
+        return virtualSliceAddr;
+    }
+#endif
+
     // if the currently used block is full, assign a free block as new current block
     if (virtualBlockMapPtr->block[dieNo][currentBlock].currentPage == USER_PAGES_PER_BLOCK)
     {
@@ -1031,6 +1087,12 @@ unsigned int FindFreeVirtualSlice()
 
         // NMC: record the PBN of the new block if in NMC mode
         nmcRecordBlock(dieNo, currentBlock);
+
+#if (PLANE_PAIRED_BLOCKS)
+        // the previous paired block must be full here, pair the new current block
+        if (!nmcInterleaving)
+            virtualDieMapPtr->die[dieNo].pairedBlock = GetPlanePairedFreeBlock(dieNo, currentBlock);
+#endif
     }
     else if (virtualBlockMapPtr->block[dieNo][currentBlock].currentPage > USER_PAGES_PER_BLOCK)
         assert(!"[WARNING] Current page management fail [WARNING]");
@@ -1142,10 +1204,15 @@ void InvalidateOldVsa(unsigned int logicalSliceAddr)
         dieNo   = Vsa2VdieTranslation(virtualSliceAddr);
         blockNo = Vsa2VblockTranslation(virtualSliceAddr);
 
+        logicalSliceMapPtr->logicalSlice[logicalSliceAddr].virtualSliceAddr = VSA_NONE;
+
+        // a grown bad block is not linked in any list, check `MarkGrownBadVirtualBlock()`
+        if (virtualBlockMapPtr->block[dieNo][blockNo].bad)
+            return;
+
         // unlink
         SelectiveGetFromGcVictimList(dieNo, blockNo);
         virtualBlockMapPtr->block[dieNo][blockNo].invalidSliceCnt++;
-        logicalSliceMapPtr->logicalSlice[logicalSliceAddr].virtualSliceAddr = VSA_NONE;
 
         PutToGcVictimList(dieNo, blockNo, virtualBlockMapPtr->block[dieNo][blockNo].invalidSliceCnt);
     }
@@ -1179,9 +1246,8 @@ void EraseBlock(unsigned int dieNo, unsigned int blockNo)
     reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_NONE;
     reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
     reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_MAIN;
-    reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr     = Vorg2VsaTranslation(dieNo, blockNo, 0);
-    reqPoolPtr->reqPool[reqSlotTag].nandInfo.programmedPageCnt =
-        virtualBlockMapPtr->block[dieNo][blockNo].currentPage;
+    REQ_NAND_INFO(reqSlotTag).virtualSliceAddr                    = Vorg2VsaTranslation(dieNo, blockNo, 0);
+    REQ_NAND_INFO(reqSlotTag).programmedPageCnt = virtualBlockMapPtr->block[dieNo][blockNo].currentPage;
 
     SelectLowLevelReqQ(reqSlotTag);
 
@@ -1190,6 +1256,13 @@ void EraseBlock(unsigned int dieNo, unsigned int blockNo)
     virtualBlockMapPtr->block[dieNo][blockNo].eraseCnt++;
     virtualBlockMapPtr->block[dieNo][blockNo].invalidSliceCnt = 0;
     virtualBlockMapPtr->block[dieNo][blockNo].currentPage     = 0;
+    ResetReadDisturb(dieNo, blockNo);
+
+#if (PLANE_PAIRED_BLOCKS)
+    // the paired block was chosen as a GC victim before it was filled
+    if (virtualDieMapPtr->die[dieNo].pairedBlock == blockNo)
+        virtualDieMapPtr->die[dieNo].pairedBlock = BLOCK_NONE;
+#endif
 
     PutToFbList(dieNo, blockNo);
 
@@ -1287,8 +1360,17 @@ unsigned int GetFromFbList(unsigned int dieNo, unsigned int getFreeBlockOption)
  */
 void UpdatePhyBlockMapForGrownBadBlock(unsigned int dieNo, unsigned int phyBlockNo)
 {
+    // the following requests on the block may fail as well
+    if (phyBlockMapPtr->phyBlock[dieNo][phyBlockNo].bad == BLOCK_STATE_BAD)
+        return;
+
     phyBlockMapPtr->phyBlock[dieNo][phyBlockNo].bad = BLOCK_STATE_BAD;
     bbtInfoMapPtr->bbtInfo[dieNo].grownBadUpdate    = BBT_INFO_GROWN_BAD_UPDATE_BOOKED;
+
+    if (!grownBadBlockStat.bbtPendingCnt)
+        XTime_GetTime(&bbtPendingTick);
+    grownBadBlockStat.bbtPendingCnt++;
+    grownBadBlockStat.markedCnt++;
 }
 
 /**
@@ -1336,4 +1418,172 @@ void UpdateBadBlockTableForGrownBadBlock(unsigned int tempBufAddr)
 
     // update bad block tables in flash
     SaveBadBlockTable(dieState, tempBbtBufAddr, tempBbtBufEntrySize);
+
+    for (dieNo = 0; dieNo < USER_DIES; dieNo++)
+        if (dieState[dieNo] == DIE_STATE_BAD_BLOCK_TABLE_UPDATE)
+            bbtInfoMapPtr->bbtInfo[dieNo].grownBadUpdate = BBT_INFO_GROWN_BAD_UPDATE_NONE;
+    grownBadBlockStat.bbtPendingCnt = 0;
+}
+
+/**
+ * @brief Persist the grown bad blocks to the bbt in batches, check `GROWN_BAD_BLOCK_SALVAGE`.
+ *
+ * @note The bbt is still flushed on shutdown regardless of this function.
+ */
+void UpdateBadBlockTableLazily()
+{
+    XTime now, waited;
+
+    if (!grownBadBlockStat.bbtPendingCnt)
+        return;
+
+    XTime_GetTime(&now);
+    waited = now - bbtPendingTick;
+
+    if (waited < (XTime)GROWN_BAD_BBT_MAX_DELAY_MS * COUNTS_PER_SECOND / 1000)
+    {
+        if (notCompletedNandReqCnt || blockedReqCnt)
+            return;
+        if (grownBadBlockStat.bbtPendingCnt < GROWN_BAD_BBT_BATCH &&
+            waited < (XTime)GROWN_BAD_BBT_DELAY_MS * COUNTS_PER_SECOND / 1000)
+            return;
+    }
+
+    pr_info("Persist %u grown bad blocks to the bbt", grownBadBlockStat.bbtPendingCnt);
+    UpdateBadBlockTableForGrownBadBlock(RESERVED_DATA_BUFFER_BASE_ADDR);
+    grownBadBlockStat.bbtSavedCnt++;
+}
+
+/**
+ * @brief Take a virtual block that has just grown bad out of service.
+ *
+ * The block is removed from the free block list or the GC victim list and never goes back
+ * to them, since a bad block is never erased. If the block is still open for the slice
+ * allocation, it's closed so that the following slices are allocated from a fresh block.
+ * A used block is then queued for the evacuation of its valid slices.
+ *
+ * @param dieNo the die number of the block.
+ * @param blockNo the virtual block number of the block.
+ */
+void MarkGrownBadVirtualBlock(unsigned int dieNo, unsigned int blockNo)
+{
+    P_VIRTUAL_BLOCK_ENTRY blockEntry = &virtualBlockMapPtr->block[dieNo][blockNo];
+    unsigned int prevBlock, nextBlock;
+
+    if (blockEntry->bad)
+        return;
+
+    if (blockEntry->free)
+    {
+        // the erase failed, the block holds no valid slice
+        prevBlock = blockEntry->prevBlock;
+        nextBlock = blockEntry->nextBlock;
+
+        if (prevBlock != BLOCK_NONE)
+            virtualBlockMapPtr->block[dieNo][prevBlock].nextBlock = nextBlock;
+        else
+            virtualDieMapPtr->die[dieNo].headFreeBlock = nextBlock;
+
+        if (nextBlock != BLOCK_NONE)
+            virtualBlockMapPtr->block[dieNo][nextBlock].prevBlock = prevBlock;
+        else
+            virtualDieMapPtr->die[dieNo].tailFreeBlock = prevBlock;
+
+        blockEntry->free = 0;
+        virtualDieMapPtr->die[dieNo].freeBlockCnt--;
+    }
+    else
+    {
+        // only the blocks with invalid slices are linked in the victim lists
+        if (blockEntry->invalidSliceCnt)
+            SelectiveGetFromGcVictimList(dieNo, blockNo);
+
+        if (virtualDieMapPtr->die[dieNo].currentBlock == blockNo)
+            blockEntry->currentPage = USER_PAGES_PER_BLOCK;
+#if (PLANE_PAIRED_BLOCKS)
+        if (virtualDieMapPtr->die[dieNo].pairedBlock == blockNo)
+            virtualDieMapPtr->die[dieNo].pairedBlock = BLOCK_NONE;
+#endif
+
+        QueueGrownBadBlock(dieNo, blockNo);
+    }
+
+    blockEntry->bad       = 1;
+    blockEntry->prevBlock = BLOCK_NONE;
+    blockEntry->nextBlock = BLOCK_NONE;
+
+    pr_warn("Die[%u] block %u is taken out of service as a grown bad block", dieNo, blockNo);
+}
+
+/**
+ * @brief Dispatch a failed program again to a fresh page of the same die.
+ *
+ * The request keeps its data buffer entry, so the data of the slice is still there and
+ * the requests blocked by the entry are released only after the new program finishes.
+ *
+ * @param reqSlotTag the request pool entry index of the failed request.
+ * @return unsigned int 1 if the request is dispatched again, 0 if it should be released.
+ */
+unsigned int RetargetFailedProgram(unsigned int reqSlotTag)
+{
+    unsigned int logicalSliceAddr, failedSliceAddr, virtualSliceAddr;
+
+    if (reqPoolPtr->reqPool[reqSlotTag].reqCode != REQ_CODE_WRITE ||
+        reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr != REQ_OPT_NAND_ADDR_VSA ||
+        reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace != REQ_OPT_BLOCK_SPACE_MAIN)
+        return 0;
+
+    failedSliceAddr  = REQ_NAND_INFO(reqSlotTag).virtualSliceAddr;
+    logicalSliceAddr = virtualSliceMapPtr->virtualSlice[failedSliceAddr].logicalSliceAddr;
+
+    // the slice may have been overwritten or trimmed since the program was issued
+    if (logicalSliceAddr == LSA_NONE ||
+        logicalSliceMapPtr->logicalSlice[logicalSliceAddr].virtualSliceAddr != failedSliceAddr)
+        return 0;
+
+    // the failed block has been closed by `MarkGrownBadVirtualBlock()`
+    virtualSliceAddr = FindFreeVirtualSliceForGc(Vsa2VdieTranslation(failedSliceAddr),
+                                                 Vsa2VblockTranslation(failedSliceAddr));
+
+    virtualSliceMapPtr->virtualSlice[failedSliceAddr].logicalSliceAddr  = LSA_NONE;
+    virtualSliceMapPtr->virtualSlice[virtualSliceAddr].logicalSliceAddr = logicalSliceAddr;
+    logicalSliceMapPtr->logicalSlice[logicalSliceAddr].virtualSliceAddr = virtualSliceAddr;
+    REQ_NAND_INFO(reqSlotTag).virtualSliceAddr                          = virtualSliceAddr;
+
+    SelectLowLevelReqQ(reqSlotTag);
+    grownBadBlockStat.retargetedCnt++;
+
+    pr_debug("Req[%u]: LSA %u retargeted from VSA %u to VSA %u", reqSlotTag, logicalSliceAddr, failedSliceAddr,
+             virtualSliceAddr);
+    return 1;
+}
+
+/**
+ * @brief Count a program in or out of the in-flight programs of its target block.
+ *
+ * Only the programs to the main block space are counted. The evacuation of a grown bad
+ * block waits until its count drops to zero, check `RefreshQueuedBlock()`.
+ *
+ * @param reqSlotTag the request pool entry index of the NAND request.
+ * @param issued 1 if the request is being dispatched, 0 if it has been completed.
+ */
+void UpdateInFlightProgramCnt(unsigned int reqSlotTag, unsigned int issued)
+{
+    P_VIRTUAL_BLOCK_ENTRY blockEntry;
+    unsigned int virtualSliceAddr;
+
+    if (reqPoolPtr->reqPool[reqSlotTag].reqType != REQ_TYPE_NAND ||
+        reqPoolPtr->reqPool[reqSlotTag].reqCode != REQ_CODE_WRITE ||
+        reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr != REQ_OPT_NAND_ADDR_VSA ||
+        reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace != REQ_OPT_BLOCK_SPACE_MAIN)
+        return;
+
+    virtualSliceAddr = REQ_NAND_INFO(reqSlotTag).virtualSliceAddr;
+    blockEntry =
+        &virtualBlockMapPtr->block[Vsa2VdieTranslation(virtualSliceAddr)][Vsa2VblockTranslation(virtualSliceAddr)];
+
+    if (issued)
+        blockEntry->inFlightProgCnt++;
+    else
+        blockEntry->inFlightProgCnt--;
 }
@@ -68,6 +68,42 @@
 
 #define RESERVED_FREE_BLOCK_COUNT 0x1
 
+/**
+ * @brief Write each die through a pair of current blocks on different planes.
+ *
+ * With multi-plane operations, the pages of the same offset in two blocks on different
+ * planes of a LUN can be programmed by a single multi-plane program. Thus each die keeps
+ * a paired block (`VIRTUAL_DIE_ENTRY::pairedBlock`) beside its current block and fills
+ * them page by page alternately, so that consecutive writes to the same die can be
+ * coalesced by the scheduler. The paired block is searched within the first
+ * `PLANE_PAIR_SCAN_DEPTH` free blocks, and the die falls back to a single current block
+ * if no block on another plane is found.
+ *
+ * @sa `FindFreeVirtualSlice()`, `NAND_MULTI_PLANE`.
+ */
+#define PLANE_PAIRED_BLOCKS   V2F_MULTI_PLANE_SUPPORTED
+#define PLANE_PAIR_SCAN_DEPTH 16
+
+/**
+ * @brief Handle the grown bad blocks without stalling the host requests.
+ *
+ * When a request on a virtual block fails, the block is only marked here and taken out of
+ * the free block list, the GC victim lists and the slice allocation, check
+ * `MarkGrownBadVirtualBlock()`. A failed program of a valid slice is then retargeted to a
+ * fresh page of the same die and dispatched again with the same data buffer, check
+ * `RetargetFailedProgram()`, and the remaining valid slices of the block are evacuated in
+ * the background by `RefreshQueuedBlock()`.
+ *
+ * The new bad blocks are persisted to the bbt lazily, check `UpdateBadBlockTableLazily()`:
+ * the bbt is written once `GROWN_BAD_BBT_BATCH` blocks are pending or the oldest pending
+ * one has waited for `GROWN_BAD_BBT_DELAY_MS`, but only while there is no NAND request in
+ * flight, unless the oldest one has waited for `GROWN_BAD_BBT_MAX_DELAY_MS`.
+ */
+#define GROWN_BAD_BLOCK_SALVAGE    1
+#define GROWN_BAD_BBT_BATCH        8
+#define GROWN_BAD_BBT_DELAY_MS     1000
+#define GROWN_BAD_BBT_MAX_DELAY_MS 10000
+
 #define GET_FREE_BLOCK_NORMAL 0x0 // get free block for normal request
 #define GET_FREE_BLOCK_GC     0x1 // get free block for gc request
 
@@ -160,6 +196,13 @@
 #define Vblock2PblockOfMbsTranslation(blockNo)                                                                    \
     (((blockNo) / (USER_BLOCKS_PER_LUN)) * (MAIN_BLOCKS_PER_LUN) + ((blockNo) % (USER_BLOCKS_PER_LUN)))
 
+/**
+ * @brief Get the plane number of the given physical block.
+ *
+ * @note The given PBN should be the remapped one.
+ */
+#define Pblock2PlaneTranslation(blockNo) (((blockNo) % (TOTAL_BLOCKS_PER_LUN)) % (PLANES_PER_LUN))
+
 /**
  * @brief Map the virtual page to the physical LSB page in SLC mode.
  *
@@ -236,7 +279,7 @@ typedef struct _VIRTUAL_BLOCK_ENTRY
     unsigned int bad : 1;              // 1 indicates that this block is bad block
     unsigned int free : 1;             // 1 indicates that this block is free block
     unsigned int invalidSliceCnt : 16; // how many invalid slices in this block
-    unsigned int reserved0 : 10;       //
+    unsigned int inFlightProgCnt : 10; // programs issued to this block but not completed yet
     unsigned int currentPage : 16;     // the current working page number of this block
     unsigned int eraseCnt : 16;        // how many times this block have been erased
     unsigned int prevBlock : 16;       // VBN of the prev block in free/victim block list
@@ -264,7 +307,7 @@ typedef struct _VIRTUAL_DIE_ENTRY
     unsigned int freeBlockCnt : 16;  // how many free blocks on this die
     unsigned int prevDie : 8;
     unsigned int nextDie : 8;
-    unsigned int reserved0 : 16;
+    unsigned int pairedBlock : 16; // the current block on another plane, check `PLANE_PAIRED_BLOCKS`
 } VIRTUAL_DIE_ENTRY, *P_VIRTUAL_DIE_ENTRY;
 
 /**
@@ -324,6 +367,26 @@ typedef struct _PHY_BLOCK_MAP
     PHY_BLOCK_ENTRY phyBlock[USER_DIES][TOTAL_BLOCKS_PER_DIE];
 } PHY_BLOCK_MAP, *P_PHY_BLOCK_MAP;
 
+/**
+ * @brief The statistics of the grown bad block handling, check `GROWN_BAD_BLOCK_SALVAGE`.
+ *
+ * - markedCnt: physical blocks marked as grown bad blocks
+ * - retargetedCnt: failed programs dispatched again to a fresh page
+ * - queuedCnt: virtual blocks queued for evacuation
+ * - ringFullCnt: virtual blocks not queued since the ring was full
+ * - bbtPendingCnt: grown bad blocks not persisted to the bbt yet
+ * - bbtSavedCnt: times the bbt was updated for grown bad blocks
+ */
+typedef struct _GROWN_BAD_BLOCK_STAT
+{
+    unsigned int markedCnt;
+    unsigned int retargetedCnt;
+    unsigned int queuedCnt;
+    unsigned int ringFullCnt;
+    unsigned int bbtPendingCnt;
+    unsigned int bbtSavedCnt;
+} GROWN_BAD_BLOCK_STAT, *P_GROWN_BAD_BLOCK_STAT;
+
 void InitAddressMap();
 void InitSliceMap();
 void InitBlockDieMap();
@@ -349,6 +412,10 @@ uint32_t SelectiveGetFromFbList(uint32_t dieNo, uint32_t targetBlk, uint32_t mod
 
 void UpdatePhyBlockMapForGrownBadBlock(unsigned int dieNo, unsigned int phyBlockNo);
 void UpdateBadBlockTableForGrownBadBlock(unsigned int tempBufAddr);
+void UpdateBadBlockTableLazily();
+void MarkGrownBadVirtualBlock(unsigned int dieNo, unsigned int blockNo);
+unsigned int RetargetFailedProgram(unsigned int reqSlotTag);
+void UpdateInFlightProgramCnt(unsigned int reqSlotTag, unsigned int issued);
 
 extern P_LOGICAL_SLICE_MAP logicalSliceMapPtr;
 extern P_VIRTUAL_SLICE_MAP virtualSliceMapPtr;
@@ -356,6 +423,7 @@ extern P_VIRTUAL_BLOCK_MAP virtualBlockMapPtr;
 extern P_VIRTUAL_DIE_MAP virtualDieMapPtr;
 extern P_PHY_BLOCK_MAP phyBlockMapPtr;
 extern P_BAD_BLOCK_TABLE_INFO_MAP bbtInfoMapPtr;
+extern GROWN_BAD_BLOCK_STAT grownBadBlockStat;
 
 extern unsigned char sliceAllocationTargetDie;
 extern unsigned int mbPerbadBlockSpace;
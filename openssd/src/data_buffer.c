@@ -54,13 +54,46 @@ P_DATA_BUF_MAP dataBufMapPtr;
 DATA_BUF_LRU_LIST dataBufLruList;
 P_DATA_BUF_HASH_TABLE dataBufHashTablePtr;
 P_TEMPORARY_DATA_BUF_MAP tempDataBufMapPtr;
+DATA_BUF_FILL_STAT dataBufFillStat;
+DATA_BUF_BYPASS_LIST dataBufBypassList;
+DATA_BUF_CACHE_STAT dataBufCacheStat;
+DATA_BUF_BYPASS_STREAM dataBufBypassStream[2]; // 0 for read, 1 for write
+DATA_BUF_PARTITION_INFO dataBufPartition;
+
+static unsigned char tempDataBufCursor[USER_DIES]; // the next temp entry of each die
+
+/**
+ * @brief Validate the configured sizing of data buffers against the DRAM layout.
+ *
+ * All the regions are derived from the build-time configuration (check `data_buffer.h`
+ * and `memory_map.h`), so most of the checks are done at compile time. The resulting
+ * layout is printed during boot for the deployment to review.
+ */
+static void CheckDataBufLayout()
+{
+    // the entry indices are stored in 16-bit fields and `DATA_BUF_NONE` is reserved
+    STATIC_ASSERT(AVAILABLE_DATA_BUFFER_ENTRY_COUNT < DATA_BUF_NONE);
+    STATIC_ASSERT(DATA_BUF_BYPASS_ENTRY_COUNT < AVAILABLE_DATA_BUFFER_ENTRY_COUNT);
+    STATIC_ASSERT(DATA_BUF_HASH_BUCKET_COUNT > 0);
+    STATIC_ASSERT(TEMP_BUF_ENTRIES_PER_DIE > 0 && TEMP_BUF_ENTRIES_PER_DIE < 256);
+
+    // the buffers are in the uncached region, while the maps are in the cached region
+    STATIC_ASSERT(MONITOR_END_ADDR <= DATA_BUFFER_LIMIT_ADDR);
+    STATIC_ASSERT(FTL_MANAGEMENT_END_ADDR < RESERVED1_END_ADDR);
+
+    pr_info("Data Buffer: %u entries (%u transient), %u hash buckets, %u temp entries",
+            AVAILABLE_DATA_BUFFER_ENTRY_COUNT, DATA_BUF_BYPASS_ENTRY_COUNT, DATA_BUF_HASH_BUCKET_COUNT,
+            AVAILABLE_TEMPORARY_DATA_BUFFER_ENTRY_COUNT);
+    pr_info("Data Buffer Range: %X ~ %X (limit %X)", DATA_BUFFER_BASE_ADDR, MONITOR_END_ADDR, DATA_BUFFER_LIMIT_ADDR);
+    pr_info("FTL Management Range: %X ~ %X", DATA_BUFFER_MAP_ADDR, FTL_MANAGEMENT_END_ADDR);
+}
 
 /**
  * @brief Initialization process of the Data buffer.
  *
  * Three buffer related lists will be initialized in this function
  *
- * There are `16 x NUM_DIES` entries in the `dataBuf`, and all the elements of `dataBuf`
+ * There are `AVAILABLE_DATA_BUFFER_ENTRY_COUNT` entries in the `dataBuf`, and all the elements of `dataBuf`
  * will be initialized to:
  *
  * - logicalSliceAddr: not belongs to any request yet, thus just point to LSA_NONE (0xffffffff)
@@ -71,25 +104,31 @@ P_TEMPORARY_DATA_BUF_MAP tempDataBufMapPtr;
  * - dirty flag is not set
  * - blockingReqTail: no blocking request at the beginning, thus points to none
  * - dontCache: this buffer entry should not be cached (be inserted into hash list)
+ * - sectorValid: all the NVMe blocks are treated as valid
  *
- * There are `16 x NUM_DIES` entries in the `dataBufHashTable`, and all the elements will
- * be initialized to empty bucket, so:
+ * There are `DATA_BUF_HASH_BUCKET_COUNT` entries in the `dataBufHashTable`, and all the
+ * elements will be initialized to empty bucket, so:
  *
  * - headEntry and tailEntry both point to DATA_BUF_NONE (0xffff = 65535)
  *
- * There are `NUM_DIES` entries in the `tempDataBuf`, and all the elements of it will be
- * initialized to:
+ * There are `AVAILABLE_TEMPORARY_DATA_BUFFER_ENTRY_COUNT` entries in the `tempDataBuf`, and
+ * all the elements of it will be initialized to:
  *
  * - blockingReqTail: no blocking request at the beginning, thus points to none
  *
- * And the head/tail of `dataBufLruList` points to the first/last entry of `dataBuf`, this
- * means the initial `dataBufLruList` contains all the data buffer entries, therefore the
- * data buffer should be allocated from the last element of `dataBuf` array.
+ * And the head/tail of `dataBufLruList` points to the first/last cached entry of `dataBuf`,
+ * this means the initial `dataBufLruList` contains all the cached data buffer entries,
+ * therefore the data buffer should be allocated from the last cached element of `dataBuf`.
+ *
+ * The remaining `DATA_BUF_BYPASS_ENTRY_COUNT` entries are transient entries, they are
+ * linked into `dataBufBypassList` and marked as `DATA_BUF_SKIP_CACHE`.
  */
 void InitDataBuf()
 {
     int bufEntry;
 
+    CheckDataBufLayout();
+
     dataBufMapPtr       = (P_DATA_BUF_MAP)DATA_BUFFER_MAP_ADDR;
     dataBufHashTablePtr = (P_DATA_BUF_HASH_TABLE)DATA_BUFFFER_HASH_TABLE_ADDR;
     tempDataBufMapPtr   = (P_TEMPORARY_DATA_BUF_MAP)TEMPORARY_DATA_BUFFER_MAP_ADDR;
@@ -102,21 +141,64 @@ void InitDataBuf()
         dataBufMapPtr->dataBuf[bufEntry].dirty            = DATA_BUF_CLEAN;
         dataBufMapPtr->dataBuf[bufEntry].phyReq           = DATA_BUF_FOR_LOG_REQ;
         dataBufMapPtr->dataBuf[bufEntry].dontCache        = DATA_BUF_KEEP_CACHE;
+        dataBufMapPtr->dataBuf[bufEntry].sectorValid      = DATA_BUF_SECTOR_FULL;
+        dataBufMapPtr->dataBuf[bufEntry].chargedDie       = DATA_BUF_DIE_NONE;
         dataBufMapPtr->dataBuf[bufEntry].blockingReqTail  = REQ_SLOT_TAG_NONE;
 
+        dataBufMapPtr->dataBuf[bufEntry].hashPrevEntry = DATA_BUF_NONE;
+        dataBufMapPtr->dataBuf[bufEntry].hashNextEntry = DATA_BUF_NONE;
+    }
+
+    for (bufEntry = 0; bufEntry < DATA_BUF_HASH_BUCKET_COUNT; bufEntry++)
+    {
         dataBufHashTablePtr->dataBufHash[bufEntry].headEntry = DATA_BUF_NONE;
         dataBufHashTablePtr->dataBufHash[bufEntry].tailEntry = DATA_BUF_NONE;
-        dataBufMapPtr->dataBuf[bufEntry].hashPrevEntry       = DATA_BUF_NONE;
-        dataBufMapPtr->dataBuf[bufEntry].hashNextEntry       = DATA_BUF_NONE;
     }
 
-    dataBufMapPtr->dataBuf[0].prevEntry                                     = DATA_BUF_NONE;
-    dataBufMapPtr->dataBuf[AVAILABLE_DATA_BUFFER_ENTRY_COUNT - 1].nextEntry = DATA_BUF_NONE;
-    dataBufLruList.headEntry                                                = 0;
-    dataBufLruList.tailEntry = AVAILABLE_DATA_BUFFER_ENTRY_COUNT - 1;
+    dataBufMapPtr->dataBuf[0].prevEntry                              = DATA_BUF_NONE;
+    dataBufMapPtr->dataBuf[DATA_BUF_BYPASS_BASE_ENTRY - 1].nextEntry = DATA_BUF_NONE;
+    dataBufLruList.headEntry                                         = 0;
+    dataBufLruList.tailEntry                                         = DATA_BUF_BYPASS_BASE_ENTRY - 1;
+
+    // the transient entries are not in the LRU list
+    for (bufEntry = DATA_BUF_BYPASS_BASE_ENTRY; bufEntry < AVAILABLE_DATA_BUFFER_ENTRY_COUNT; bufEntry++)
+    {
+        dataBufMapPtr->dataBuf[bufEntry].prevEntry = DATA_BUF_NONE;
+        dataBufMapPtr->dataBuf[bufEntry].dontCache = DATA_BUF_SKIP_CACHE;
+    }
+    if (DATA_BUF_BYPASS_ENTRY_COUNT)
+    {
+        dataBufMapPtr->dataBuf[AVAILABLE_DATA_BUFFER_ENTRY_COUNT - 1].nextEntry = DATA_BUF_NONE;
+        dataBufBypassList.headEntry                                             = DATA_BUF_BYPASS_BASE_ENTRY;
+    }
+    else
+        dataBufBypassList.headEntry = DATA_BUF_NONE;
+    dataBufBypassList.freeCnt = DATA_BUF_BYPASS_ENTRY_COUNT;
+
+    dataBufBypassStream[0].nextLba       = 0;
+    dataBufBypassStream[0].runNvmeBlocks = 0;
+    dataBufBypassStream[1].nextLba       = 0;
+    dataBufBypassStream[1].runNvmeBlocks = 0;
 
     for (bufEntry = 0; bufEntry < AVAILABLE_TEMPORARY_DATA_BUFFER_ENTRY_COUNT; bufEntry++)
         tempDataBufMapPtr->tempDataBuf[bufEntry].blockingReqTail = REQ_SLOT_TAG_NONE;
+    for (bufEntry = 0; bufEntry < USER_DIES; bufEntry++)
+        tempDataBufCursor[bufEntry] = 0;
+
+    dataBufFillStat.deferredCnt  = 0;
+    dataBufFillStat.avoidedCnt   = 0;
+    dataBufFillStat.performedCnt = 0;
+
+    dataBufCacheStat.hitCnt            = 0;
+    dataBufCacheStat.missCnt           = 0;
+    dataBufCacheStat.bypassCnt         = 0;
+    dataBufCacheStat.bypassFallbackCnt = 0;
+
+    for (bufEntry = 0; bufEntry < USER_DIES; bufEntry++)
+        dataBufPartition.dieUsage[bufEntry] = 0;
+    dataBufPartition.sharedUsage      = 0;
+    dataBufPartition.skippedVictimCnt = 0;
+    dataBufPartition.exhaustedCnt     = 0;
 }
 
 void FlushDataBuf(uint32_t cmdSlotTag)
@@ -134,6 +216,10 @@ void FlushDataBuf(uint32_t cmdSlotTag)
         // flush buffer entry
         if (bufEntry->dirty == DATA_BUF_DIRTY && bufEntry->dontCache == DATA_BUF_KEEP_CACHE)
         {
+            // complete the deferred read-modify-write before programming the slice
+            if (!BUF_SECTOR_IS_FULL(iBufEntry))
+                FillDataBufEntry(iBufEntry);
+
             if (bufEntry->phyReq)
             {
                 // FIXME: we should program a page once before that page being erased
@@ -149,20 +235,21 @@ void FlushDataBuf(uint32_t cmdSlotTag)
                 REQ_ENTRY(iReqEntry)->reqType                       = REQ_TYPE_NAND;
                 REQ_ENTRY(iReqEntry)->reqCode                       = REQ_CODE_WRITE;
                 REQ_ENTRY(iReqEntry)->nvmeCmdSlotTag                = cmdSlotTag;
-                REQ_ENTRY(iReqEntry)->logicalSliceAddr              = bufEntry->logicalSliceAddr;
+                REQ_LSA(iReqEntry)                                  = bufEntry->logicalSliceAddr;
                 REQ_ENTRY(iReqEntry)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_ENTRY;
                 REQ_ENTRY(iReqEntry)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_PHY_ORG;
                 REQ_ENTRY(iReqEntry)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
                 REQ_ENTRY(iReqEntry)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
                 REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
                 REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-                REQ_ENTRY(iReqEntry)->dataBufInfo.entry             = iBufEntry;
-                REQ_ENTRY(iReqEntry)->nandInfo.physicalCh           = iCh;
-                REQ_ENTRY(iReqEntry)->nandInfo.physicalWay          = iWay;
-                REQ_ENTRY(iReqEntry)->nandInfo.physicalBlock        = iPBlk;
-                REQ_ENTRY(iReqEntry)->nandInfo.physicalPage         = iPage;
+                REQ_DATA_BUF_INFO(iReqEntry).entry                  = iBufEntry;
+                REQ_NAND_INFO(iReqEntry).physicalCh                 = iCh;
+                REQ_NAND_INFO(iReqEntry).physicalWay                = iWay;
+                REQ_NAND_INFO(iReqEntry).physicalBlock              = iPBlk;
+                REQ_NAND_INFO(iReqEntry).physicalPage               = iPage;
 
                 pr_info("Req[%u]: Write C/W[%u/%u].PBlk[%u].Page[%u]", iReqEntry, iCh, iWay, iPBlk, iPage);
+                ChargeDataBufToDie(iBufEntry, iDie);
             }
             else
             {
@@ -172,15 +259,17 @@ void FlushDataBuf(uint32_t cmdSlotTag)
                 REQ_ENTRY(iReqEntry)->reqType                       = REQ_TYPE_NAND;
                 REQ_ENTRY(iReqEntry)->reqCode                       = REQ_CODE_WRITE;
                 REQ_ENTRY(iReqEntry)->nvmeCmdSlotTag                = cmdSlotTag;
-                REQ_ENTRY(iReqEntry)->logicalSliceAddr              = bufEntry->logicalSliceAddr;
+                REQ_LSA(iReqEntry)                                  = bufEntry->logicalSliceAddr;
                 REQ_ENTRY(iReqEntry)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_ENTRY;
                 REQ_ENTRY(iReqEntry)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_VSA;
                 REQ_ENTRY(iReqEntry)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
                 REQ_ENTRY(iReqEntry)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
                 REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
                 REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_MAIN;
-                REQ_ENTRY(iReqEntry)->dataBufInfo.entry             = iBufEntry;
-                REQ_ENTRY(iReqEntry)->nandInfo.virtualSliceAddr     = vsa;
+                REQ_DATA_BUF_INFO(iReqEntry).entry                  = iBufEntry;
+                REQ_NAND_INFO(iReqEntry).virtualSliceAddr           = vsa;
+
+                ChargeDataBufToDie(iBufEntry, VSA2VDIE(vsa));
             }
 
             UpdateDataBufEntryInfoBlockingReq(iBufEntry, iReqEntry);
@@ -191,6 +280,59 @@ void FlushDataBuf(uint32_t cmdSlotTag)
     }
 }
 
+/**
+ * @brief Move the given data buffer entry to the head of the LRU list.
+ *
+ * The entry is first removed from its current position of the LRU list, and then be
+ * inserted as the Most Recently Used entry.
+ *
+ * @param bufEntry The data buffer entry index to be moved, must be in the LRU list.
+ */
+static void MoveToDataBufLruHead(unsigned int bufEntry)
+{
+    // remove from the LRU list before making it MRU
+    if ((!BUF_ENTRY_IS_HEAD(bufEntry)) && (!BUF_ENTRY_IS_TAIL(bufEntry)))
+    {
+        // body of LRU list
+        BUF_PREV_ENTRY(bufEntry)->nextEntry = BUF_NEXT_IDX(bufEntry);
+        BUF_NEXT_ENTRY(bufEntry)->prevEntry = BUF_PREV_IDX(bufEntry);
+    }
+    else if ((!BUF_ENTRY_IS_HEAD(bufEntry)) && BUF_ENTRY_IS_TAIL(bufEntry))
+    {
+        // tail of LRU list, modify the LRU tail
+        BUF_PREV_ENTRY(bufEntry)->nextEntry = DATA_BUF_NONE;
+        dataBufLruList.tailEntry            = BUF_PREV_IDX(bufEntry);
+    }
+    else if (BUF_ENTRY_IS_HEAD(bufEntry) && (!BUF_ENTRY_IS_TAIL(bufEntry)))
+    {
+        // head of LRU list, modify the LRU head
+        BUF_NEXT_ENTRY(bufEntry)->prevEntry = DATA_BUF_NONE;
+        dataBufLruList.headEntry            = BUF_NEXT_IDX(bufEntry);
+    }
+    else
+    {
+        // the only entry in LRU list, make LRU list empty
+        dataBufLruList.tailEntry = DATA_BUF_NONE;
+        dataBufLruList.headEntry = DATA_BUF_NONE;
+    }
+
+    // make this entry the MRU entry (move to the head of LRU list)
+    if (BUF_HEAD_IDX() != DATA_BUF_NONE)
+    {
+        BUF_ENTRY(bufEntry)->prevEntry = DATA_BUF_NONE;
+        BUF_ENTRY(bufEntry)->nextEntry = BUF_HEAD_IDX();
+        BUF_HEAD_ENTRY()->prevEntry    = bufEntry;
+        dataBufLruList.headEntry       = bufEntry;
+    }
+    else
+    {
+        BUF_ENTRY(bufEntry)->prevEntry = DATA_BUF_NONE;
+        BUF_ENTRY(bufEntry)->nextEntry = DATA_BUF_NONE;
+        dataBufLruList.headEntry       = bufEntry;
+        dataBufLruList.tailEntry       = bufEntry;
+    }
+}
+
 /**
  * @brief Get the data buffer entry index of the given request.
  *
@@ -225,47 +367,8 @@ unsigned int CheckDataBufHit(unsigned int reqSlotTag)
         {
             pr_info("%s Req[%u]: Hit Buf[%u]!", isPhyReq ? "Phy" : "Log", reqSlotTag, bufEntry);
 
-            // remove from the LRU list before making it MRU
-            if ((!BUF_ENTRY_IS_HEAD(bufEntry)) && (!BUF_ENTRY_IS_TAIL(bufEntry)))
-            {
-                // body of LRU list
-                BUF_PREV_ENTRY(bufEntry)->nextEntry = BUF_NEXT_IDX(bufEntry);
-                BUF_NEXT_ENTRY(bufEntry)->prevEntry = BUF_PREV_IDX(bufEntry);
-            }
-            else if ((!BUF_ENTRY_IS_HEAD(bufEntry)) && BUF_ENTRY_IS_TAIL(bufEntry))
-            {
-                // tail of LRU list, modify the LRU tail
-                BUF_PREV_ENTRY(bufEntry)->nextEntry = DATA_BUF_NONE;
-                dataBufLruList.tailEntry            = BUF_PREV_IDX(bufEntry);
-            }
-            else if (BUF_ENTRY_IS_HEAD(bufEntry) && (!BUF_ENTRY_IS_TAIL(bufEntry)))
-            {
-                // head of LRU list, modify the LRU head
-                BUF_NEXT_ENTRY(bufEntry)->prevEntry = DATA_BUF_NONE;
-                dataBufLruList.headEntry            = BUF_NEXT_IDX(bufEntry);
-            }
-            else
-            {
-                // the only entry in LRU list, make LRU list empty
-                dataBufLruList.tailEntry = DATA_BUF_NONE;
-                dataBufLruList.headEntry = DATA_BUF_NONE;
-            }
-
             // make this entry the MRU entry (move to the head of LRU list)
-            if (BUF_HEAD_IDX() != DATA_BUF_NONE)
-            {
-                BUF_ENTRY(bufEntry)->prevEntry = DATA_BUF_NONE;
-                BUF_ENTRY(bufEntry)->nextEntry = BUF_HEAD_IDX();
-                BUF_HEAD_ENTRY()->prevEntry    = bufEntry;
-                dataBufLruList.headEntry       = bufEntry;
-            }
-            else
-            {
-                BUF_ENTRY(bufEntry)->prevEntry = DATA_BUF_NONE;
-                BUF_ENTRY(bufEntry)->nextEntry = DATA_BUF_NONE;
-                dataBufLruList.headEntry       = bufEntry;
-                dataBufLruList.tailEntry       = bufEntry;
-            }
+            MoveToDataBufLruHead(bufEntry);
 
             return bufEntry;
         }
@@ -277,6 +380,109 @@ unsigned int CheckDataBufHit(unsigned int reqSlotTag)
     return DATA_BUF_FAIL;
 }
 
+/**
+ * @brief Check whether the given die can be charged for one more data buffer entry.
+ *
+ * @param dieNo The target die number.
+ * @return unsigned int 1 if the die has not used up its quota or the shared region.
+ */
+unsigned int CheckDataBufDieQuota(unsigned int dieNo)
+{
+    return (dataBufPartition.dieUsage[dieNo] < DATA_BUF_DIE_QUOTA) ||
+           (dataBufPartition.sharedUsage < DATA_BUF_SHARED_ENTRY_COUNT);
+}
+
+/**
+ * @brief Charge the given data buffer entry to the die of its pending NAND request.
+ *
+ * The entry keeps being charged until its blocking request queue becomes empty (check
+ * `ReleaseBlockedByBufDepReq()`). If the die already used up its quota, the entry will
+ * be charged to the shared region.
+ *
+ * @note The transient entries have their own pool and will not be charged.
+ *
+ * @param bufEntry The data buffer entry index.
+ * @param dieNo The die number of the NAND request to be issued on the entry.
+ */
+void ChargeDataBufToDie(unsigned int bufEntry, unsigned int dieNo)
+{
+    if (BUF_ENTRY_IS_BYPASS(bufEntry) || (BUF_ENTRY(bufEntry)->chargedDie == dieNo))
+        return;
+
+    UnchargeDataBuf(bufEntry);
+
+    if (dataBufPartition.dieUsage[dieNo] >= DATA_BUF_DIE_QUOTA)
+        dataBufPartition.sharedUsage++;
+    dataBufPartition.dieUsage[dieNo]++;
+
+    BUF_ENTRY(bufEntry)->chargedDie = dieNo;
+}
+
+/**
+ * @brief Return the quota occupied by the given data buffer entry.
+ *
+ * @param bufEntry The data buffer entry index.
+ */
+void UnchargeDataBuf(unsigned int bufEntry)
+{
+    unsigned int dieNo = BUF_ENTRY(bufEntry)->chargedDie;
+
+    if (dieNo == DATA_BUF_DIE_NONE)
+        return;
+
+    dataBufPartition.dieUsage[dieNo]--;
+    if (dataBufPartition.dieUsage[dieNo] >= DATA_BUF_DIE_QUOTA)
+        dataBufPartition.sharedUsage--;
+
+    BUF_ENTRY(bufEntry)->chargedDie = DATA_BUF_DIE_NONE;
+}
+
+#if (DATA_BUF_PARTITION)
+/**
+ * @brief Select a victim entry that won't be blocked by an exhausted die.
+ *
+ * Starting from the LRU entry, at most `DATA_BUF_PARTITION_SCAN_DEPTH` entries will be
+ * checked, and an entry will be skipped if:
+ *
+ * - it is charged to an exhausted die, the new request would wait for that die, or
+ * - it is dirty and the next write die is exhausted, evicting it would program another
+ *   page to that die.
+ *
+ * If all the checked entries are skipped, just fall back to the LRU entry.
+ *
+ * @return unsigned int The data buffer entry index of the victim.
+ */
+static unsigned int SelectDataBufVictim()
+{
+    unsigned int bufEntry, depth, writeDieExhausted;
+
+    writeDieExhausted = !CheckDataBufDieQuota(sliceAllocationTargetDie);
+
+    for (bufEntry = BUF_TAIL_IDX(), depth = 0; (bufEntry != DATA_BUF_NONE) && (depth < DATA_BUF_PARTITION_SCAN_DEPTH);
+         bufEntry = BUF_PREV_IDX(bufEntry), depth++)
+    {
+        if ((BUF_ENTRY(bufEntry)->chargedDie != DATA_BUF_DIE_NONE) &&
+            !CheckDataBufDieQuota(BUF_ENTRY(bufEntry)->chargedDie))
+        {
+            dataBufPartition.skippedVictimCnt++;
+            continue;
+        }
+
+        if (writeDieExhausted && (BUF_ENTRY(bufEntry)->dirty == DATA_BUF_DIRTY) &&
+            (BUF_ENTRY(bufEntry)->dontCache == DATA_BUF_KEEP_CACHE))
+        {
+            dataBufPartition.skippedVictimCnt++;
+            continue;
+        }
+
+        return bufEntry;
+    }
+
+    dataBufPartition.exhaustedCnt++;
+    return BUF_TAIL_IDX();
+}
+#endif /* DATA_BUF_PARTITION */
+
 /**
  * @brief Retrieve a LRU data buffer entry from the LRU list.
  *
@@ -300,6 +506,9 @@ unsigned int CheckDataBufHit(unsigned int reqSlotTag)
  * After the evicted entry being moved from the tail of LRU entry to head, we have to call
  * the function `SelectiveGetFromDataBufHashList` to remove the `evictedEntry` from its
  * bucket of hash table.
+ *
+ * @note If `DATA_BUF_PARTITION` is enabled, the evicted entry may not be the tail of the
+ * LRU list, check `SelectDataBufVictim()` for details.
  */
 unsigned int AllocateDataBuf()
 {
@@ -308,6 +517,18 @@ unsigned int AllocateDataBuf()
     if (evictedEntry == DATA_BUF_NONE)
         assert(!"[WARNING] There is no valid buffer entry [WARNING]");
 
+#if (DATA_BUF_PARTITION)
+    // skip the entries that would make this request wait for an exhausted die
+    evictedEntry = SelectDataBufVictim();
+    if (evictedEntry != dataBufLruList.tailEntry)
+    {
+        MoveToDataBufLruHead(evictedEntry);
+        SelectiveGetFromDataBufHashList(evictedEntry);
+
+        return evictedEntry;
+    }
+#endif /* DATA_BUF_PARTITION */
+
     if (dataBufMapPtr->dataBuf[evictedEntry].prevEntry != DATA_BUF_NONE)
     {
         dataBufMapPtr->dataBuf[dataBufMapPtr->dataBuf[evictedEntry].prevEntry].nextEntry = DATA_BUF_NONE;
@@ -361,15 +582,108 @@ void UpdateDataBufEntryInfoBlockingReq(unsigned int bufEntry, unsigned int reqSl
     dataBufMapPtr->dataBuf[bufEntry].blockingReqTail = reqSlotTag;
 }
 
+/**
+ * @brief Decide whether the slice requests of the given NVMe command should bypass cache.
+ *
+ * Streaming transfers are rarely re-read, so caching them only evicts the working set of
+ * the other workloads. A command is treated as streaming if:
+ *
+ * - its size is not smaller than `DATA_BUF_BYPASS_MIN_NVME_BLOCKS`, or
+ * - it continues a sequential run (in the same direction) that has already reached the
+ *   size of `DATA_BUF_BYPASS_MIN_NVME_BLOCKS`, or
+ * - the host marked it as a sequential request in the dataset management field.
+ *
+ * @note Only the logical read/write commands can bypass the cache.
+ *
+ * @param cmdCode The opcode of the NVMe command.
+ * @param startLba The first NVMe block of the NVMe command.
+ * @param nlb The number of NVMe blocks of the NVMe command, 0's based.
+ * @param seqHint The `SequentialRequest` bit of the dataset management field.
+ * @return unsigned int `REQ_OPT_DATA_BUF_BYPASS_ON` if the command should bypass cache.
+ */
+unsigned int CheckDataBufBypass(unsigned int cmdCode, unsigned int startLba, unsigned int nlb, unsigned int seqHint)
+{
+    P_DATA_BUF_BYPASS_STREAM stream;
+
+    if ((DATA_BUF_BYPASS_ENTRY_COUNT == 0) || ((cmdCode != IO_NVM_READ) && (cmdCode != IO_NVM_WRITE)))
+        return REQ_OPT_DATA_BUF_BYPASS_OFF;
+
+    // update the sequential run of this direction
+    stream = &dataBufBypassStream[cmdCode == IO_NVM_WRITE];
+    if (startLba == stream->nextLba)
+        stream->runNvmeBlocks += nlb + 1;
+    else
+        stream->runNvmeBlocks = nlb + 1;
+    stream->nextLba = startLba + nlb + 1;
+
+    if ((stream->runNvmeBlocks >= DATA_BUF_BYPASS_MIN_NVME_BLOCKS) || seqHint)
+        return REQ_OPT_DATA_BUF_BYPASS_ON;
+
+    return REQ_OPT_DATA_BUF_BYPASS_OFF;
+}
+
+/**
+ * @brief Get a free transient buffer entry for a cache-bypassing slice request.
+ *
+ * @return unsigned int The transient buffer entry index, or `DATA_BUF_FAIL` if the pool is
+ * exhausted (the caller should fall back to the cached entries).
+ */
+unsigned int AllocateBypassDataBuf()
+{
+    unsigned int bufEntry = dataBufBypassList.headEntry;
+
+    if (bufEntry == DATA_BUF_NONE)
+        return DATA_BUF_FAIL;
+
+    dataBufBypassList.headEntry = BUF_NEXT_IDX(bufEntry);
+    dataBufBypassList.freeCnt--;
+
+    BUF_ENTRY(bufEntry)->nextEntry = DATA_BUF_NONE;
+
+    return bufEntry;
+}
+
+/**
+ * @brief Return the transient buffer entry to the free list.
+ *
+ * @note This function is called when the last request in the blocking request queue of
+ * the transient buffer entry is done (check `ReleaseBlockedByBufDepReq()`).
+ *
+ * @param bufEntry The transient buffer entry index to be released.
+ */
+void ReleaseBypassDataBuf(unsigned int bufEntry)
+{
+    ASSERT(BUF_ENTRY_IS_BYPASS(bufEntry), "Buf[%u] is not a transient buffer entry", bufEntry);
+
+    BUF_ENTRY(bufEntry)->logicalSliceAddr = LSA_NONE;
+    BUF_ENTRY(bufEntry)->nextEntry        = dataBufBypassList.headEntry;
+    dataBufBypassList.headEntry           = bufEntry;
+    dataBufBypassList.freeCnt++;
+}
+
 /**
  * @brief Retrieve the index of temp buffer entry of the target die.
  *
- * By default, there is only `NUM_DIES` entries in the `tempDataBuf`, so we can just use
- * the serial number of each die to determine which temp entry should be used.
+ * Each die owns `TEMP_BUF_ENTRIES_PER_DIE` temp entries, which are handed out in turn so
+ * that the requests on a die don't have to wait for the same temp entry. By default,
+ * there is only one entry for each die, so the serial number of the die is returned.
+ *
+ * @note A reused temp entry is still protected by its blocking request queue, so the
+ * caller should append its requests to the queue (`UpdateTempDataBufEntryInfoBlockingReq`).
  *
  * @param dieNo an unique number of the specified die
  */
-unsigned int AllocateTempDataBuf(unsigned int dieNo) { return dieNo; }
+unsigned int AllocateTempDataBuf(unsigned int dieNo)
+{
+    unsigned int tempBufEntry;
+
+    tempBufEntry = dieNo * TEMP_BUF_ENTRIES_PER_DIE + tempDataBufCursor[dieNo];
+
+    if (++tempDataBufCursor[dieNo] == TEMP_BUF_ENTRIES_PER_DIE)
+        tempDataBufCursor[dieNo] = 0;
+
+    return tempBufEntry;
+}
 
 /**
  * @brief Append the request to the blocking queue specified by given temp buffer entry.
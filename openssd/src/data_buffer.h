@@ -50,9 +50,30 @@
 #include "ftl_config.h"
 #include "memory_map.h"
 
-// the data buffer entries for each die, default 16
-#define AVAILABLE_DATA_BUFFER_ENTRY_COUNT           (16 * USER_DIES)
-#define AVAILABLE_TEMPORARY_DATA_BUFFER_ENTRY_COUNT (USER_DIES)
+/**
+ * @brief The sizing of the data buffers, can be overridden at build time (e.g. `-D`).
+ *
+ * The DRAM regions of the buffers and their maps are derived from these values in
+ * `memory_map.h`, and the resulting layout is validated by `CheckDataBufLayout()` during
+ * `InitDataBuf()`. The buffers live in the uncached region below `DATA_BUFFER_LIMIT_ADDR`,
+ * while their maps grow the FTL metadata in the cached region.
+ *
+ * - `DATA_BUF_ENTRIES_PER_DIE`: number of data buffer entries for each die, default 16.
+ * - `DATA_BUF_HASH_BUCKET_COUNT`: number of hash buckets, default one per entry.
+ * - `TEMP_BUF_ENTRIES_PER_DIE`: number of temp buffer entries for each die, default 1.
+ */
+#ifndef DATA_BUF_ENTRIES_PER_DIE
+#define DATA_BUF_ENTRIES_PER_DIE 16
+#endif
+#ifndef DATA_BUF_HASH_BUCKET_COUNT
+#define DATA_BUF_HASH_BUCKET_COUNT AVAILABLE_DATA_BUFFER_ENTRY_COUNT
+#endif
+#ifndef TEMP_BUF_ENTRIES_PER_DIE
+#define TEMP_BUF_ENTRIES_PER_DIE 1
+#endif
+
+#define AVAILABLE_DATA_BUFFER_ENTRY_COUNT           (DATA_BUF_ENTRIES_PER_DIE * USER_DIES)
+#define AVAILABLE_TEMPORARY_DATA_BUFFER_ENTRY_COUNT (TEMP_BUF_ENTRIES_PER_DIE * USER_DIES)
 
 #define DATA_BUF_NONE  0xffff
 #define DATA_BUF_FAIL  0xffff
@@ -65,7 +86,42 @@
 #define DATA_BUF_SKIP_CACHE 1 // this buffer entry should not be cached in hash list
 #define DATA_BUF_KEEP_CACHE 0 // this buffer entry should be cached in hash list (default)
 
-#define FindDataBufHashTableEntry(logicalSliceAddr) ((logicalSliceAddr) % AVAILABLE_DATA_BUFFER_ENTRY_COUNT)
+/**
+ * @brief The transient buffer entries reserved for cache-bypassing streaming I/O.
+ *
+ * The last `DATA_BUF_BYPASS_ENTRY_COUNT` entries of `dataBuf` are never linked into the LRU
+ * list or the hash table. Instead, they are kept in `dataBufBypassList` and returned to it
+ * as soon as the last request using them is done. Set the count to 0 to disable bypass.
+ */
+#define DATA_BUF_BYPASS_ENTRY_COUNT     (2 * USER_DIES)
+#define DATA_BUF_BYPASS_BASE_ENTRY      (AVAILABLE_DATA_BUFFER_ENTRY_COUNT - DATA_BUF_BYPASS_ENTRY_COUNT)
+#define DATA_BUF_BYPASS_MIN_NVME_BLOCKS 256 // commands (or sequential runs) not smaller than 1MB bypass the cache
+
+/**
+ * @brief Partition the cached entries into per-die quotas and a shared overflow region.
+ *
+ * Every cached entry that has a pending NAND request is charged to the die of that
+ * request until its blocking request queue becomes empty. Once a die uses up its quota
+ * (`DATA_BUF_DIE_QUOTA`) and the shared region (`DATA_BUF_SHARED_ENTRY_COUNT`), the entries
+ * charged to that die and the dirty entries that would be programmed to that die are no
+ * longer chosen as victims, so a slow die cannot make the requests to other dies wait
+ * for it (check `SelectDataBufVictim()`). Set `DATA_BUF_PARTITION` to 1 to enable it.
+ */
+#define DATA_BUF_PARTITION            0
+#define DATA_BUF_SHARED_ENTRY_COUNT   (DATA_BUF_BYPASS_BASE_ENTRY / 4)
+#define DATA_BUF_DIE_QUOTA            ((DATA_BUF_BYPASS_BASE_ENTRY - DATA_BUF_SHARED_ENTRY_COUNT) / USER_DIES)
+#define DATA_BUF_PARTITION_SCAN_DEPTH 32 // max number of LRU entries to be checked for a victim
+#define DATA_BUF_DIE_NONE             0xff
+
+// defer the NAND read of a partially written slice until the buffer must be programmed
+#define DATA_BUF_DEFER_RMW 1
+
+// the bitmap of NVMe blocks (sectors) held by a data buffer entry
+#define DATA_BUF_SECTOR_FULL ((1 << NVME_BLOCKS_PER_SLICE) - 1)
+#define DATA_BUF_SECTOR_MASK(nvmeBlockOffset, numOfNvmeBlock)                                                     \
+    ((((1 << (numOfNvmeBlock)) - 1) << (nvmeBlockOffset)) & DATA_BUF_SECTOR_FULL)
+
+#define FindDataBufHashTableEntry(logicalSliceAddr) ((logicalSliceAddr) % DATA_BUF_HASH_BUCKET_COUNT)
 
 /**
  * @brief The structure of the data buffer entry.
@@ -104,6 +160,11 @@
  * correct order (check `UpdateDataBufEntryInfoBlockingReq()` for details).
  *
  * @sa `UpdateDataBufEntryInfoBlockingReq()`.
+ *
+ * To avoid reading the old page for every partial slice write, each entry also records
+ * which NVMe blocks of the slice hold valid data (`sectorValid`). A partially written
+ * entry is completed with the NAND content only when it must be programmed or when a
+ * read hits a missing NVMe block (check `FillDataBufEntry()` for details).
  */
 typedef struct _DATA_BUF_ENTRY
 {
@@ -116,7 +177,9 @@ typedef struct _DATA_BUF_ENTRY
     unsigned int dirty : 1;            // whether this data buffer entry is dirty or not (clean)
     unsigned int phyReq : 1;           // treat LSA as physical address
     unsigned int dontCache : 1;        // do not cache (insert into hash list) this buffer
-    unsigned int reserved0 : 13;
+    unsigned int sectorValid : 4;      // bitmap of the NVMe blocks that hold valid data
+    unsigned int chargedDie : 8;       // the die of the pending NAND request, check `DATA_BUF_PARTITION`
+    unsigned int reserved0 : 1;
 } DATA_BUF_ENTRY, *P_DATA_BUF_ENTRY;
 
 /**
@@ -166,9 +229,73 @@ typedef struct _DATA_BUF_HASH_ENTRY
  */
 typedef struct _DATA_BUF_HASH_TABLE
 {
-    DATA_BUF_HASH_ENTRY dataBufHash[AVAILABLE_DATA_BUFFER_ENTRY_COUNT];
+    DATA_BUF_HASH_ENTRY dataBufHash[DATA_BUF_HASH_BUCKET_COUNT];
 } DATA_BUF_HASH_TABLE, *P_DATA_BUF_HASH_TABLE;
 
+/**
+ * @brief The statistics of the read-modify-write fills of partially written slices.
+ *
+ * - deferredCnt: partial slice writes that skipped the NAND read on buffer miss
+ * - avoidedCnt: deferred fills that turned out unnecessary (slice fully written or unmapped)
+ * - performedCnt: NAND reads actually issued to complete a partially written slice
+ */
+typedef struct _DATA_BUF_FILL_STAT
+{
+    uint32_t deferredCnt;
+    uint32_t avoidedCnt;
+    uint32_t performedCnt;
+} DATA_BUF_FILL_STAT, *P_DATA_BUF_FILL_STAT;
+
+/**
+ * @brief The list of free transient buffer entries, linked by `DATA_BUF_ENTRY::nextEntry`.
+ */
+typedef struct _DATA_BUF_BYPASS_LIST
+{
+    unsigned int headEntry : 16; // the first free transient buffer entry
+    unsigned int freeCnt : 16;   // the number of free transient buffer entries
+} DATA_BUF_BYPASS_LIST, *P_DATA_BUF_BYPASS_LIST;
+
+/**
+ * @brief The sequential stream detector used to decide whether to bypass the cache.
+ *
+ * One detector for reads and one for writes, check `CheckDataBufBypass()` for details.
+ */
+typedef struct _DATA_BUF_BYPASS_STREAM
+{
+    unsigned int nextLba;       // the NVMe block expected by a sequential command
+    unsigned int runNvmeBlocks; // the number of NVMe blocks accessed sequentially so far
+} DATA_BUF_BYPASS_STREAM, *P_DATA_BUF_BYPASS_STREAM;
+
+/**
+ * @brief The statistics of the data buffer cache, used to evaluate the bypass policy.
+ *
+ * - hitCnt / missCnt: slice requests served by cached entries
+ * - bypassCnt: slice requests served by transient entries
+ * - bypassFallbackCnt: bypassing slice requests served by cached entries due to no free
+ *   transient entry
+ */
+typedef struct _DATA_BUF_CACHE_STAT
+{
+    uint32_t hitCnt;
+    uint32_t missCnt;
+    uint32_t bypassCnt;
+    uint32_t bypassFallbackCnt;
+} DATA_BUF_CACHE_STAT, *P_DATA_BUF_CACHE_STAT;
+
+/**
+ * @brief The usage of the per-die quotas and the shared overflow region.
+ *
+ * @sa `DATA_BUF_PARTITION`, `ChargeDataBufToDie()`, `UnchargeDataBuf()`.
+ */
+typedef struct _DATA_BUF_PARTITION_INFO
+{
+    uint16_t dieUsage[USER_DIES]; // the number of entries charged to each die
+    uint16_t sharedUsage;         // the number of entries exceeding the die quotas
+    uint16_t reserved0;
+    uint32_t skippedVictimCnt; // the number of LRU entries skipped due to exhausted die
+    uint32_t exhaustedCnt;     // the number of victim selections that found no candidate
+} DATA_BUF_PARTITION_INFO, *P_DATA_BUF_PARTITION_INFO;
+
 typedef struct _TEMPORARY_DATA_BUF_ENTRY
 {
     unsigned int blockingReqTail : 16;
@@ -178,9 +305,9 @@ typedef struct _TEMPORARY_DATA_BUF_ENTRY
 /**
  * @brief The structure of the temp data buffer table.
  *
- * A fixed-sized 1D temp data buffer array. The number of buffer entries is exactly the
- * number of dies, therefore just choose the target entry by using the dieNo when
- * allocating a temp buffer entry. (check the implementation of `AllocateTempDataBuf`).
+ * A fixed-sized 1D temp data buffer array. Each die owns `TEMP_BUF_ENTRIES_PER_DIE`
+ * consecutive entries starting from `dieNo * TEMP_BUF_ENTRIES_PER_DIE`, and the entries of
+ * a die are used in turn (check the implementation of `AllocateTempDataBuf`).
  */
 typedef struct _TEMPORARY_DATA_BUF_MAP
 {
@@ -193,6 +320,14 @@ unsigned int CheckDataBufHit(unsigned int reqSlotTag);
 unsigned int AllocateDataBuf();
 void UpdateDataBufEntryInfoBlockingReq(unsigned int bufEntry, unsigned int reqSlotTag);
 
+unsigned int CheckDataBufDieQuota(unsigned int dieNo);
+void ChargeDataBufToDie(unsigned int bufEntry, unsigned int dieNo);
+void UnchargeDataBuf(unsigned int bufEntry);
+
+unsigned int CheckDataBufBypass(unsigned int cmdCode, unsigned int startLba, unsigned int nlb, unsigned int seqHint);
+unsigned int AllocateBypassDataBuf();
+void ReleaseBypassDataBuf(unsigned int bufEntry);
+
 unsigned int AllocateTempDataBuf(unsigned int dieNo);
 void UpdateTempDataBufEntryInfoBlockingReq(unsigned int bufEntry, unsigned int reqSlotTag);
 
@@ -203,6 +338,10 @@ extern P_DATA_BUF_MAP dataBufMapPtr;
 extern DATA_BUF_LRU_LIST dataBufLruList;
 extern P_DATA_BUF_HASH_TABLE dataBufHashTable;
 extern P_TEMPORARY_DATA_BUF_MAP tempDataBufMapPtr;
+extern DATA_BUF_FILL_STAT dataBufFillStat;
+extern DATA_BUF_BYPASS_LIST dataBufBypassList;
+extern DATA_BUF_CACHE_STAT dataBufCacheStat;
+extern DATA_BUF_PARTITION_INFO dataBufPartition;
 
 /* -------------------------------------------------------------------------- */
 /*                   util macros for data buffer related ops                  */
@@ -227,7 +366,16 @@ extern P_TEMPORARY_DATA_BUF_MAP tempDataBufMapPtr;
 
 #define BUF_LSA(iEntry) (BUF_ENTRY((iEntry))->logicalSliceAddr)
 
+#define BUF_ENTRY_IS_BYPASS(iEntry) ((iEntry) >= DATA_BUF_BYPASS_BASE_ENTRY)
+#define BUF_SECTOR_IS_FULL(iEntry)  (BUF_ENTRY((iEntry))->sectorValid == DATA_BUF_SECTOR_FULL)
+
 #define BUF_DATA_ENTRY2ADDR(iEntry)  (DATA_BUFFER_BASE_ADDR + ((iEntry)*BYTES_PER_DATA_REGION_OF_SLICE))
 #define BUF_SPARE_ENTRY2ADDR(iEntry) (SPARE_DATA_BUFFER_BASE_ADDR + ((iEntry)*BYTES_PER_SPARE_REGION_OF_SLICE))
 
+#define TEMP_BUF_ENTRY(iEntry) (&tempDataBufMapPtr->tempDataBuf[(iEntry)])
+#define TEMP_BUF_DATA_ENTRY2ADDR(iEntry)                                                                          \
+    (TEMPORARY_DATA_BUFFER_BASE_ADDR + ((iEntry)*BYTES_PER_DATA_REGION_OF_SLICE))
+#define TEMP_BUF_SPARE_ENTRY2ADDR(iEntry)                                                                         \
+    (TEMPORARY_SPARE_DATA_BUFFER_BASE_ADDR + ((iEntry)*BYTES_PER_SPARE_REGION_OF_SLICE))
+
 #endif /* DATA_BUFFER_H_ */
@@ -63,14 +63,16 @@ void InitFTL()
 {
     CheckConfigRestriction();
 
-    InitChCtlReg();        // assigned the predefined addresses of channel controllers
-    InitReqPool();         //
-    InitDependencyTable(); //
-    InitReqScheduler();    //
-    InitNandArray();       // "[ NAND device reset complete. ]"
-    InitAddressMap();      // "Press 'X' to re-make the bad block table."
-    InitDataBuf();         //
-    InitGcVictimMap();     //
+    InitChCtlReg();         // assigned the predefined addresses of channel controllers
+    InitReqPool();          //
+    InitDependencyTable();  //
+    InitReqScheduler();     //
+    InitNandArray();        // "[ NAND device reset complete. ]"
+    InitReadDisturbTable(); // before any block is erased by `InitAddressMap()`
+    InitGrownBadRing();     // before any erase of `InitAddressMap()` may fail
+    InitAddressMap();       // "Press 'X' to re-make the bad block table."
+    InitDataBuf();          //
+    InitGcVictimMap();      //
 
     monitorInit();
 
@@ -189,10 +191,10 @@ void InitNandArray()
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_NONE;
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh           = chNo;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay          = wayNo;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock        = 0; // dummy
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage         = 0; // dummy
+            REQ_NAND_INFO(reqSlotTag).physicalCh                          = chNo;
+            REQ_NAND_INFO(reqSlotTag).physicalWay                         = wayNo;
+            REQ_NAND_INFO(reqSlotTag).physicalBlock                       = 0; // dummy
+            REQ_NAND_INFO(reqSlotTag).physicalPage                        = 0; // dummy
             reqPoolPtr->reqPool[reqSlotTag].prevBlockingReq               = REQ_SLOT_TAG_NONE;
             SelectLowLevelReqQ(reqSlotTag);
 
@@ -203,10 +205,10 @@ void InitNandArray()
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_NONE;
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
             reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh           = chNo;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay          = wayNo;
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock        = 0; // dummy
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage         = 0; // dummy
+            REQ_NAND_INFO(reqSlotTag).physicalCh                          = chNo;
+            REQ_NAND_INFO(reqSlotTag).physicalWay                         = wayNo;
+            REQ_NAND_INFO(reqSlotTag).physicalBlock                       = 0; // dummy
+            REQ_NAND_INFO(reqSlotTag).physicalPage                        = 0; // dummy
             reqPoolPtr->reqPool[reqSlotTag].prevBlockingReq               = REQ_SLOT_TAG_NONE;
             SelectLowLevelReqQ(reqSlotTag);
         }
@@ -158,6 +158,7 @@
 #define MAIN_ROWS_PER_MLC_LUN (ROWS_PER_MLC_BLOCK * MAIN_BLOCKS_PER_LUN)
 
 #define LUNS_PER_DIE 1 /* number of planes in a die (way) */
+#define PLANES_PER_LUN 2 /* number of planes in a LUN, selected by the LSB of the block address */
 
 #define MAIN_BLOCKS_PER_DIE  (MAIN_BLOCKS_PER_LUN * LUNS_PER_DIE)
 #define TOTAL_BLOCKS_PER_DIE (TOTAL_BLOCKS_PER_LUN * LUNS_PER_DIE)
@@ -248,5 +249,6 @@ void CheckConfigRestriction();
 
 extern unsigned int storageCapacity_L;
 extern T4REGS chCtlReg[USER_CHANNELS];
+extern unsigned int NSCS[];
 
 #endif /* FTL_CONFIG_H_ */
@@ -47,9 +47,19 @@
 
 #include "xil_printf.h"
 #include <assert.h>
+#include <string.h>
+#include "xtime_l.h"
 #include "memory_map.h"
+#include "debug.h"
 
 P_GC_VICTIM_MAP gcVictimMapPtr;
+GC_REFRESH_STAT gcRefreshStat;
+
+P_READ_DISTURB_TABLE readDisturbTablePtr;
+P_IPC_RING readDisturbRingPtr;
+READ_DISTURB_STAT readDisturbStat;
+
+P_IPC_RING grownBadRingPtr;
 
 void InitGcVictimMap()
 {
@@ -67,11 +77,20 @@ void InitGcVictimMap()
     }
 }
 
-void GarbageCollection(unsigned int dieNo)
+/**
+ * @brief Copy the valid slices of the given block to the current block of its die.
+ *
+ * @warning The block must have been removed from the GC victim list.
+ *
+ * @param dieNo the die number of the block.
+ * @param victimBlockNo the virtual block number of the block.
+ * @return unsigned int the number of valid slices copied.
+ */
+static unsigned int CopyValidSlices(unsigned int dieNo, unsigned int victimBlockNo)
 {
-    unsigned int victimBlockNo, pageNo, virtualSliceAddr, logicalSliceAddr, dieNoForGcCopy, reqSlotTag;
+    unsigned int pageNo, virtualSliceAddr, logicalSliceAddr, dieNoForGcCopy, reqSlotTag, tempBufEntry;
+    unsigned int copiedSliceCnt = 0;
 
-    victimBlockNo  = GetFromGcVictimList(dieNo);
     dieNoForGcCopy = dieNo;
 
     if (virtualBlockMapPtr->block[dieNo][victimBlockNo].invalidSliceCnt != SLICES_PER_BLOCK)
@@ -85,12 +104,15 @@ void GarbageCollection(unsigned int dieNo)
                 if (logicalSliceMapPtr->logicalSlice[logicalSliceAddr].virtualSliceAddr ==
                     virtualSliceAddr) // valid data
                 {
+                    // the copied data is read into and programmed from the same temp entry
+                    tempBufEntry = AllocateTempDataBuf(dieNo);
+
                     // read
                     reqSlotTag = GetFromFreeReqQ();
 
                     reqPoolPtr->reqPool[reqSlotTag].reqType               = REQ_TYPE_NAND;
                     reqPoolPtr->reqPool[reqSlotTag].reqCode               = REQ_CODE_READ;
-                    reqPoolPtr->reqPool[reqSlotTag].logicalSliceAddr      = logicalSliceAddr;
+                    REQ_LSA(reqSlotTag)                                   = logicalSliceAddr;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat  = REQ_OPT_DATA_BUF_TEMP_ENTRY;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr       = REQ_OPT_NAND_ADDR_VSA;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandEcc        = REQ_OPT_NAND_ECC_ON;
@@ -98,10 +120,9 @@ void GarbageCollection(unsigned int dieNo)
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck =
                         REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace = REQ_OPT_BLOCK_SPACE_MAIN;
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry = AllocateTempDataBuf(dieNo);
-                    UpdateTempDataBufEntryInfoBlockingReq(reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry,
-                                                          reqSlotTag);
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr = virtualSliceAddr;
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry               = tempBufEntry;
+                    UpdateTempDataBufEntryInfoBlockingReq(REQ_DATA_BUF_INFO(reqSlotTag).entry, reqSlotTag);
+                    REQ_NAND_INFO(reqSlotTag).virtualSliceAddr = virtualSliceAddr;
 
                     SelectLowLevelReqQ(reqSlotTag);
 
@@ -110,7 +131,7 @@ void GarbageCollection(unsigned int dieNo)
 
                     reqPoolPtr->reqPool[reqSlotTag].reqType               = REQ_TYPE_NAND;
                     reqPoolPtr->reqPool[reqSlotTag].reqCode               = REQ_CODE_WRITE;
-                    reqPoolPtr->reqPool[reqSlotTag].logicalSliceAddr      = logicalSliceAddr;
+                    REQ_LSA(reqSlotTag)                                   = logicalSliceAddr;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat  = REQ_OPT_DATA_BUF_TEMP_ENTRY;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr       = REQ_OPT_NAND_ADDR_VSA;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandEcc        = REQ_OPT_NAND_ECC_ON;
@@ -118,23 +139,318 @@ void GarbageCollection(unsigned int dieNo)
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck =
                         REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
                     reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace = REQ_OPT_BLOCK_SPACE_MAIN;
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry = AllocateTempDataBuf(dieNo);
-                    UpdateTempDataBufEntryInfoBlockingReq(reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry,
-                                                          reqSlotTag);
-                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr =
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry               = tempBufEntry;
+                    UpdateTempDataBufEntryInfoBlockingReq(REQ_DATA_BUF_INFO(reqSlotTag).entry, reqSlotTag);
+                    REQ_NAND_INFO(reqSlotTag).virtualSliceAddr =
                         FindFreeVirtualSliceForGc(dieNoForGcCopy, victimBlockNo);
 
                     logicalSliceMapPtr->logicalSlice[logicalSliceAddr].virtualSliceAddr =
-                        reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr;
-                    virtualSliceMapPtr->virtualSlice[reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr]
+                        REQ_NAND_INFO(reqSlotTag).virtualSliceAddr;
+                    virtualSliceMapPtr->virtualSlice[REQ_NAND_INFO(reqSlotTag).virtualSliceAddr]
                         .logicalSliceAddr = logicalSliceAddr;
 
                     SelectLowLevelReqQ(reqSlotTag);
+                    copiedSliceCnt++;
                 }
         }
     }
 
+    return copiedSliceCnt;
+}
+
+/**
+ * @brief Copy the valid slices of the given block to the current block of its die, and
+ * erase it.
+ *
+ * @warning The block must have been removed from the GC victim list.
+ *
+ * @param dieNo the die number of the block.
+ * @param victimBlockNo the virtual block number of the block.
+ * @return unsigned int the number of valid slices copied.
+ */
+static unsigned int ReclaimBlock(unsigned int dieNo, unsigned int victimBlockNo)
+{
+    unsigned int copiedSliceCnt;
+
+    copiedSliceCnt = CopyValidSlices(dieNo, victimBlockNo);
     EraseBlock(dieNo, victimBlockNo);
+
+    return copiedSliceCnt;
+}
+
+void GarbageCollection(unsigned int dieNo)
+{
+    ReclaimBlock(dieNo, GetFromGcVictimList(dieNo));
+}
+
+#if (NAND_ECC_REFRESH || READ_DISTURB_REFRESH || GROWN_BAD_BLOCK_SALVAGE)
+/**
+ * @brief The queued refreshes of open blocks, which are served once the blocks are closed.
+ *
+ * Only the current and the paired block of a die can be open, and each of them can be
+ * queued by both the scheduler and the read disturb counters.
+ */
+#define GC_REFRESH_PARKED_MAX (USER_DIES * 4)
+
+static NAND_REFRESH_MSG refreshParkedMsg[GC_REFRESH_PARKED_MAX];
+static unsigned int refreshParkedCnt;
+
+/**
+ * @brief Check if the given block is still being programmed by its die.
+ *
+ * @param dieNo the die number of the block.
+ * @param blockNo the virtual block number of the block.
+ * @return unsigned int 1 if the block is the current (or paired) block of the die.
+ */
+static unsigned int IsOpenBlock(unsigned int dieNo, unsigned int blockNo)
+{
+    if (blockNo == virtualDieMapPtr->die[dieNo].currentBlock)
+        return 1;
+#if (PLANE_PAIRED_BLOCKS)
+    if (blockNo == virtualDieMapPtr->die[dieNo].pairedBlock)
+        return 1;
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Take a parked refresh whose block has been closed since it was parked.
+ *
+ * @param msg returns the refresh to be served.
+ * @return unsigned int 1 if a refresh is taken, otherwise 0.
+ */
+static unsigned int GetClosedParkedRefresh(P_NAND_REFRESH_MSG msg)
+{
+    unsigned int iMsg;
+
+    for (iMsg = 0; iMsg < refreshParkedCnt; iMsg++)
+        if (!IsOpenBlock(refreshParkedMsg[iMsg].dieNo, refreshParkedMsg[iMsg].blockNo))
+        {
+            *msg                   = refreshParkedMsg[iMsg];
+            refreshParkedMsg[iMsg] = refreshParkedMsg[--refreshParkedCnt];
+            return 1;
+        }
+
+    return 0;
+}
+
+/**
+ * @brief Relocate one of the blocks queued for refresh.
+ *
+ * The grown bad blocks are evacuated first since their data is at risk, then the blocks
+ * queued by the scheduler for their low ECC margin are served before the ones queued for
+ * read disturb. A grown bad block is only evacuated and never erased. While any NAND
+ * request is in flight, at most one block is relocated every `NAND_ECC_REFRESH_INTERVAL_MS`
+ * to bound the interference to the host requests. The refresh of a die waits until the
+ * die has a free block besides the reserved ones, so that it never takes the last blocks
+ * of the GC. The evacuation of a grown bad block also waits for the programs already
+ * issued to the block, check `UpdateInFlightProgramCnt()`. A program that fails after its
+ * slice has been copied is not retargeted by `RetargetFailedProgram()`, since the slice is
+ * already mapped to the copy, and the copy would then hold the data of the failed page.
+ *
+ * @note The queued block may have been collected, and even reused, since it was queued,
+ * in which case the refresh is skipped or just relocates some fresh data. A block that
+ * is still open is parked and refreshed after it is closed, since its refresh flag stays
+ * set and it would never be queued again.
+ */
+void RefreshQueuedBlock()
+{
+    static NAND_REFRESH_MSG pendingMsg;
+    static unsigned int pending;
+    static XTime lastRefreshTick;
+    P_VIRTUAL_BLOCK_ENTRY blockEntry;
+    unsigned int dieNo, blockNo;
+    XTime now;
+
+    XTime_GetTime(&now);
+    if (notCompletedNandReqCnt &&
+        now - lastRefreshTick < (XTime)NAND_ECC_REFRESH_INTERVAL_MS * COUNTS_PER_SECOND / 1000)
+        return;
+
+    if (!pending)
+    {
+#if (GROWN_BAD_BLOCK_SALVAGE)
+        pending = PopIpcRing(grownBadRingPtr, &pendingMsg.dword);
+#endif
+        if (!pending && refreshParkedCnt)
+            pending = GetClosedParkedRefresh(&pendingMsg);
+#if (NAND_ECC_REFRESH)
+        if (!pending)
+            pending = PopIpcRing(nandRefreshRingPtr, &pendingMsg.dword);
+#endif
+#if (READ_DISTURB_REFRESH)
+        if (!pending)
+            pending = PopIpcRing(readDisturbRingPtr, &pendingMsg.dword);
+#endif
+        if (!pending)
+            return;
+    }
+    lastRefreshTick = now;
+
+    dieNo      = pendingMsg.dieNo;
+    blockNo    = pendingMsg.blockNo;
+    blockEntry = &virtualBlockMapPtr->block[dieNo][blockNo];
+
+    // the grown bad block is already out of the lists and closed by `MarkGrownBadVirtualBlock()`
+    if (pendingMsg.reason != NAND_REFRESH_REASON_GROWN_BAD && !blockEntry->bad && !blockEntry->free &&
+        IsOpenBlock(dieNo, blockNo) && refreshParkedCnt < GC_REFRESH_PARKED_MAX)
+    {
+        refreshParkedMsg[refreshParkedCnt++] = pendingMsg;
+        pending                              = 0;
+        gcRefreshStat.parkedCnt++;
+        return;
+    }
+
+    /*
+     * The refresh flags of a free block were cleared by its erase, and a bad block is never
+     * refreshed again. The parked refreshes can't run out either, since each open block is
+     * parked at most once for the scheduler and once for the read disturb counters.
+     */
+    if (pendingMsg.reason != NAND_REFRESH_REASON_GROWN_BAD &&
+        (blockEntry->bad || blockEntry->free || IsOpenBlock(dieNo, blockNo)))
+    {
+        pending = 0;
+        gcRefreshStat.skippedCnt++;
+#if (READ_DISTURB_REFRESH)
+        // let the block be queued again by the following reads
+        if (pendingMsg.reason == NAND_REFRESH_REASON_READ_DISTURB)
+            readDisturbTablePtr->block[dieNo][blockNo].refreshQueued = 0;
+#endif
+        return;
+    }
+
+    if (virtualDieMapPtr->die[dieNo].freeBlockCnt <= RESERVED_FREE_BLOCK_COUNT)
+    {
+        gcRefreshStat.deferredCnt++;
+        return;
+    }
+
+#if (GROWN_BAD_BLOCK_SALVAGE)
+    // the programs issued before the block went bad may still fail and be retargeted
+    if (pendingMsg.reason == NAND_REFRESH_REASON_GROWN_BAD && blockEntry->inFlightProgCnt)
+    {
+        gcRefreshStat.deferredCnt++;
+        return;
+    }
+#endif
+
+    if (pendingMsg.reason == NAND_REFRESH_REASON_GROWN_BAD)
+        gcRefreshStat.copiedSliceCnt += CopyValidSlices(dieNo, blockNo);
+    else
+    {
+        // only the blocks with invalid slices are linked in the victim lists
+        if (blockEntry->invalidSliceCnt)
+            SelectiveGetFromGcVictimList(dieNo, blockNo);
+
+        gcRefreshStat.copiedSliceCnt += ReclaimBlock(dieNo, blockNo);
+    }
+    gcRefreshStat.refreshedCnt[pendingMsg.reason]++;
+    pending = 0;
+
+    pr_debug("Die[%u] block %u refreshed for reason %u", dieNo, blockNo, pendingMsg.reason);
+}
+#endif
+
+/**
+ * @brief Clear the read disturb counters and the queue of blocks to be refreshed.
+ */
+void InitReadDisturbTable()
+{
+    readDisturbTablePtr = (P_READ_DISTURB_TABLE)READ_DISTURB_TABLE_ADDR;
+    readDisturbRingPtr  = (P_IPC_RING)READ_DISTURB_RING_ADDR;
+
+    memset(readDisturbTablePtr, 0, sizeof(READ_DISTURB_TABLE));
+    memset(&readDisturbStat, 0, sizeof(readDisturbStat));
+    InitIpcRing(readDisturbRingPtr);
+}
+
+/**
+ * @brief Count a host read of the NAND on its block, and queue the block for refresh if
+ * it has been read `READ_DISTURB_THRESHOLD` times.
+ *
+ * @param virtualSliceAddr the VSA to be read.
+ */
+void CountReadDisturb(unsigned int virtualSliceAddr)
+{
+    P_READ_DISTURB_ENTRY disturbEntry;
+    NAND_REFRESH_MSG msg;
+
+    disturbEntry = &readDisturbTablePtr->block[Vsa2VdieTranslation(virtualSliceAddr)]
+                                              [Vsa2VblockTranslation(virtualSliceAddr)];
+    readDisturbStat.readCnt++;
+
+    // saturate instead of wrapping around if the refresh is never done
+    if (disturbEntry->readCnt < READ_DISTURB_THRESHOLD)
+        disturbEntry->readCnt++;
+    if (disturbEntry->readCnt > readDisturbStat.maxBlockReadCnt)
+        readDisturbStat.maxBlockReadCnt = disturbEntry->readCnt;
+
+    if (disturbEntry->readCnt < READ_DISTURB_THRESHOLD || disturbEntry->refreshQueued)
+        return;
+
+    msg.dword   = 0;
+    msg.dieNo   = Vsa2VdieTranslation(virtualSliceAddr);
+    msg.blockNo = Vsa2VblockTranslation(virtualSliceAddr);
+    msg.reason  = NAND_REFRESH_REASON_READ_DISTURB;
+
+    if (!PushIpcRing(readDisturbRingPtr, msg.dword))
+    {
+        readDisturbStat.ringFullCnt++;
+        return;
+    }
+
+    disturbEntry->refreshQueued = 1;
+    readDisturbStat.queuedCnt++;
+}
+
+/**
+ * @brief Start over the read disturb counter of an erased block.
+ *
+ * @param dieNo the die number of the block.
+ * @param blockNo the virtual block number of the block.
+ */
+void ResetReadDisturb(unsigned int dieNo, unsigned int blockNo)
+{
+    readDisturbTablePtr->block[dieNo][blockNo].readCnt       = 0;
+    readDisturbTablePtr->block[dieNo][blockNo].refreshQueued = 0;
+}
+
+/**
+ * @brief Clear the queue of grown bad blocks to be evacuated.
+ */
+void InitGrownBadRing()
+{
+    grownBadRingPtr = (P_IPC_RING)GROWN_BAD_RING_ADDR;
+
+    InitIpcRing(grownBadRingPtr);
+}
+
+/**
+ * @brief Queue a grown bad block for the evacuation of its valid slices.
+ *
+ * @note If the ring is full, the valid slices just stay in the block until the host
+ * overwrites them.
+ *
+ * @param dieNo the die number of the block.
+ * @param blockNo the virtual block number of the block.
+ */
+void QueueGrownBadBlock(unsigned int dieNo, unsigned int blockNo)
+{
+    NAND_REFRESH_MSG msg;
+
+    msg.dword   = 0;
+    msg.dieNo   = dieNo;
+    msg.blockNo = blockNo;
+    msg.reason  = NAND_REFRESH_REASON_GROWN_BAD;
+
+    if (!PushIpcRing(grownBadRingPtr, msg.dword))
+    {
+        grownBadBlockStat.ringFullCnt++;
+        return;
+    }
+
+    grownBadBlockStat.queuedCnt++;
 }
 
 void PutToGcVictimList(unsigned int dieNo, unsigned int blockNo, unsigned int invalidSliceCnt)
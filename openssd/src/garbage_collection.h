@@ -47,6 +47,19 @@
 #define GARBAGE_COLLECTION_H_
 
 #include "ftl_config.h"
+#include "ipc_ring.h"
+
+/**
+ * @brief Relocate the blocks read too many times since their last erase.
+ *
+ * Each read of the NAND issued for the host counts on its virtual block, check
+ * `CountReadDisturb()`. When the count of a block reaches `READ_DISTURB_THRESHOLD`, the
+ * block is queued on `readDisturbRingPtr` and refreshed in the background along with the
+ * blocks queued by `NAND_ECC_REFRESH`, check `RefreshQueuedBlock()`. The count is reset
+ * when the block is erased.
+ */
+#define READ_DISTURB_REFRESH   1
+#define READ_DISTURB_THRESHOLD 100000
 
 typedef struct _GC_VICTIM_LIST_ENTRY
 {
@@ -59,8 +72,66 @@ typedef struct _GC_VICTIM_MAP
     GC_VICTIM_LIST_ENTRY gcVictimList[USER_DIES][SLICES_PER_BLOCK + 1];
 } GC_VICTIM_MAP, *P_GC_VICTIM_MAP;
 
+/**
+ * @brief The host reads of a virtual block since its last erase.
+ */
+typedef struct _READ_DISTURB_ENTRY
+{
+    unsigned int readCnt : 31;
+    unsigned int refreshQueued : 1; // the block is already queued on `readDisturbRingPtr`
+} READ_DISTURB_ENTRY, *P_READ_DISTURB_ENTRY;
+
+typedef struct _READ_DISTURB_TABLE
+{
+    READ_DISTURB_ENTRY block[USER_DIES][USER_BLOCKS_PER_DIE];
+} READ_DISTURB_TABLE, *P_READ_DISTURB_TABLE;
+
+/**
+ * @brief The statistics of the read disturb counters.
+ *
+ * - readCnt: host reads counted
+ * - queuedCnt: blocks queued for refresh
+ * - ringFullCnt: blocks not queued since the ring was full, queued again by the next read
+ * - maxBlockReadCnt: the largest count a block has reached
+ */
+typedef struct _READ_DISTURB_STAT
+{
+    unsigned int readCnt;
+    unsigned int queuedCnt;
+    unsigned int ringFullCnt;
+    unsigned int maxBlockReadCnt;
+} READ_DISTURB_STAT, *P_READ_DISTURB_STAT;
+
+/**
+ * @brief The statistics of the background refresh, check `RefreshQueuedBlock()`.
+ *
+ * - refreshedCnt: blocks relocated and erased, by `NAND_REFRESH_REASON_*`, the grown bad
+ *   blocks are evacuated but never erased
+ * - copiedSliceCnt: valid slices copied by the refresh
+ * - skippedCnt: queued blocks that were free or bad when their turn came
+ * - parkedCnt: queued blocks that were still open and refreshed after being closed
+ * - deferredCnt: times the refresh waited for a free block on the die, or for the programs
+ *   still issued to a grown bad block
+ */
+typedef struct _GC_REFRESH_STAT
+{
+    unsigned int refreshedCnt[NAND_REFRESH_REASONS];
+    unsigned int copiedSliceCnt;
+    unsigned int skippedCnt;
+    unsigned int parkedCnt;
+    unsigned int deferredCnt;
+} GC_REFRESH_STAT, *P_GC_REFRESH_STAT;
+
 void InitGcVictimMap();
 void GarbageCollection(unsigned int dieNo);
+void RefreshQueuedBlock();
+
+void InitReadDisturbTable();
+void CountReadDisturb(unsigned int virtualSliceAddr);
+void ResetReadDisturb(unsigned int dieNo, unsigned int blockNo);
+
+void InitGrownBadRing();
+void QueueGrownBadBlock(unsigned int dieNo, unsigned int blockNo);
 
 void PutToGcVictimList(unsigned int dieNo, unsigned int blockNo, unsigned int invalidSliceCnt);
 unsigned int GetFromGcVictimList(unsigned int dieNo);
@@ -69,5 +140,10 @@ void SelectiveGetFromGcVictimList(unsigned int dieNo, unsigned int blockNo);
 extern P_GC_VICTIM_MAP gcVictimMapPtr;
 extern unsigned int gcTriggered;
 extern unsigned int copyCnt;
+extern GC_REFRESH_STAT gcRefreshStat;
+extern READ_DISTURB_STAT readDisturbStat;
+extern P_READ_DISTURB_TABLE readDisturbTablePtr;
+extern P_IPC_RING readDisturbRingPtr;
+extern P_IPC_RING grownBadRingPtr;
 
 #endif /* GARBAGE_COLLECTION_H_ */
@@ -0,0 +1,83 @@
+#include "ipc_ring.h"
+
+#define IPC_RING_SLOT(index) ((index) & (IPC_RING_ENTRIES - 1))
+
+/**
+ * @brief Empty the given ring and write it back to the memory.
+ *
+ * @warning This must be done before the other side starts using the ring.
+ *
+ * @param ring the ring to be initialized.
+ */
+void InitIpcRing(P_IPC_RING ring)
+{
+    ring->head         = 0;
+    ring->tailSnapshot = 0;
+    ring->tail         = 0;
+    ring->headSnapshot = 0;
+
+    IPC_CACHE_FLUSH(ring, 2 * IPC_CACHE_LINE_BYTES);
+}
+
+/**
+ * @brief Append a message to the given ring, producer side only.
+ *
+ * The entry is cleaned to the memory before the new `head` is published, and the barrier
+ * keeps the consumer from seeing the new `head` before the entry.
+ *
+ * @param ring the target ring.
+ * @param msg the message to be appended.
+ * @return unsigned int 1 if the message is appended, 0 if the ring is full.
+ */
+unsigned int PushIpcRing(P_IPC_RING ring, unsigned int msg)
+{
+    unsigned int head = ring->head;
+
+    if (head - ring->tailSnapshot == IPC_RING_ENTRIES)
+    {
+        IPC_CACHE_INVALIDATE(&ring->tail, sizeof(ring->tail));
+        ring->tailSnapshot = ring->tail;
+        if (head - ring->tailSnapshot == IPC_RING_ENTRIES)
+            return 0;
+    }
+
+    ring->entry[IPC_RING_SLOT(head)] = msg;
+    IPC_CACHE_FLUSH(&ring->entry[IPC_RING_SLOT(head)], sizeof(ring->entry[0]));
+    IPC_MEMORY_BARRIER();
+
+    ring->head = head + 1;
+    IPC_CACHE_FLUSH(&ring->head, sizeof(ring->head));
+
+    return 1;
+}
+
+/**
+ * @brief Remove the oldest message from the given ring, consumer side only.
+ *
+ * @param ring the target ring.
+ * @param msg the removed message.
+ * @return unsigned int 1 if a message is removed, 0 if the ring is empty.
+ */
+unsigned int PopIpcRing(P_IPC_RING ring, unsigned int *msg)
+{
+    unsigned int tail = ring->tail;
+
+    if (tail == ring->headSnapshot)
+    {
+        IPC_CACHE_INVALIDATE(&ring->head, sizeof(ring->head));
+        ring->headSnapshot = ring->head;
+        if (tail == ring->headSnapshot)
+            return 0;
+    }
+
+    // don't read the entry before the `head` that published it
+    IPC_MEMORY_BARRIER();
+    IPC_CACHE_INVALIDATE(&ring->entry[IPC_RING_SLOT(tail)], sizeof(ring->entry[0]));
+    *msg = ring->entry[IPC_RING_SLOT(tail)];
+    IPC_MEMORY_BARRIER();
+
+    ring->tail = tail + 1;
+    IPC_CACHE_FLUSH(&ring->tail, sizeof(ring->tail));
+
+    return 1;
+}
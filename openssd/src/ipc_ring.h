@@ -0,0 +1,67 @@
+#ifndef IPC_RING_H_
+#define IPC_RING_H_
+
+/**
+ * @brief The number of entries of an `IPC_RING`, must be a power of 2.
+ *
+ * Since the indices are free-running counters, all the entries can be used and a ring
+ * of this size can hold every request of the request pool at the same time.
+ */
+#ifndef IPC_RING_ENTRIES
+#define IPC_RING_ENTRIES 8192
+#endif
+
+/**
+ * @brief The cache line size of Cortex-A9 L1 data cache.
+ *
+ * The producer and consumer indices are kept in different cache lines, so that the
+ * cache maintenance of one side never writes back the stale index of the other side.
+ */
+#define IPC_CACHE_LINE_BYTES 32
+#define IPC_CACHE_LINE_WORDS (IPC_CACHE_LINE_BYTES / sizeof(unsigned int))
+
+/**
+ * @brief Cache maintenance and memory barrier of the ring.
+ *
+ * The L1 data caches of the two Cortex-A9 cores are not coherent in the standalone BSP,
+ * so the writer cleans the lines it wrote before publishing them and the reader
+ * invalidates the lines it is going to read. The cache maintenance is compiled out when
+ * the file is built on Linux, which is only meant for syntax checks of the firmware.
+ */
+#ifdef __linux__
+#define IPC_CACHE_FLUSH(addr, bytes)
+#define IPC_CACHE_INVALIDATE(addr, bytes)
+#else
+#include "xil_cache.h"
+#define IPC_CACHE_FLUSH(addr, bytes)      Xil_DCacheFlushRange((INTPTR)(addr), (bytes))
+#define IPC_CACHE_INVALIDATE(addr, bytes) Xil_DCacheInvalidateRange((INTPTR)(addr), (bytes))
+#endif
+#define IPC_MEMORY_BARRIER() __sync_synchronize()
+
+/**
+ * @brief A lock-free single-producer/single-consumer ring of 32-bit messages.
+ *
+ * The producer only writes `head`, `tailSnapshot` and the entries, and the consumer only
+ * writes `tail` and `headSnapshot`, so no lock or atomic instruction is needed. The
+ * snapshots are the last index seen from the other side, which avoids invalidating and
+ * reading the line of the other side on each push and pop.
+ *
+ * @warning The ring must be aligned to `IPC_CACHE_LINE_BYTES` and placed in shared
+ * memory, check `NAND_REQ_RING_ADDR` for example.
+ */
+typedef struct _IPC_RING
+{
+    volatile unsigned int head;         // the number of messages pushed, written by the producer
+    volatile unsigned int tailSnapshot; // the last `tail` seen by the producer
+    unsigned int reserved0[IPC_CACHE_LINE_WORDS - 2];
+    volatile unsigned int tail;         // the number of messages popped, written by the consumer
+    volatile unsigned int headSnapshot; // the last `head` seen by the consumer
+    unsigned int reserved1[IPC_CACHE_LINE_WORDS - 2];
+    volatile unsigned int entry[IPC_RING_ENTRIES];
+} IPC_RING, *P_IPC_RING;
+
+void InitIpcRing(P_IPC_RING ring);
+unsigned int PushIpcRing(P_IPC_RING ring, unsigned int msg);
+unsigned int PopIpcRing(P_IPC_RING ring, unsigned int *msg);
+
+#endif /* IPC_RING_H_ */
@@ -92,6 +92,12 @@ int main()
     {
         if (u < 0x2)
             Xil_SetTlbAttributes(u * MB, 0xC1E); // cached & buffered
+#if (NAND_DUAL_CORE)
+        else if ((NAND_CORE_IMAGE_START_ADDR >> 20) <= u && u <= (NAND_CORE_IMAGE_END_ADDR >> 20))
+            Xil_SetTlbAttributes(u * MB, 0xC1E); // cached & buffered for the image of core 1
+        else if (REQ_POOL_START_MB <= u && u <= REQ_POOL_END_MB)
+            Xil_SetTlbAttributes(u * MB, 0xC12); // uncached & nonbuffered, shared by two cores
+#endif
         else if (u < 0x180)
             Xil_SetTlbAttributes(u * MB, 0xC12); // uncached & nonbuffered
         else if (NMC_BUFFERS_START_MB <= u && u <= NMC_BUFFERS_END_MB)
@@ -110,6 +116,11 @@ int main()
     Xil_DCacheEnable();
     xil_printf("[!] MMU has been enabled.\r\n");
 
+#if (NAND_CORE_SIDE)
+    // core 1 doesn't handle interrupts, it only runs the NAND scheduler
+    NandCoreMain();
+#endif
+
     xil_printf("\r\n Hello COSMOS+ OpenSSD !!! \r\n");
 
     Xil_ExceptionInit();
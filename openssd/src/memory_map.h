@@ -68,7 +68,12 @@
 #define NVME_MANAGEMENT_START_ADDR 0x00200000
 #define NVME_MANAGEMENT_END_ADDR   0x002FFFFF
 
-#define RESERVED0_START_ADDR 0x00300000
+// the code and data of core 1, check `NAND_DUAL_CORE`
+#define NAND_CORE_IMAGE_START_ADDR 0x00300000
+#define NAND_CORE_IMAGE_END_ADDR   0x003FFFFF
+#define NAND_CORE_WAKE_ADDR        0xFFFFFFF0 // core 1 jumps to the address written here after an event
+
+#define RESERVED0_START_ADDR 0x00400000
 #define RESERVED0_END_ADDR   0x0FFFFFFF
 
 #define FTL_MANAGEMENT_START_ADDR 0x10000000
@@ -98,11 +103,15 @@
 #define MONITOR_DATA_BUFFER_END_ADDR (MONITOR_DATA_BUFFER_ADDR + sizeof(MONITOR_DATA_BUFFER))
 #define MONITOR_END_ADDR             (MONITOR_DATA_BUFFER_END_ADDR)
 
+// the buffers above must not overlap the tables for nand request completion
+#define DATA_BUFFER_LIMIT_ADDR (COMPLETE_FLAG_TABLE_ADDR)
+
 // for nand request completion
 #define COMPLETE_FLAG_TABLE_ADDR 0x17000000
 #define STATUS_REPORT_TABLE_ADDR (COMPLETE_FLAG_TABLE_ADDR + sizeof(COMPLETE_FLAG_TABLE))
 #define ERROR_INFO_TABLE_ADDR    (STATUS_REPORT_TABLE_ADDR + sizeof(STATUS_REPORT_TABLE))
 #define TEMPORARY_PAY_LOAD_ADDR  (ERROR_INFO_TABLE_ADDR + sizeof(ERROR_INFO_TABLE))
+#define READ_RETRY_PAY_LOAD_ADDR (TEMPORARY_PAY_LOAD_ADDR + 0x00000100) // after the ID data of `InitNandArray()`
 // cached & buffered
 // for buffers
 #define DATA_BUFFER_MAP_ADDR           0x18000000
@@ -118,16 +127,34 @@
 // for GC victim selection
 #define GC_VICTIM_MAP_ADDR (VIRTUAL_DIE_MAP_ADDR + sizeof(VIRTUAL_DIE_MAP))
 
-// for request pool
-#define REQ_POOL_ADDR (GC_VICTIM_MAP_ADDR + sizeof(GC_VICTIM_MAP))
+// for read disturb counters
+#define READ_DISTURB_TABLE_ADDR (GC_VICTIM_MAP_ADDR + sizeof(GC_VICTIM_MAP))
+
+// for request pool, in its own uncached megabytes when it's shared by two cores
+#if (NAND_DUAL_CORE)
+#define REQ_POOL_ADDR ALIGN_UP(READ_DISTURB_TABLE_ADDR + sizeof(READ_DISTURB_TABLE), 1024 * 1024)
+#else
+#define REQ_POOL_ADDR (READ_DISTURB_TABLE_ADDR + sizeof(READ_DISTURB_TABLE))
+#endif
+#define REQ_POOL_START_MB (REQ_POOL_ADDR >> 20)
+#define REQ_POOL_END_MB   ((REQ_POOL_ADDR + sizeof(REQ_POOL) - 1) >> 20)
 // for dependency table
 #define ROW_ADDR_DEPENDENCY_TABLE_ADDR (REQ_POOL_ADDR + sizeof(REQ_POOL))
 // for request scheduler
-#define DIE_STATE_TABLE_ADDR    (ROW_ADDR_DEPENDENCY_TABLE_ADDR + sizeof(ROW_ADDR_DEPENDENCY_TABLE))
-#define RETRY_LIMIT_TABLE_ADDR  (DIE_STATE_TABLE_ADDR + sizeof(DIE_STATE_TABLE))
-#define WAY_PRIORITY_TABLE_ADDR (RETRY_LIMIT_TABLE_ADDR + sizeof(RETRY_LIMIT_TABLE))
-
-#define FTL_MANAGEMENT_END_ADDR ((WAY_PRIORITY_TABLE_ADDR + sizeof(WAY_PRIORITY_TABLE)) - 1)
+#define DIE_STATE_TABLE_ADDR          (ROW_ADDR_DEPENDENCY_TABLE_ADDR + sizeof(ROW_ADDR_DEPENDENCY_TABLE))
+#define RETRY_LIMIT_TABLE_ADDR        (DIE_STATE_TABLE_ADDR + sizeof(DIE_STATE_TABLE))
+#define WAY_PRIORITY_TABLE_ADDR       (RETRY_LIMIT_TABLE_ADDR + sizeof(RETRY_LIMIT_TABLE))
+#define READ_RETRY_HISTORY_TABLE_ADDR (WAY_PRIORITY_TABLE_ADDR + sizeof(WAY_PRIORITY_TABLE))
+// for ECC margin tracking
+#define ECC_MARGIN_TABLE_ADDR (READ_RETRY_HISTORY_TABLE_ADDR + sizeof(NAND_READ_RETRY_HISTORY_TABLE))
+// for passing requests between two cores
+#define NAND_REQ_RING_ADDR     ALIGN_UP(ECC_MARGIN_TABLE_ADDR + sizeof(NAND_ECC_MARGIN_TABLE), IPC_CACHE_LINE_BYTES)
+#define NAND_DONE_RING_ADDR    (NAND_REQ_RING_ADDR + sizeof(IPC_RING))
+#define NAND_REFRESH_RING_ADDR (NAND_DONE_RING_ADDR + sizeof(IPC_RING))
+#define READ_DISTURB_RING_ADDR (NAND_REFRESH_RING_ADDR + sizeof(IPC_RING))
+#define GROWN_BAD_RING_ADDR    (READ_DISTURB_RING_ADDR + sizeof(IPC_RING))
+
+#define FTL_MANAGEMENT_END_ADDR ((GROWN_BAD_RING_ADDR + sizeof(IPC_RING)) - 1)
 
 #define RESERVED1_START_ADDR (FTL_MANAGEMENT_END_ADDR + 1)
 
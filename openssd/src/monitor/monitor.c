@@ -115,16 +115,16 @@ void monitor_nvme_write_slice_buffer(uint32_t cmdSlotTag, uint32_t iDie)
     PutToDataBufHashList(iBufEntry);
 
     // create RxDMA request
-    REQ_ENTRY(iReqEntry)->reqType                     = REQ_TYPE_NVME_DMA;
-    REQ_ENTRY(iReqEntry)->reqCode                     = REQ_CODE_RxDMA;
-    REQ_ENTRY(iReqEntry)->nvmeCmdSlotTag              = cmdSlotTag;
-    REQ_ENTRY(iReqEntry)->logicalSliceAddr            = LSA_NONE;               // dummy data, not useful cache
-    REQ_ENTRY(iReqEntry)->reqOpt.dataBufFormat        = REQ_OPT_DATA_BUF_ENTRY; // must use data buffer entry
-    REQ_ENTRY(iReqEntry)->dataBufInfo.entry           = iBufEntry;
-    REQ_ENTRY(iReqEntry)->nvmeDmaInfo.startIndex      = 0;
-    REQ_ENTRY(iReqEntry)->nvmeDmaInfo.nvmeBlockOffset = 0;
-    REQ_ENTRY(iReqEntry)->nvmeDmaInfo.numOfNvmeBlock  = NVME_BLOCKS_PER_SLICE;
-    REQ_ENTRY(iReqEntry)->nandInfo.virtualSliceAddr   = VSA_NONE; // dummy data, don't map to phy page
+    REQ_ENTRY(iReqEntry)->reqType                = REQ_TYPE_NVME_DMA;
+    REQ_ENTRY(iReqEntry)->reqCode                = REQ_CODE_RxDMA;
+    REQ_ENTRY(iReqEntry)->nvmeCmdSlotTag         = cmdSlotTag;
+    REQ_LSA(iReqEntry)                           = LSA_NONE;               // dummy data, not useful cache
+    REQ_ENTRY(iReqEntry)->reqOpt.dataBufFormat   = REQ_OPT_DATA_BUF_ENTRY; // must use data buffer entry
+    REQ_DATA_BUF_INFO(iReqEntry).entry           = iBufEntry;
+    REQ_NVME_DMA_INFO(iReqEntry).startIndex      = 0;
+    REQ_NVME_DMA_INFO(iReqEntry).nvmeBlockOffset = 0;
+    REQ_NVME_DMA_INFO(iReqEntry).numOfNvmeBlock  = NVME_BLOCKS_PER_SLICE;
+    REQ_NAND_INFO(iReqEntry).virtualSliceAddr    = VSA_NONE; // dummy data, don't map to phy page
 
     // do and wait DMA
     IssueNvmeDmaReq(iReqEntry); // setup auto dma before being put to req queue
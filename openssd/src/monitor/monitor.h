@@ -64,4 +64,8 @@ void monitor_dump_phy_page(uint32_t iCh, uint32_t iWay, uint32_t iPBlk, uint32_t
 void monitor_write_phy_page(uint32_t iCh, uint32_t iWay, uint32_t iPBlk, uint32_t iPage);
 void monitor_erase_phy_blk(uint32_t iCh, uint32_t iWay, uint32_t iPBlk);
 
+void monitor_dump_nand_die_util(uint32_t iDie);
+void monitor_dump_nand_util();
+void monitor_reset_nand_util();
+
 #endif /* __OPENSSD_FW_MONITOR_H__ */
\ No newline at end of file
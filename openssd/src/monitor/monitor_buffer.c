@@ -3,13 +3,142 @@
 
 #include "data_buffer.h"
 #include "request_format.h"
+#include "request_schedule.h"
+#include "garbage_collection.h"
+#include "nvme/nvme.h"
+#include "nvme/nvme_io_cmd.h"
+
+/**
+ * @brief Dump the admission statistics and the achieved QoS of each I/O submission queue.
+ *
+ * The achieved rates are averaged over the time since the QoS settings were reset.
+ */
+static void monitor_dump_nvme_io_qos()
+{
+    P_NVME_IO_SQ_QOS sqQos;
+    XTime now, elapsedMs;
+
+    XTime_GetTime(&now);
+    elapsedMs = (now - nvmeIoQos.statStartTick) / (COUNTS_PER_SECOND / 1000);
+    if (elapsedMs == 0)
+        elapsedMs = 1;
+
+    for (uint32_t iSq = 0; iSq < MAX_NUM_OF_IO_SQ; ++iSq)
+    {
+        sqQos = &nvmeIoQos.sq[iSq];
+
+        pr_info("SQ[%u] (prio %u): admitted = %u, slices = %u, wait rounds = %u (max %u), pending = %u", iSq + 1,
+                nvmeIoArb.sqPrio[iSq], nvmeIoAdmitStat.sq[iSq].admittedCnt, nvmeIoAdmitStat.sq[iSq].admittedSlices,
+                nvmeIoAdmitStat.sq[iSq].waitRounds, nvmeIoAdmitStat.sq[iSq].maxWaitRounds,
+                nvmeIoCmdPendingTable.sq[iSq].cmdCnt);
+        pr_info("    IOPS: achieved = %u, limit = %u, reserved = %u",
+                (uint32_t)(nvmeIoAdmitStat.sq[iSq].admittedCnt * 1000ULL / elapsedMs),
+                sqQos->bucket[NVME_IO_QOS_ATTR_IOPS_LIMIT].rate, sqQos->bucket[NVME_IO_QOS_ATTR_IOPS_MIN].rate);
+        pr_info("    KiB/s: achieved = %u, limit = %u, reserved = %u",
+                (uint32_t)(sqQos->admittedKiB * 1000 / elapsedMs), sqQos->bucket[NVME_IO_QOS_ATTR_BW_LIMIT].rate,
+                sqQos->bucket[NVME_IO_QOS_ATTR_BW_MIN].rate);
+        pr_info("    throttled = %u, admitted by reservation = %u", sqQos->throttledCnt, sqQos->reservedCnt);
+        for (uint32_t iBucket = 0; iBucket < NVME_IO_QOS_WAIT_BUCKETS; ++iBucket)
+            if (sqQos->admitWaitHist[iBucket])
+                pr_info("    admission wait < %u us: %u", 1U << iBucket, sqQos->admitWaitHist[iBucket]);
+    }
+}
+
+/**
+ * @brief Dump the deadline statistics and the queueing delay histogram of each NAND request class.
+ */
+static void monitor_dump_nand_req_delay()
+{
+    static const char *className[NAND_REQ_CLASSES] = {"host read", "host write", "internal", "erase", "phy"};
+
+    for (uint32_t iClass = 0; iClass < NAND_REQ_CLASSES; ++iClass)
+    {
+        pr_info("NAND %s: deadline = %u us, missed = %u, promoted = %u", className[iClass],
+                (uint32_t)(nandReqDeadline[iClass] * 1000000 / COUNTS_PER_SECOND),
+                nandReqDeadlineStat.missedCnt[iClass], nandReqDeadlineStat.promotedCnt[iClass]);
+        for (uint32_t iBucket = 0; iBucket < NAND_REQ_DELAY_BUCKETS; ++iBucket)
+            if (nandReqDeadlineStat.delayHist[iClass][iBucket])
+                pr_info("    queueing delay < %u us: %u", 1U << iBucket,
+                        nandReqDeadlineStat.delayHist[iClass][iBucket]);
+    }
+}
 
 void monitor_dump_data_buffer_info(MONITOR_MODE mode, uint32_t slsa, uint32_t elsa)
 {
     P_DATA_BUF_ENTRY entry;
 
     if (mode == MONITOR_MODE_DUMP_FULL)
+    {
         pr_info("Dump all data buffer entries");
+        pr_info("Cache: hit = %u, miss = %u, bypass = %u, bypass fallback = %u", dataBufCacheStat.hitCnt,
+                dataBufCacheStat.missCnt, dataBufCacheStat.bypassCnt, dataBufCacheStat.bypassFallbackCnt);
+        pr_info("Transient buffers: %u / %u free", dataBufBypassList.freeCnt, DATA_BUF_BYPASS_ENTRY_COUNT);
+        pr_info("Partition: shared = %u / %u, skipped victims = %u, exhausted = %u", dataBufPartition.sharedUsage,
+                DATA_BUF_SHARED_ENTRY_COUNT, dataBufPartition.skippedVictimCnt, dataBufPartition.exhaustedCnt);
+        for (uint32_t iDie = 0; iDie < USER_DIES; ++iDie)
+            pr_debug("Die[%u]: %u / %u buffer entries charged", iDie, dataBufPartition.dieUsage[iDie],
+                     DATA_BUF_DIE_QUOTA);
+        pr_info("RMW fills: deferred = %u, avoided = %u, performed = %u", dataBufFillStat.deferredCnt,
+                dataBufFillStat.avoidedCnt, dataBufFillStat.performedCnt);
+        pr_info("Admission: admitted = %u, deferred = %u, read bypass = %u, pending = %u (max %u)",
+                nvmeIoAdmitStat.admittedCnt, nvmeIoAdmitStat.deferredCnt, nvmeIoAdmitStat.bypassCnt,
+                nvmeIoCmdPendingTable.cmdCnt, nvmeIoAdmitStat.maxPendingCnt);
+        pr_info("Admission: read wait rounds = %u (max %u)", nvmeIoAdmitStat.readWaitRounds,
+                nvmeIoAdmitStat.maxReadWaitRounds);
+        pr_info("NAND read priority: promoted = %u, conflicts = %u, forced programs = %u",
+                nandReadPrioStat.promotedCnt, nandReadPrioStat.conflictCnt, nandReadPrioStat.starvationCnt);
+        monitor_dump_nvme_io_qos();
+        monitor_dump_nand_req_delay();
+        pr_info("NAND scheduling: passes = %u, channel visits = %u, ticks = %llu (max %u per pass)",
+                nandSchedStat.passCnt, nandSchedStat.chVisitCnt, nandSchedStat.passTicks, nandSchedStat.maxPassTicks);
+        for (uint32_t iCh = 0; iCh < USER_CHANNELS; ++iCh)
+            pr_info("Ch[%u] issue: passes = %u, commands = %u (max %u per pass), slots exhausted = %u, queue full = %u",
+                    iCh, nandChIssueStat[iCh].passCnt, nandChIssueStat[iCh].cmdCnt, nandChIssueStat[iCh].maxCmdsPerPass,
+                    nandChIssueStat[iCh].slotsExhaustedCnt, nandChIssueStat[iCh].queueFullCnt);
+#if (NAND_SUSPEND)
+        pr_info("NAND suspend: suspended = %u, resumed = %u, limit reached = %u", nandSuspendStat.suspendCnt,
+                nandSuspendStat.resumeCnt, nandSuspendStat.limitCnt);
+#endif
+#if (NAND_MULTI_PLANE)
+        pr_info("NAND multi-plane: reads = %u, programs = %u, erases = %u", nandMultiPlaneStat.readCnt,
+                nandMultiPlaneStat.programCnt, nandMultiPlaneStat.eraseCnt);
+#endif
+#if (NAND_CACHE_OPS)
+        pr_info("NAND cache ops: sequential reads = %u, random reads = %u, programs = %u", nandCacheStat.seqReadCnt,
+                nandCacheStat.randomReadCnt, nandCacheStat.programCnt);
+#endif
+#if (NAND_READ_RETRY)
+        pr_info("NAND read retry: reads = %u, retries = %u, recovered = %u, failed = %u, from history = %u, "
+                "level changes = %u",
+                nandReadRetryStat.readCnt, nandReadRetryStat.retryCnt, nandReadRetryStat.recoveredCnt,
+                nandReadRetryStat.failCnt, nandReadRetryStat.historyCnt, nandReadRetryStat.levelSetCnt);
+#endif
+#if (NAND_ECC_REFRESH)
+        pr_info("ECC refresh: samples = %u, queued by margin = %u, queued by retry = %u, ring full = %u",
+                nandEccMarginStat.sampleCnt, nandEccMarginStat.queuedCnt[NAND_REFRESH_REASON_MARGIN],
+                nandEccMarginStat.queuedCnt[NAND_REFRESH_REASON_RETRY], nandEccMarginStat.ringFullCnt);
+#endif
+#if (READ_DISTURB_REFRESH)
+        pr_info("Read disturb: reads = %u, queued = %u, ring full = %u, max block reads = %u",
+                readDisturbStat.readCnt, readDisturbStat.queuedCnt, readDisturbStat.ringFullCnt,
+                readDisturbStat.maxBlockReadCnt);
+#endif
+#if (GROWN_BAD_BLOCK_SALVAGE)
+        pr_info("Grown bad blocks: marked = %u, retargeted programs = %u, queued = %u, ring full = %u, "
+                "bbt pending = %u, bbt saved = %u",
+                grownBadBlockStat.markedCnt, grownBadBlockStat.retargetedCnt, grownBadBlockStat.queuedCnt,
+                grownBadBlockStat.ringFullCnt, grownBadBlockStat.bbtPendingCnt, grownBadBlockStat.bbtSavedCnt);
+#endif
+#if (NAND_ECC_REFRESH || READ_DISTURB_REFRESH || GROWN_BAD_BLOCK_SALVAGE)
+        pr_info("Refresh: by margin = %u, by retry = %u, by read disturb = %u, evacuated = %u, copied slices = %u, "
+                "skipped = %u, parked = %u, deferred = %u",
+                gcRefreshStat.refreshedCnt[NAND_REFRESH_REASON_MARGIN],
+                gcRefreshStat.refreshedCnt[NAND_REFRESH_REASON_RETRY],
+                gcRefreshStat.refreshedCnt[NAND_REFRESH_REASON_READ_DISTURB],
+                gcRefreshStat.refreshedCnt[NAND_REFRESH_REASON_GROWN_BAD], gcRefreshStat.copiedSliceCnt,
+                gcRefreshStat.skippedCnt, gcRefreshStat.parkedCnt, gcRefreshStat.deferredCnt);
+#endif
+    }
     else if (mode == MONITOR_MODE_DUMP_DIRTY)
         pr_info("Dump dirty data buffer entries");
     else if (mode == MONITOR_MODE_DUMP_RANGE)
@@ -49,6 +178,8 @@ void monitor_dump_data_buffer_info(MONITOR_MODE mode, uint32_t slsa, uint32_t el
         pr_info("   .blockingReqTail    = %u", entry->blockingReqTail);
         pr_info("   .phyReq             = %u", entry->phyReq);
         pr_info("   .dontCache          = %u", entry->dontCache);
+        pr_info("   .sectorValid        = 0x%x", entry->sectorValid);
+        pr_info("   .chargedDie         = %u", entry->chargedDie);
     }
 }
 
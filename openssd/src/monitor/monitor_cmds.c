@@ -62,6 +62,23 @@ void monitor_handle_admin_cmds(uint32_t cmdSlotTag, NVME_ADMIN_COMMAND *nvmeAdmi
             break;
         }
     }
+    else if (nvmeAdminCmd->OPC == ADMIN_MONITOR_SCHED)
+    {
+        uint32_t iDie = nvmeAdminCmd->dword11;
+
+        switch (mode)
+        {
+        case 1:
+            monitor_reset_nand_util();
+            break;
+        case 2:
+            monitor_dump_nand_die_util(iDie);
+            break;
+        default:
+            monitor_dump_nand_util();
+            break;
+        }
+    }
     else if (nvmeAdminCmd->OPC == ADMIN_MONITOR_MAPPING)
     {
         uint32_t src = nvmeAdminCmd->dword11;
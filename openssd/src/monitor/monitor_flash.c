@@ -5,6 +5,7 @@
 #include "data_buffer.h"
 #include "request_allocation.h"
 #include "request_transform.h"
+#include "request_schedule.h"
 
 /**
  * @brief Dump all free blocks on the specified die by traversing the free block table.
@@ -45,13 +46,13 @@ void monitor_dump_phy_page(uint32_t iCh, uint32_t iWay, uint32_t iPBlk, uint32_t
     REQ_ENTRY(iReqEntry)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
     REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
     REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-    REQ_ENTRY(iReqEntry)->dataBufInfo.addr              = (uintptr_t)MONITOR_DIE_DATA_BUF(iDie).byte;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalCh           = iCh;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalWay          = iWay;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalBlock        = iPBlk;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalPage         = iPage;
+    REQ_DATA_BUF_INFO(iReqEntry).addr                   = (uintptr_t)MONITOR_DIE_DATA_BUF(iDie).byte;
+    REQ_NAND_INFO(iReqEntry).physicalCh                 = iCh;
+    REQ_NAND_INFO(iReqEntry).physicalWay                = iWay;
+    REQ_NAND_INFO(iReqEntry).physicalBlock              = iPBlk;
+    REQ_NAND_INFO(iReqEntry).physicalPage               = iPage;
 
-    pr_debug("Req[%u]: MONITOR READ (buffer 0x%x)", iReqEntry, REQ_ENTRY(iReqEntry)->dataBufInfo.addr);
+    pr_debug("Req[%u]: MONITOR READ (buffer 0x%x)", iReqEntry, REQ_DATA_BUF_INFO(iReqEntry).addr);
     monitor_dump_phy_page_info(iCh, iWay, iPBlk, iPage);
 
     // issue and wait until finished
@@ -87,11 +88,11 @@ void monitor_write_phy_page(uint32_t iCh, uint32_t iWay, uint32_t iPBlk, uint32_
     REQ_ENTRY(iReqEntry)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_PHY_ORG;
     REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
     REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
-    REQ_ENTRY(iReqEntry)->dataBufInfo.addr              = (uintptr_t)MONITOR_DIE_DATA_BUF(iDie).byte;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalCh           = iCh;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalWay          = iWay;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalBlock        = iPBlk;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalPage         = iPage;
+    REQ_DATA_BUF_INFO(iReqEntry).addr                   = (uintptr_t)MONITOR_DIE_DATA_BUF(iDie).byte;
+    REQ_NAND_INFO(iReqEntry).physicalCh                 = iCh;
+    REQ_NAND_INFO(iReqEntry).physicalWay                = iWay;
+    REQ_NAND_INFO(iReqEntry).physicalBlock              = iPBlk;
+    REQ_NAND_INFO(iReqEntry).physicalPage               = iPage;
 
     pr_debug("Physical write in address:%x",(uintptr_t)MONITOR_DIE_DATA_BUF(iDie).byte);
     // dump buffer content before issuing write request
@@ -128,10 +129,10 @@ void monitor_erase_phy_blk(uint32_t iCh, uint32_t iWay, uint32_t iPBlk)
     REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
     REQ_ENTRY(iReqEntry)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_NONE; /* no buffer needed */
     REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalCh           = iCh;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalWay          = iWay;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalBlock        = iPBlk;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalPage         = 0; /* dummy */
+    REQ_NAND_INFO(iReqEntry).physicalCh                 = iCh;
+    REQ_NAND_INFO(iReqEntry).physicalWay                = iWay;
+    REQ_NAND_INFO(iReqEntry).physicalBlock              = iPBlk;
+    REQ_NAND_INFO(iReqEntry).physicalPage               = 0; /* dummy */
 
     // print request info
     pr_debug("Req[%u]: ERASE", iReqEntry);
@@ -141,3 +142,124 @@ void monitor_erase_phy_blk(uint32_t iCh, uint32_t iWay, uint32_t iPBlk)
     SelectLowLevelReqQ(iReqEntry);
     SyncAllLowLevelReqDone();
 }
+
+/**
+ * @brief Convert the given timer ticks to microseconds.
+ *
+ * The whole seconds are converted separately, so that neither the result nor the product
+ * overflows for any uptime of the board.
+ */
+static unsigned long long monitor_ticks_to_us(XTime ticks)
+{
+    return (ticks / COUNTS_PER_SECOND) * 1000000 + (ticks % COUNTS_PER_SECOND) * 1000000 / COUNTS_PER_SECOND;
+}
+
+/**
+ * @brief Warn that the utilization statistics of core 0 don't cover the dies of core 1.
+ *
+ * Each core image has its own copy of the statistics, and after `StartNandCore()` all the
+ * NAND operations are issued by core 1, so the copy of core 0 stops being updated.
+ */
+static void monitor_check_nand_util_core()
+{
+    if (nandCoreRunning)
+        pr_warn("NAND utilization is only accounted on core 0, the dies scheduled by core 1 are not included");
+}
+
+/**
+ * @brief Print the busy time and the queueing statistics of the specified die.
+ *
+ * The busy and idle time are in microseconds, and the ratios are in thousandths of the
+ * time since the last reset, check `NAND_UTIL_STAT`.
+ *
+ * @param iDie The target die number.
+ */
+static void monitor_print_nand_die_util(uint32_t iDie)
+{
+    static const char *opName[NAND_UTIL_OPS] = {"read", "transfer", "program", "erase", "other"};
+    P_NAND_DIE_UTIL_STAT dieUtil;
+    XTime now, elapsed, busy = 0;
+
+    if (iDie >= USER_DIES)
+    {
+        pr_error("Die[%u]: Invalid die number!!", iDie);
+        return;
+    }
+
+    XTime_GetTime(&now);
+    elapsed = (now > nandUtilStartTick) ? now - nandUtilStartTick : 1;
+    dieUtil = &nandDieUtilStat[VDIE2PCH(iDie)][VDIE2PWAY(iDie)];
+
+    for (uint32_t iOp = 0; iOp < NAND_UTIL_OPS; ++iOp)
+        busy += dieUtil->busyTicks[iOp];
+    if (busy > elapsed)
+        busy = elapsed;
+
+    pr_info("Die[%u] (Ch %u Way %u): busy = %llu us (%u/1000), idle = %llu us", iDie, VDIE2PCH(iDie), VDIE2PWAY(iDie),
+            monitor_ticks_to_us(busy), (uint32_t)(busy * 1000 / elapsed), monitor_ticks_to_us(elapsed - busy));
+    for (uint32_t iOp = 0; iOp < NAND_UTIL_OPS; ++iOp)
+        if (dieUtil->opCnt[iOp])
+            pr_info("    %s: ops = %u, busy = %llu us (%u/1000), avg = %llu us", opName[iOp], dieUtil->opCnt[iOp],
+                    monitor_ticks_to_us(dieUtil->busyTicks[iOp]),
+                    (uint32_t)(dieUtil->busyTicks[iOp] * 1000 / elapsed),
+                    monitor_ticks_to_us(dieUtil->busyTicks[iOp] / dieUtil->opCnt[iOp]));
+    pr_info("    list wait: issues = %u, avg = %llu us; queue depth: avg = %u/100, max = %u", dieUtil->waitCnt,
+            dieUtil->waitCnt ? monitor_ticks_to_us(dieUtil->waitTicks / dieUtil->waitCnt) : 0,
+            dieUtil->depthSampleCnt ? (uint32_t)(dieUtil->depthSum * 100 / dieUtil->depthSampleCnt) : 0,
+            dieUtil->maxDepth);
+}
+
+/**
+ * @brief Dump the busy time and the queueing statistics of the specified die.
+ *
+ * @param iDie The target die number.
+ */
+void monitor_dump_nand_die_util(uint32_t iDie)
+{
+    monitor_check_nand_util_core();
+    monitor_print_nand_die_util(iDie);
+}
+
+/**
+ * @brief Dump the utilization of all the dies and the queueing statistics of all the
+ * channels.
+ *
+ * The transfer ratio of a channel is the sum of the transfer time of its dies, which is
+ * the time the channel was occupied by the data out of reads.
+ */
+void monitor_dump_nand_util()
+{
+    XTime now, elapsed, transfer;
+
+    XTime_GetTime(&now);
+    elapsed = (now > nandUtilStartTick) ? now - nandUtilStartTick : 1;
+    monitor_check_nand_util_core();
+    pr_info("NAND utilization over %llu us:", monitor_ticks_to_us(elapsed));
+
+    for (uint32_t iDie = 0; iDie < USER_DIES; ++iDie)
+        monitor_print_nand_die_util(iDie);
+
+    for (uint32_t iCh = 0; iCh < USER_CHANNELS; ++iCh)
+    {
+        transfer = 0;
+        for (uint32_t iWay = 0; iWay < USER_WAYS; ++iWay)
+            transfer += nandDieUtilStat[iCh][iWay].busyTicks[NAND_UTIL_OP_TRANSFER];
+
+        pr_info("Ch[%u]: transfer = %llu us (%u/1000), queue depth: samples = %u, avg = %u/100, max = %u", iCh,
+                monitor_ticks_to_us(transfer), (uint32_t)(transfer * 1000 / elapsed),
+                nandChUtilStat[iCh].depthSampleCnt,
+                nandChUtilStat[iCh].depthSampleCnt
+                    ? (uint32_t)(nandChUtilStat[iCh].depthSum * 100 / nandChUtilStat[iCh].depthSampleCnt)
+                    : 0,
+                nandChUtilStat[iCh].maxDepth);
+    }
+}
+
+/**
+ * @brief Start over the utilization statistics of all the dies and channels.
+ */
+void monitor_reset_nand_util()
+{
+    ResetNandUtilStat();
+    pr_info("NAND utilization statistics reset");
+}
@@ -322,12 +322,12 @@ void nmcRecoverMappingDir()
                     REQ_ENTRY(iReqEntry)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
                     REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
                     REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-                    REQ_ENTRY(iReqEntry)->logicalSliceAddr              = REQ_OPT_BLOCK_SPACE_TOTAL;
-                    REQ_ENTRY(iReqEntry)->dataBufInfo.addr              = NMC_CH_MAP_BUFFER_ADDR(iCh);
-                    REQ_ENTRY(iReqEntry)->nandInfo.physicalCh           = iCh;
-                    REQ_ENTRY(iReqEntry)->nandInfo.physicalWay          = cursor.iWay;
-                    REQ_ENTRY(iReqEntry)->nandInfo.physicalBlock        = NMC_MAPPING_DIR2PBLK(cursor.iDir);
-                    REQ_ENTRY(iReqEntry)->nandInfo.physicalPage         = cursor.iPage;
+                    REQ_LSA(iReqEntry)                                  = REQ_OPT_BLOCK_SPACE_TOTAL;
+                    REQ_DATA_BUF_INFO(iReqEntry).addr                   = NMC_CH_MAP_BUFFER_ADDR(iCh);
+                    REQ_NAND_INFO(iReqEntry).physicalCh                 = iCh;
+                    REQ_NAND_INFO(iReqEntry).physicalWay                = cursor.iWay;
+                    REQ_NAND_INFO(iReqEntry).physicalBlock              = NMC_MAPPING_DIR2PBLK(cursor.iDir);
+                    REQ_NAND_INFO(iReqEntry).physicalPage               = cursor.iPage;
 
                     // issue request
                     pr_debug("NMC: Reading Blk[%u].Page[%u]...", NMC_MAPPING_DIR2PBLK(cursor.iDir), cursor.iPage);
@@ -553,11 +553,11 @@ static void nmcFlushMapping(uint32_t iCh)
     REQ_ENTRY(iReqEntry)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
     REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
     REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-    REQ_ENTRY(iReqEntry)->dataBufInfo.addr              = dataBufAddr;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalCh           = iCh;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalWay          = nmcNewMappingLoc[iCh].iWay;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalBlock        = NMC_NEW_MAPPING_PBLK_ON(iCh);
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalPage         = nmcNewMappingLoc[iCh].iPage;
+    REQ_DATA_BUF_INFO(iReqEntry).addr                   = dataBufAddr;
+    REQ_NAND_INFO(iReqEntry).physicalCh                 = iCh;
+    REQ_NAND_INFO(iReqEntry).physicalWay                = nmcNewMappingLoc[iCh].iWay;
+    REQ_NAND_INFO(iReqEntry).physicalBlock              = NMC_NEW_MAPPING_PBLK_ON(iCh);
+    REQ_NAND_INFO(iReqEntry).physicalPage               = nmcNewMappingLoc[iCh].iPage;
 
     // issue request and wait for finish
     SelectLowLevelReqQ(iReqEntry);
@@ -654,12 +654,12 @@ uintptr_t nmcReadMappingTable(uint8_t iCh, NMC_MAPPING_LOC loc)
     REQ_ENTRY(iReqEntry)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
     REQ_ENTRY(iReqEntry)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
     REQ_ENTRY(iReqEntry)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-    REQ_ENTRY(iReqEntry)->logicalSliceAddr              = REQ_OPT_BLOCK_SPACE_TOTAL;
-    REQ_ENTRY(iReqEntry)->dataBufInfo.addr              = dataBufAddr;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalCh           = iCh;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalWay          = loc.iWay;
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalBlock        = NMC_MAPPING_DIR2PBLK(loc.iDir);
-    REQ_ENTRY(iReqEntry)->nandInfo.physicalPage         = loc.iPage;
+    REQ_LSA(iReqEntry)                                  = REQ_OPT_BLOCK_SPACE_TOTAL;
+    REQ_DATA_BUF_INFO(iReqEntry).addr                   = dataBufAddr;
+    REQ_NAND_INFO(iReqEntry).physicalCh                 = iCh;
+    REQ_NAND_INFO(iReqEntry).physicalWay                = loc.iWay;
+    REQ_NAND_INFO(iReqEntry).physicalBlock              = NMC_MAPPING_DIR2PBLK(loc.iDir);
+    REQ_NAND_INFO(iReqEntry).physicalPage               = loc.iPage;
 
     // issue request and wait for finish
     SelectLowLevelReqQ(iReqEntry);
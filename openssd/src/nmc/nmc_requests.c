@@ -60,9 +60,9 @@ bool nmcRegisterNewMappingReqDone(uint32_t iReqEntry)
 
         pr_info("NMC: A New Mapping Request is Registered by Req[%u]:", iReqEntry);
         pr_debug(".nvmeCmdSlotTag:    %u", reqEntry->nvmeCmdSlotTag);
-        pr_debug(".logicalSliceAddr:  %u", reqEntry->logicalSliceAddr);
-        pr_debug(".dataBufInfo.entry: %u", reqEntry->dataBufInfo.entry);
-        pr_debug("     (base address: 0x%x)", BUF_DATA_ENTRY2ADDR(reqEntry->dataBufInfo.entry));
+        pr_debug(".logicalSliceAddr:  %u", REQ_LSA(iReqEntry));
+        pr_debug(".dataBufInfo.entry: %u", REQ_BUF(iReqEntry));
+        pr_debug("     (base address: 0x%x)", BUF_DATA_ENTRY2ADDR(REQ_BUF(iReqEntry)));
 
         nmcPendingNewMappingReq.iReqEntry = iReqEntry;
         return true;
@@ -97,9 +97,9 @@ bool nmcRegisterInferenceReq(uint32_t iReqEntry)
 
         pr_info("NMC: An inference request registered by Req[%u]:", iReqEntry);
         pr_debug(".nvmeCmdSlotTag:    %u", reqInference->nvmeCmdSlotTag);
-        pr_debug(".logicalSliceAddr:  %u", reqInference->logicalSliceAddr);
-        pr_debug(".dataBufInfo.entry: %u", reqInference->dataBufInfo.entry);
-        pr_debug("     (base address: 0x%x)", BUF_DATA_ENTRY2ADDR(reqInference->dataBufInfo.entry));
+        pr_debug(".logicalSliceAddr:  %u", REQ_LSA(iReqEntry));
+        pr_debug(".dataBufInfo.entry: %u", REQ_BUF(iReqEntry));
+        pr_debug("     (base address: 0x%x)", BUF_DATA_ENTRY2ADDR(REQ_BUF(iReqEntry)));
 
         nmcPendingInferenceReq.iReqEntry = iReqEntry;
         return true;
@@ -134,7 +134,7 @@ void nmcReqScheduling()
 
     if (nmcPendingNewMappingReq.initialized && nmcPendingNewMappingReq.iReqEntry != REQ_SLOT_TAG_NONE)
     {
-        nmcFilenameFromDataBuf(REQ_ENTRY(nmcPendingNewMappingReq.iReqEntry)->dataBufInfo.entry, filename);
+        nmcFilenameFromDataBuf(REQ_DATA_BUF_INFO(nmcPendingNewMappingReq.iReqEntry).entry, filename);
         pr_info("Received filename: '%s'", filename);
 
         res = nmcNewMapping(filename, nmcPendingNewMappingReq.filetype, nmcPendingNewMappingReq.nblks);
@@ -145,7 +145,7 @@ void nmcReqScheduling()
     if (nmcPendingInferenceReq.iReqEntry != REQ_SLOT_TAG_NONE)
     {
         // check filename
-        nmcFilenameFromDataBuf(REQ_ENTRY(nmcPendingInferenceReq.iReqEntry)->dataBufInfo.entry, filename);
+        nmcFilenameFromDataBuf(REQ_DATA_BUF_INFO(nmcPendingInferenceReq.iReqEntry).entry, filename);
 
         pr_debug("NMC: Target image filename: '%s'", filename);
 
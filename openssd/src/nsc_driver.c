@@ -309,6 +309,190 @@ void __attribute__((optimize("O0"))) V2FEraseBlockAsync(T4REGS *t4regs, int way,
     V2FIssueCommand(t4regs);
 }
 
+/**
+ * @brief Set the read retry level of the specified way for the following reads.
+ *
+ * The way is busy for tFEAT after this command, so it should be checked by
+ * `V2FStatusCheckAsync()` before the next read is triggered.
+ *
+ * @param payload the parameters of the feature, P1 in the lowest byte. It must not be
+ * modified until the command is done.
+ */
+void __attribute__((optimize("O0"))) V2FSetReadRetryAsync(T4REGS *t4regs, int way, volatile unsigned int *payload)
+{
+    pr_debug("ChReg 0x%p Way %u Level %u", t4regs, way, *payload);
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FSetFeaturesT(t4regs, way, V2F_READ_RETRY_FEATURE_ADDR, payload);
+}
+
+#if (V2F_SUSPEND_SUPPORTED)
+/**
+ * @brief Suspend the program or erase in progress on the specified way.
+ *
+ * The way becomes ready after the suspend latency, and the suspended operation must be
+ * resumed by `V2FResumeAsync()` before any other program or erase is issued to the way.
+ */
+void __attribute__((optimize("O0"))) V2FSuspendAsync(T4REGS *t4regs, int way)
+{
+    pr_debug("ChReg 0x%p Way %u", t4regs, way);
+    T4REG_CMD_SUSPEND_RESUME suspendCmd;
+
+    suspendCmd.cmdSelect = T4NSC_CMD_SUSPEND;
+    suspendCmd.waySelect = 1 << way;
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_SUSPEND_RESUME, suspendCmd);
+    V2FIssueCommand(t4regs);
+}
+
+/**
+ * @brief Resume the suspended program or erase on the specified way.
+ */
+void __attribute__((optimize("O0"))) V2FResumeAsync(T4REGS *t4regs, int way)
+{
+    pr_debug("ChReg 0x%p Way %u", t4regs, way);
+    T4REG_CMD_SUSPEND_RESUME resumeCmd;
+
+    resumeCmd.cmdSelect = T4NSC_CMD_RESUME;
+    resumeCmd.waySelect = 1 << way;
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_SUSPEND_RESUME, resumeCmd);
+    V2FIssueCommand(t4regs);
+}
+#endif
+
+#if (V2F_MULTI_PLANE_SUPPORTED)
+/**
+ * @brief Load the pages of the given rows to the page registers of their planes.
+ *
+ * The page registers should then be transferred one by one with `V2FReadPageTransferAsync()`.
+ */
+void __attribute__((optimize("O0")))
+V2FReadPageTriggerMultiPlaneAsync(T4REGS *t4regs, int way, unsigned int rowAddress[])
+{
+    pr_debug("ChReg 0x%p Way %u Row %u %u", t4regs, way, rowAddress[0], rowAddress[1]);
+    T4REG_CMD_MULTI_PLANE_ROW readPageTriggerCmd;
+    unsigned int plane;
+
+    readPageTriggerCmd.cmdSelect = T4NSC_CMD_READ_PAGE_TRIGGER_MULTI_PLANE;
+    readPageTriggerCmd.waySelect = 1 << way;
+    for (plane = 0; plane < V2F_MULTI_PLANES; plane++)
+        readPageTriggerCmd.rowAddress[plane] = rowAddress[plane];
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_MULTI_PLANE_ROW, readPageTriggerCmd);
+    V2FIssueCommand(t4regs);
+}
+
+void __attribute__((optimize("O0")))
+V2FProgramPageMultiPlaneAsync(T4REGS *t4regs, int way, unsigned int rowAddress[], void *pageDataBuffer[],
+                              void *spareDataBuffer[])
+{
+    pr_warn("ChReg 0x%p Way %u Row %u %u", t4regs, way, rowAddress[0], rowAddress[1]);
+    T4REG_CMD_PROGRAM_PAGE_MULTI_PLANE progPageCmd;
+    unsigned int plane;
+
+    progPageCmd.cmdSelect = T4NSC_CMD_PROGRAM_PAGE_MULTI_PLANE;
+    progPageCmd.waySelect = 1 << way;
+    for (plane = 0; plane < V2F_MULTI_PLANES; plane++)
+    {
+        progPageCmd.Planes[plane].rowAddress       = rowAddress[plane];
+        progPageCmd.Planes[plane].pageDataAddress  = (unsigned int)pageDataBuffer[plane];
+        progPageCmd.Planes[plane].spareDataAddress = (unsigned int)spareDataBuffer[plane];
+    }
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_PROGRAM_PAGE_MULTI_PLANE, progPageCmd);
+    V2FIssueCommand(t4regs);
+}
+
+void __attribute__((optimize("O0"))) V2FEraseBlockMultiPlaneAsync(T4REGS *t4regs, int way, unsigned int rowAddress[])
+{
+    pr_warn("ChReg 0x%p Way %u Row %u %u", t4regs, way, rowAddress[0], rowAddress[1]);
+    T4REG_CMD_MULTI_PLANE_ROW eraseBlockCmd;
+    unsigned int plane;
+
+    eraseBlockCmd.cmdSelect = T4NSC_CMD_ERASE_BLOCK_MULTI_PLANE;
+    eraseBlockCmd.waySelect = 1 << way;
+    for (plane = 0; plane < V2F_MULTI_PLANES; plane++)
+    {
+        assert((rowAddress[plane] & 0xFF) == 0);
+        eraseBlockCmd.rowAddress[plane] = rowAddress[plane];
+    }
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_MULTI_PLANE_ROW, eraseBlockCmd);
+    V2FIssueCommand(t4regs);
+}
+#endif
+
+#if (V2F_CACHE_OPS_SUPPORTED)
+/**
+ * @brief Move the page of the previous read to the cache register and start the next read.
+ *
+ * The previous page can be transferred by `V2FReadPageTransferAsync()` while the array
+ * read of the given row is in progress.
+ *
+ * @param sequential 1 if the row is the one after the previous read, the row address is
+ * ignored in this case.
+ */
+void __attribute__((optimize("O0")))
+V2FReadPageCacheAsync(T4REGS *t4regs, int way, unsigned int rowAddress, int sequential)
+{
+    pr_debug("ChReg 0x%p Way %u Row %u Seq %d", t4regs, way, rowAddress, sequential);
+    T4REG_CMD_READ_PAGE_TRIGGER readPageCacheCmd;
+
+    readPageCacheCmd.cmdSelect  = sequential ? T4NSC_CMD_READ_PAGE_CACHE_SEQ : T4NSC_CMD_READ_PAGE_CACHE_RANDOM;
+    readPageCacheCmd.waySelect  = 1 << way;
+    readPageCacheCmd.rowAddress = rowAddress;
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_READ_PAGE_TRIGGER, readPageCacheCmd);
+    V2FIssueCommand(t4regs);
+}
+
+void __attribute__((optimize("O0"))) V2FReadPageCacheEndAsync(T4REGS *t4regs, int way)
+{
+    pr_debug("ChReg 0x%p Way %u", t4regs, way);
+    T4REG_CMD_READ_PAGE_CACHE_END readPageCacheEndCmd;
+
+    readPageCacheEndCmd.cmdSelect = T4NSC_CMD_READ_PAGE_CACHE_END;
+    readPageCacheEndCmd.waySelect = 1 << way;
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_READ_PAGE_CACHE_END, readPageCacheEndCmd);
+    V2FIssueCommand(t4regs);
+}
+
+void __attribute__((optimize("O0")))
+V2FProgramPageCacheAsync(T4REGS *t4regs, int way, unsigned int rowAddress, void *pageDataBuffer, void *spareDataBuffer)
+{
+    pr_warn("ChReg 0x%p Way %u Row %u", t4regs, way, rowAddress);
+    T4REG_CMD_PROGRAM_PAGE_TRANSFER_PSLC progPageCacheCmd;
+
+    progPageCacheCmd.cmdSelect        = T4NSC_CMD_PROGRAM_PAGE_CACHE;
+    progPageCacheCmd.waySelect        = 1 << way;
+    progPageCacheCmd.rowAddress       = rowAddress;
+    progPageCacheCmd.pageDataAddress  = (unsigned int)pageDataBuffer;
+    progPageCacheCmd.spareDataAddress = (unsigned int)spareDataBuffer;
+
+    while (V2FIsControllerBusy(t4regs))
+        ;
+    V2FFillRegisters(t4regs, T4REG_CMD_PROGRAM_PAGE_TRANSFER_PSLC, progPageCacheCmd);
+    V2FIssueCommand(t4regs);
+}
+#endif
+
 void __attribute__((optimize("O0"))) V2FStatusCheckAsync(T4REGS *t4regs, int way, unsigned int *statusReport)
 {
     pr_debug("ChReg 0x%p Way %u", t4regs, way);
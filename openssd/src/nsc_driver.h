@@ -94,6 +94,80 @@
 #define T4NSC_CMD_FSP_PAGES          (T4NSC_CMD_END_OF_COMMON + 960)
 #define T4NSC_CMD_END_OF_PLAINOPS    (T4NSC_CMD_END_OF_COMMON + 1308)
 
+/**
+ * @brief The feature address of the read retry option of the NAND device.
+ *
+ * Writing a level to this feature shifts the read reference voltages of the following
+ * reads, check the datasheet of the device for the address and the meaning of the levels.
+ */
+#define V2F_READ_RETRY_FEATURE_ADDR 0x89
+
+/**
+ * @brief The program/erase suspend and resume commands.
+ *
+ * The T4NSC microcode of the current bitstream doesn't provide these two commands. If the
+ * controller is rebuilt with suspend and resume microprograms, define their offsets here
+ * to enable `V2FSuspendAsync()`, `V2FResumeAsync()` and `NAND_SUSPEND` of the scheduler.
+ */
+// #define T4NSC_CMD_SUSPEND
+// #define T4NSC_CMD_RESUME
+
+#if defined(T4NSC_CMD_SUSPEND) && defined(T4NSC_CMD_RESUME)
+#define V2F_SUSPEND_SUPPORTED 1
+#else
+#define V2F_SUSPEND_SUPPORTED 0
+#endif
+
+/**
+ * @brief The two-plane read trigger, program and erase commands.
+ *
+ * Like the suspend commands, the current microcode doesn't provide multi-plane operations,
+ * define their offsets here after the controller is rebuilt with them to enable the
+ * `V2F*MultiPlaneAsync()` functions and `NAND_MULTI_PLANE` of the scheduler.
+ *
+ * The two row addresses of a multi-plane command must be in different planes of the same
+ * LUN and have the same page offset, and the row address of plane 0 goes first.
+ */
+// #define T4NSC_CMD_READ_PAGE_TRIGGER_MULTI_PLANE
+// #define T4NSC_CMD_PROGRAM_PAGE_MULTI_PLANE
+// #define T4NSC_CMD_ERASE_BLOCK_MULTI_PLANE
+
+#if defined(T4NSC_CMD_READ_PAGE_TRIGGER_MULTI_PLANE) && defined(T4NSC_CMD_PROGRAM_PAGE_MULTI_PLANE) &&         \
+    defined(T4NSC_CMD_ERASE_BLOCK_MULTI_PLANE)
+#define V2F_MULTI_PLANE_SUPPORTED 1
+#else
+#define V2F_MULTI_PLANE_SUPPORTED 0
+#endif
+
+#define V2F_MULTI_PLANES 2
+
+/**
+ * @brief The cache read and cache program commands.
+ *
+ * - READ_PAGE_CACHE_SEQ (31h): move the page register to the cache register and start
+ *   reading the next row of the previous read into the page register.
+ * - READ_PAGE_CACHE_RANDOM (00h-31h): same as above, but read the given row.
+ * - READ_PAGE_CACHE_END (3Fh): move the page register to the cache register and leave the
+ *   cache read mode.
+ * - PROGRAM_PAGE_CACHE (80h-15h): the die becomes ready once the data are moved to the
+ *   cache register, and the next page can be loaded while the previous one is programmed.
+ *   The last program of a sequence must be a normal program (80h-10h).
+ *
+ * The current microcode doesn't provide them either, define their offsets here to enable
+ * the `V2F*CacheAsync()` functions and `NAND_CACHE_OPS` of the scheduler.
+ */
+// #define T4NSC_CMD_READ_PAGE_CACHE_SEQ
+// #define T4NSC_CMD_READ_PAGE_CACHE_RANDOM
+// #define T4NSC_CMD_READ_PAGE_CACHE_END
+// #define T4NSC_CMD_PROGRAM_PAGE_CACHE
+
+#if defined(T4NSC_CMD_READ_PAGE_CACHE_SEQ) && defined(T4NSC_CMD_READ_PAGE_CACHE_RANDOM) &&                     \
+    defined(T4NSC_CMD_READ_PAGE_CACHE_END) && defined(T4NSC_CMD_PROGRAM_PAGE_CACHE)
+#define V2F_CACHE_OPS_SUPPORTED 1
+#else
+#define V2F_CACHE_OPS_SUPPORTED 0
+#endif
+
 #define V2FFillRegisters(t4regs, cmdtype, cmdpayload) (*((volatile cmdtype *)((t4regs)->t4regSP)) = (cmdpayload))
 #define V2FIssueCommand(t4regs)                       (((t4regs)->t4regCC)->issueCmd = 1)
 
@@ -255,6 +329,37 @@ typedef struct
     unsigned int rowAddress;
 } T4REG_CMD_ERASE_BLOCK;
 
+typedef struct
+{
+    unsigned int cmdSelect;
+    unsigned int waySelect;
+} T4REG_CMD_SUSPEND_RESUME;
+
+typedef struct
+{
+    unsigned int cmdSelect;
+    unsigned int waySelect;
+} T4REG_CMD_READ_PAGE_CACHE_END;
+
+typedef struct
+{
+    unsigned int cmdSelect;
+    unsigned int waySelect;
+    unsigned int rowAddress[V2F_MULTI_PLANES];
+} T4REG_CMD_MULTI_PLANE_ROW;
+
+typedef struct
+{
+    unsigned int cmdSelect;
+    unsigned int waySelect;
+    struct
+    {
+        unsigned int rowAddress;
+        unsigned int pageDataAddress;
+        unsigned int spareDataAddress;
+    } Planes[V2F_MULTI_PLANES];
+} T4REG_CMD_PROGRAM_PAGE_MULTI_PLANE;
+
 typedef struct
 {
     unsigned int cmdSelect;
@@ -449,5 +554,22 @@ void V2FStatusCheckAsync(T4REGS *t4regs, int way, unsigned int *statusReport);
 void V2FReadIdAsync(T4REGS *t4regs, int way, unsigned int *statusReport, unsigned int *completion);
 void V2FReadIdSync(T4REGS *t4regs, int way, unsigned int *statusReport);
 unsigned int V2FReadyBusyAsync(T4REGS *t4regs);
+void V2FSetReadRetryAsync(T4REGS *t4regs, int way, volatile unsigned int *payload);
+#if (V2F_SUSPEND_SUPPORTED)
+void V2FSuspendAsync(T4REGS *t4regs, int way);
+void V2FResumeAsync(T4REGS *t4regs, int way);
+#endif
+#if (V2F_MULTI_PLANE_SUPPORTED)
+void V2FReadPageTriggerMultiPlaneAsync(T4REGS *t4regs, int way, unsigned int rowAddress[]);
+void V2FProgramPageMultiPlaneAsync(T4REGS *t4regs, int way, unsigned int rowAddress[], void *pageDataBuffer[],
+                                   void *spareDataBuffer[]);
+void V2FEraseBlockMultiPlaneAsync(T4REGS *t4regs, int way, unsigned int rowAddress[]);
+#endif
+#if (V2F_CACHE_OPS_SUPPORTED)
+void V2FReadPageCacheAsync(T4REGS *t4regs, int way, unsigned int rowAddress, int sequential);
+void V2FReadPageCacheEndAsync(T4REGS *t4regs, int way);
+void V2FProgramPageCacheAsync(T4REGS *t4regs, int way, unsigned int rowAddress, void *pageDataBuffer,
+                              void *spareDataBuffer);
+#endif
 
 #endif /* FMC_DRIVER_H_ */
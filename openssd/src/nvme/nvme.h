@@ -84,6 +84,7 @@
 #define ADMIN_MONITOR_BUFFER  0xC1
 #define ADMIN_MONITOR_MAPPING 0xC3
 #define ADMIN_MONITOR_FLASH   0xC5
+#define ADMIN_MONITOR_SCHED   0xC7
 
 /* customized admin commands (>= 0xD0) for monitoring nmc utilities */
 
@@ -441,6 +442,22 @@ typedef struct _ADMIN_SET_FEATURES_NUMBER_OF_QUEUES_DW11
     };
 } ADMIN_SET_FEATURES_NUMBER_OF_QUEUES_DW11;
 
+typedef struct _ADMIN_SET_FEATURES_ARBITRATION_DW11
+{
+    union
+    {
+        unsigned int dword;
+        struct
+        {
+            unsigned char AB : 3; // Arbitration Burst, 2^AB commands, 0x7 for no limit
+            unsigned char reserved0 : 5;
+            unsigned char LPW; // Low Priority Weight, zero-based value
+            unsigned char MPW; // Medium Priority Weight, zero-based value
+            unsigned char HPW; // High Priority Weight, zero-based value
+        };
+    };
+} ADMIN_SET_FEATURES_ARBITRATION_DW11;
+
 /* Get Features Command */
 typedef struct _ADMIN_GET_FEATURES_DW10
 {
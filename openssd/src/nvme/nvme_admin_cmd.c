@@ -54,6 +54,7 @@
 #include "host_lld.h"
 #include "nvme_identify.h"
 #include "nvme_admin_cmd.h"
+#include "nvme_io_cmd.h"
 #include "ftl_config.h"
 #include "address_translation.h"
 
@@ -188,6 +189,7 @@ void handle_set_features(NVME_ADMIN_COMMAND *nvmeAdminCmd, NVME_COMPLETION *nvme
     }
     case ARBITRATION:
     {
+        set_nvme_io_arbitration(nvmeAdminCmd->dword11);
         nvmeCPL->dword[0] = 0x0;
         nvmeCPL->specific = 0x0;
         break;
@@ -218,6 +220,14 @@ void handle_set_features(NVME_ADMIN_COMMAND *nvmeAdminCmd, NVME_COMPLETION *nvme
         nvmeCPL->specific = 0x0;
         break;
     }
+    case VENDOR_IO_QOS:
+    {
+        nvmeCPL->dword[0]        = 0x0;
+        nvmeCPL->statusField.SC  = set_nvme_io_qos(nvmeAdminCmd->dword11, nvmeAdminCmd->dword12);
+        nvmeCPL->statusField.SCT = SCT_GENERIC_COMMAND_STATUS;
+        nvmeCPL->specific        = 0x0;
+        break;
+    }
     default:
     {
         xil_printf("Not Support FID (Set): %X\r\n", features.FID);
@@ -247,6 +257,12 @@ void handle_get_features(NVME_ADMIN_COMMAND *nvmeAdminCmd, NVME_COMPLETION *nvme
         nvmeCPL->specific  = 0x0;
         break;
     }
+    case ARBITRATION:
+    {
+        nvmeCPL->dword[0] = 0x0;
+        nvmeCPL->specific = nvmeIoArb.arbDword;
+        break;
+    }
     case TEMPERATURE_THRESHOLD:
     {
         nvmeCPL->dword[0] = 0x0;
@@ -279,6 +295,12 @@ void handle_get_features(NVME_ADMIN_COMMAND *nvmeAdminCmd, NVME_COMPLETION *nvme
         nvmeCPL->specific = 0x0;
         break;
     }
+    case VENDOR_IO_QOS:
+    {
+        nvmeCPL->dword[0] = 0x0;
+        nvmeCPL->specific = get_nvme_io_qos(nvmeAdminCmd->dword11);
+        break;
+    }
     default:
     {
         xil_printf("Not Support FID (Get): %X\r\n", features.FID);
@@ -317,6 +339,7 @@ void handle_create_io_sq(NVME_ADMIN_COMMAND *nvmeAdminCmd, NVME_COMPLETION *nvme
     ioSqStatus->cqVector      = sqInfo11.CQID;
     ioSqStatus->pcieBaseAddrL = nvmeAdminCmd->PRP1[0];
     ioSqStatus->pcieBaseAddrH = nvmeAdminCmd->PRP1[1];
+    set_nvme_io_sq_prio(ioSqIdx, sqInfo11.QPRIO);
 
     set_io_sq(ioSqIdx, ioSqStatus->valid, ioSqStatus->cqVector, ioSqStatus->qSzie, ioSqStatus->pcieBaseAddrL,
               ioSqStatus->pcieBaseAddrH);
@@ -590,6 +613,7 @@ void handle_nvme_admin_cmd(NVME_COMMAND *nvmeCmd)
         break;
     }
     case ADMIN_MONITOR_FLASH:
+    case ADMIN_MONITOR_SCHED:
     case ADMIN_MONITOR_BUFFER:
     case ADMIN_MONITOR_MAPPING:
     {
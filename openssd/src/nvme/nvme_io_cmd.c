@@ -76,13 +76,13 @@
 void handle_nvme_io_read(unsigned int cmdSlotTag, NVME_IO_COMMAND *nvmeIOCmd)
 {
     IO_READ_COMMAND_DW12 readInfo12;
-    // IO_READ_COMMAND_DW13 readInfo13;
+    IO_READ_COMMAND_DW13 readInfo13;
     // IO_READ_COMMAND_DW15 readInfo15;
     unsigned int startLba[2];
     unsigned int nlb;
 
     readInfo12.dword = nvmeIOCmd->dword[12];
-    // readInfo13.dword = nvmeIOCmd->dword[13];
+    readInfo13.dword = nvmeIOCmd->dword[13];
     // readInfo15.dword = nvmeIOCmd->dword[15];
 
     startLba[0] = nvmeIOCmd->dword[10];
@@ -100,7 +100,7 @@ void handle_nvme_io_read(unsigned int cmdSlotTag, NVME_IO_COMMAND *nvmeIOCmd)
     {
     case IO_NVM_READ_PHY:
     case IO_NVM_READ:
-        ReqTransNvmeToSlice(cmdSlotTag, startLba[0], nlb, nvmeIOCmd->OPC);
+        ReqTransNvmeToSlice(cmdSlotTag, startLba[0], nlb, nvmeIOCmd->OPC, readInfo13.DSM.SequentialRequest, 0);
         break;
 
     default:
@@ -115,18 +115,15 @@ void handle_nvme_io_read(unsigned int cmdSlotTag, NVME_IO_COMMAND *nvmeIOCmd)
 void handle_nvme_io_write(unsigned int cmdSlotTag, NVME_IO_COMMAND *nvmeIOCmd)
 {
     IO_READ_COMMAND_DW12 writeInfo12;
-    // IO_READ_COMMAND_DW13 writeInfo13;
+    IO_READ_COMMAND_DW13 writeInfo13;
     // IO_READ_COMMAND_DW15 writeInfo15;
     unsigned int startLba[2];
     unsigned int nlb;
 
     writeInfo12.dword = nvmeIOCmd->dword[12];
-    // writeInfo13.dword = nvmeIOCmd->dword[13];
+    writeInfo13.dword = nvmeIOCmd->dword[13];
     // writeInfo15.dword = nvmeIOCmd->dword[15];
 
-    // if(writeInfo12.FUA == 1)
-    //	xil_printf("write FUA\r\n");
-
     startLba[0] = nvmeIOCmd->dword[10];
     startLba[1] = nvmeIOCmd->dword[11];
     nlb         = writeInfo12.NLB;
@@ -146,7 +143,8 @@ void handle_nvme_io_write(unsigned int cmdSlotTag, NVME_IO_COMMAND *nvmeIOCmd)
     case IO_NVM_NMC_ALLOC:
     case IO_NVM_WRITE_PHY:
     case IO_NVM_WRITE:
-        ReqTransNvmeToSlice(cmdSlotTag, startLba[0], nlb, nvmeIOCmd->OPC);
+        ReqTransNvmeToSlice(cmdSlotTag, startLba[0], nlb, nvmeIOCmd->OPC, writeInfo13.DSM.SequentialRequest,
+                            writeInfo12.FUA);
         break;
 
     default:
@@ -272,3 +270,490 @@ void handle_nvme_io_cmd(NVME_COMMAND *nvmeCmd)
     }
     }
 }
+
+NVME_IO_CMD_PENDING_TABLE nvmeIoCmdPendingTable;
+NVME_IO_ARB nvmeIoArb;
+NVME_IO_ADMIT_STAT nvmeIoAdmitStat;
+
+static unsigned int sqCreditBlocked; // whether `admit_nvme_io_sq()` ran out of request credits
+
+/**
+ * @brief Check if the given NVMe command is a read command.
+ */
+#define NVME_IO_CMD_IS_READ(nvmeCmd)                                                                                  \
+    ((((NVME_IO_COMMAND *)(nvmeCmd)->cmdDword)->OPC == IO_NVM_READ) ||                                                \
+     (((NVME_IO_COMMAND *)(nvmeCmd)->cmdDword)->OPC == IO_NVM_READ_PHY))
+
+/**
+ * @brief Check if the given NVMe command is a write command with the FUA bit set.
+ */
+#define NVME_IO_CMD_IS_FUA_WRITE(nvmeCmd)                                                                             \
+    ((((NVME_IO_COMMAND *)(nvmeCmd)->cmdDword)->OPC == IO_NVM_WRITE) &&                                               \
+     (((IO_READ_COMMAND_DW12 *)&((NVME_IO_COMMAND *)(nvmeCmd)->cmdDword)->dword[12])->FUA))
+
+/**
+ * @brief Calculate how many slice requests the given I/O command will be split into.
+ *
+ * @sa `ReqTransNvmeToSlice()`.
+ *
+ * @param nvmeCmd the I/O command to be checked.
+ * @param blockCnt returns the number of NVMe blocks accessed by the command.
+ * @return unsigned int the number of slice requests, 1 for commands without data blocks.
+ */
+static unsigned int nvme_io_cmd_slice_count(NVME_COMMAND *nvmeCmd, unsigned int *blockCnt)
+{
+    NVME_IO_COMMAND *nvmeIOCmd;
+    IO_READ_COMMAND_DW12 info12;
+    unsigned int nvmeBlockOffset;
+
+    nvmeIOCmd = (NVME_IO_COMMAND *)nvmeCmd->cmdDword;
+
+    switch (nvmeIOCmd->OPC)
+    {
+    case IO_NVM_READ:
+    case IO_NVM_READ_PHY:
+    case IO_NVM_WRITE:
+    case IO_NVM_WRITE_PHY:
+    case IO_NVM_NMC_WRITE:
+    case IO_NVM_NMC_INFERENCE:
+    case IO_NVM_NMC_ALLOC:
+        info12.dword    = nvmeIOCmd->dword[12];
+        nvmeBlockOffset = nvmeIOCmd->dword[10] % NVME_BLOCKS_PER_SLICE;
+        *blockCnt       = info12.NLB + 1;
+        return (nvmeBlockOffset + *blockCnt + NVME_BLOCKS_PER_SLICE - 1) / NVME_BLOCKS_PER_SLICE;
+
+    default:
+        *blockCnt = 0;
+        return 1; // flush, NMC flush and monitor commands
+    }
+}
+
+/**
+ * @brief Reset the pending table and the arbitration states to the default values.
+ *
+ * By default, all the queues are in the urgent class, and the arbitration burst and the
+ * weights are set to 1 command, which is a plain round robin. The QoS of all the queues
+ * is disabled as well.
+ *
+ * @note The pending commands are discarded, this should only be called at start-up or
+ * after the host reset the controller.
+ */
+void init_nvme_io_arbitration()
+{
+    P_NVME_IO_CMD_PENDING_TABLE table = &nvmeIoCmdPendingTable;
+    unsigned int iCmd, sqIdx;
+
+    table->cmdCnt        = 0;
+    table->nextSeqNum    = 0;
+    table->oldestSeqNum  = 0;
+    table->oldestBlocked = 0;
+    table->bypassCnt     = 0;
+    table->freeCmd       = 0;
+    for (iCmd = 0; iCmd < NVME_IO_CMD_PENDING_MAX; iCmd++)
+        table->entry[iCmd].nextCmd = (iCmd + 1 < NVME_IO_CMD_PENDING_MAX) ? iCmd + 1 : NVME_IO_CMD_NONE;
+
+    for (sqIdx = 0; sqIdx < MAX_NUM_OF_IO_SQ; sqIdx++)
+    {
+        table->sq[sqIdx].headCmd = NVME_IO_CMD_NONE;
+        table->sq[sqIdx].tailCmd = NVME_IO_CMD_NONE;
+        table->sq[sqIdx].cmdCnt  = 0;
+        nvmeIoArb.sqPrio[sqIdx]  = NVME_IO_SQ_PRIO_URGENT;
+    }
+
+    set_nvme_io_arbitration(0);
+    init_nvme_io_qos();
+}
+
+/**
+ * @brief Apply the Arbitration feature (Set Features FID 0x01).
+ *
+ * @param arbDword the dword11 of the Set Features command.
+ */
+void set_nvme_io_arbitration(unsigned int arbDword)
+{
+    ADMIN_SET_FEATURES_ARBITRATION_DW11 arb;
+    unsigned int prio;
+
+    arb.dword = arbDword;
+
+    nvmeIoArb.arbDword                       = arbDword;
+    nvmeIoArb.burst                          = (arb.AB == NVME_IO_ARB_BURST_NO_LIMIT) ? 0 : (1 << arb.AB);
+    nvmeIoArb.weight[NVME_IO_SQ_PRIO_URGENT] = 0; // not weighted, always served first
+    nvmeIoArb.weight[NVME_IO_SQ_PRIO_HIGH]   = arb.HPW + 1;
+    nvmeIoArb.weight[NVME_IO_SQ_PRIO_MEDIUM] = arb.MPW + 1;
+    nvmeIoArb.weight[NVME_IO_SQ_PRIO_LOW]    = arb.LPW + 1;
+
+    for (prio = 0; prio < NVME_IO_SQ_PRIO_CLASSES; prio++)
+    {
+        nvmeIoArb.credit[prio] = nvmeIoArb.weight[prio];
+        nvmeIoArb.cursor[prio] = 0;
+    }
+
+    pr_info("NVMe arbitration: burst = %u, weights (H/M/L) = %u/%u/%u", nvmeIoArb.burst,
+            nvmeIoArb.weight[NVME_IO_SQ_PRIO_HIGH], nvmeIoArb.weight[NVME_IO_SQ_PRIO_MEDIUM],
+            nvmeIoArb.weight[NVME_IO_SQ_PRIO_LOW]);
+}
+
+/**
+ * @brief Set the priority class of the given I/O submission queue.
+ *
+ * @note `QPRIO` is ignored unless WRR is the arbitration mechanism (`NVME_CC_AMS`), and
+ * the queue is put into the urgent class to be served in plain round robin.
+ *
+ * @param sqIdx the zero-based index of the I/O submission queue (QID - 1).
+ * @param qPrio the `QPRIO` field of the CREATE_IO_SQ command.
+ */
+void set_nvme_io_sq_prio(unsigned int sqIdx, unsigned int qPrio)
+{
+    ASSERT(sqIdx < MAX_NUM_OF_IO_SQ && qPrio < NVME_IO_SQ_PRIO_CLASSES);
+
+    if (NVME_CC_AMS != NVME_CC_AMS_WRR)
+        qPrio = NVME_IO_SQ_PRIO_URGENT;
+
+    nvmeIoArb.sqPrio[sqIdx] = qPrio;
+}
+
+/**
+ * @brief Append a fetched I/O command to the pending list of its submission queue.
+ *
+ * @warning The caller must make sure the table is not full (`NVME_IO_CMD_PENDING_FULL()`).
+ *
+ * @param nvmeCmd the fetched I/O command.
+ */
+void defer_nvme_io_cmd(NVME_COMMAND *nvmeCmd)
+{
+    P_NVME_IO_CMD_PENDING_TABLE table = &nvmeIoCmdPendingTable;
+    P_NVME_IO_SQ_PENDING_LIST sqList;
+    P_NVME_IO_CMD_PENDING_ENTRY entry;
+    unsigned int iCmd;
+
+    ASSERT(table->freeCmd != NVME_IO_CMD_NONE, "pending I/O command table overflow");
+    ASSERT(0 < nvmeCmd->qID && nvmeCmd->qID <= MAX_NUM_OF_IO_SQ, "Unexpected qID: %u", nvmeCmd->qID);
+
+    iCmd           = table->freeCmd;
+    entry          = &table->entry[iCmd];
+    table->freeCmd = entry->nextCmd;
+
+    entry->cmd        = *nvmeCmd;
+    entry->seqNum     = table->nextSeqNum++;
+    entry->sliceCnt   = nvme_io_cmd_slice_count(nvmeCmd, &entry->blockCnt);
+    entry->creditCnt  = entry->sliceCnt *
+                       (NVME_IO_CMD_IS_FUA_WRITE(nvmeCmd) ? REQ_CREDITS_PER_FUA_SLICE : REQ_CREDITS_PER_SLICE);
+    entry->waitRounds = 0;
+    entry->nextCmd    = NVME_IO_CMD_NONE;
+    XTime_GetTime(&entry->fetchTick);
+
+    sqList = &table->sq[nvmeCmd->qID - 1];
+    if (sqList->tailCmd != NVME_IO_CMD_NONE)
+        table->entry[sqList->tailCmd].nextCmd = iCmd;
+    else
+        sqList->headCmd = iCmd;
+    sqList->tailCmd = iCmd;
+    sqList->cmdCnt++;
+
+    if (++table->cmdCnt > nvmeIoAdmitStat.maxPendingCnt)
+        nvmeIoAdmitStat.maxPendingCnt = table->cmdCnt;
+}
+
+/**
+ * @brief Hand the specified pending command to the FTL and release its table entry.
+ *
+ * The request credits of the command must have been reserved by `ReserveReqCredits()`.
+ *
+ * @param sqIdx the queue of the command.
+ * @param prevCmd the previous pending command in the same queue, or `NVME_IO_CMD_NONE`.
+ * @param iCmd the index of the command in the pending table.
+ */
+static void admit_nvme_io_cmd(unsigned int sqIdx, unsigned int prevCmd, unsigned int iCmd)
+{
+    P_NVME_IO_CMD_PENDING_TABLE table = &nvmeIoCmdPendingTable;
+    P_NVME_IO_SQ_PENDING_LIST sqList  = &table->sq[sqIdx];
+    P_NVME_IO_CMD_PENDING_ENTRY entry = &table->entry[iCmd];
+    P_NVME_IO_SQ_STAT sqStat          = &nvmeIoAdmitStat.sq[sqIdx];
+
+    if (NVME_IO_CMD_IS_READ(&entry->cmd))
+    {
+        nvmeIoAdmitStat.readWaitRounds += entry->waitRounds;
+        if (entry->waitRounds > nvmeIoAdmitStat.maxReadWaitRounds)
+            nvmeIoAdmitStat.maxReadWaitRounds = entry->waitRounds;
+    }
+
+    sqStat->admittedCnt++;
+    sqStat->admittedSlices += entry->sliceCnt;
+    sqStat->waitRounds += entry->waitRounds;
+    if (entry->waitRounds > sqStat->maxWaitRounds)
+        sqStat->maxWaitRounds = entry->waitRounds;
+    nvmeIoAdmitStat.admittedCnt++;
+    charge_nvme_io_qos(sqIdx, entry->blockCnt, entry->fetchTick);
+
+    handle_nvme_io_cmd(&entry->cmd);
+    ReleaseReqCredits();
+
+    // unlink from the queue and put back to the free entries
+    if (prevCmd != NVME_IO_CMD_NONE)
+        table->entry[prevCmd].nextCmd = entry->nextCmd;
+    else
+        sqList->headCmd = entry->nextCmd;
+    if (sqList->tailCmd == iCmd)
+        sqList->tailCmd = prevCmd;
+    sqList->cmdCnt--;
+
+    entry->nextCmd = table->freeCmd;
+    table->freeCmd = iCmd;
+    table->cmdCnt--;
+}
+
+/**
+ * @brief Admit up to `budget` pending commands of the given submission queue.
+ *
+ * The pending commands are checked from the oldest one. A command that cannot get enough
+ * request credits stays in the table without blocking the main loop, and only reads are
+ * allowed to be admitted ahead of it, so the order of writes and the other commands of
+ * the same queue is preserved.
+ *
+ * The queue stops being served as soon as one of its QoS limits runs out of tokens.
+ *
+ * @param sqIdx the queue to be served.
+ * @param budget the maximum number of commands to be admitted.
+ * @return unsigned int the number of admitted commands.
+ */
+static unsigned int admit_nvme_io_sq(unsigned int sqIdx, unsigned int budget)
+{
+    P_NVME_IO_CMD_PENDING_TABLE table = &nvmeIoCmdPendingTable;
+    P_NVME_IO_CMD_PENDING_ENTRY entry;
+    unsigned int iCmd, prevCmd, nextCmd, isRead, blocked, admittedCnt;
+
+    prevCmd     = NVME_IO_CMD_NONE;
+    blocked     = 0;
+    admittedCnt = 0;
+    for (iCmd = table->sq[sqIdx].headCmd; iCmd != NVME_IO_CMD_NONE && admittedCnt < budget; iCmd = nextCmd)
+    {
+        if (!check_nvme_io_qos_limit(sqIdx))
+        {
+            nvmeIoQos.sq[sqIdx].throttledCnt++;
+            break;
+        }
+
+        entry   = &table->entry[iCmd];
+        nextCmd = entry->nextCmd;
+        isRead  = NVME_IO_CMD_IS_READ(&entry->cmd);
+
+        // some older command of this queue is still waiting, only reads can bypass it
+        if (blocked && !isRead)
+        {
+            prevCmd = iCmd;
+            continue;
+        }
+
+        if (!ReserveReqCredits(entry->creditCnt))
+        {
+            if (entry->seqNum == table->oldestSeqNum)
+                table->oldestBlocked = 1;
+
+            sqCreditBlocked = 1;
+            blocked         = 1;
+            prevCmd         = iCmd;
+            continue;
+        }
+
+        if (blocked)
+            nvmeIoAdmitStat.bypassCnt++;
+
+        admit_nvme_io_cmd(sqIdx, prevCmd, iCmd);
+        admittedCnt++;
+    }
+
+    return admittedCnt;
+}
+
+/**
+ * @brief Serve the queues of the given priority class in round robin.
+ *
+ * Each queue of this class can admit up to `NVME_IO_ARB::burst` commands in its turn, and
+ * the queue served first is rotated in each call.
+ *
+ * @param prio the priority class to be served.
+ * @param budget the maximum number of commands to be admitted from this class.
+ * @return unsigned int the number of admitted commands.
+ */
+static unsigned int admit_nvme_io_class(unsigned int prio, unsigned int budget)
+{
+    unsigned int iSq, sqIdx, limit, admittedCnt;
+
+    admittedCnt = 0;
+    for (iSq = 0; iSq < MAX_NUM_OF_IO_SQ && admittedCnt < budget; iSq++)
+    {
+        sqIdx = (nvmeIoArb.cursor[prio] + iSq) % MAX_NUM_OF_IO_SQ;
+        if (nvmeIoArb.sqPrio[sqIdx] != prio || nvmeIoCmdPendingTable.sq[sqIdx].cmdCnt == 0)
+            continue;
+
+        limit = budget - admittedCnt;
+        if (nvmeIoArb.burst && nvmeIoArb.burst < limit)
+            limit = nvmeIoArb.burst;
+
+        admittedCnt += admit_nvme_io_sq(sqIdx, limit);
+    }
+
+    nvmeIoArb.cursor[prio] = (nvmeIoArb.cursor[prio] + 1) % MAX_NUM_OF_IO_SQ;
+
+    return admittedCnt;
+}
+
+/**
+ * @brief Start a new WRR round if every weighted class with pending commands ran out.
+ *
+ * @return unsigned int 1 if the credits were refilled, otherwise 0.
+ */
+static unsigned int refill_nvme_io_arb_credits()
+{
+    unsigned int prio, sqIdx, pending;
+
+    pending = 0;
+    for (sqIdx = 0; sqIdx < MAX_NUM_OF_IO_SQ; sqIdx++)
+    {
+        prio = nvmeIoArb.sqPrio[sqIdx];
+        if (prio == NVME_IO_SQ_PRIO_URGENT || nvmeIoCmdPendingTable.sq[sqIdx].cmdCnt == 0)
+            continue;
+
+        // this class still has credits but its commands cannot be admitted now
+        if (nvmeIoArb.credit[prio])
+            return 0;
+
+        pending = 1;
+    }
+
+    if (!pending)
+        return 0;
+
+    for (prio = NVME_IO_SQ_PRIO_HIGH; prio < NVME_IO_SQ_PRIO_CLASSES; prio++)
+        nvmeIoArb.credit[prio] = nvmeIoArb.weight[prio];
+
+    return 1;
+}
+
+/**
+ * @brief Find the oldest pending command and update its bypass counter.
+ *
+ * @param admittedCnt the number of commands admitted in the last round.
+ * @return unsigned int the queue of the oldest pending command.
+ */
+static unsigned int track_oldest_nvme_io_cmd(unsigned int admittedCnt)
+{
+    P_NVME_IO_CMD_PENDING_TABLE table = &nvmeIoCmdPendingTable;
+    unsigned int sqIdx, oldestSq, headCmd;
+
+    oldestSq = MAX_NUM_OF_IO_SQ;
+    for (sqIdx = 0; sqIdx < MAX_NUM_OF_IO_SQ; sqIdx++)
+    {
+        headCmd = table->sq[sqIdx].headCmd;
+        if (headCmd == NVME_IO_CMD_NONE)
+            continue;
+
+        // the head of each queue is the oldest command of the queue
+        if (oldestSq == MAX_NUM_OF_IO_SQ ||
+            (int)(table->entry[headCmd].seqNum - table->entry[table->sq[oldestSq].headCmd].seqNum) < 0)
+            oldestSq = sqIdx;
+    }
+
+    if (oldestSq == MAX_NUM_OF_IO_SQ)
+    {
+        table->bypassCnt = 0;
+        return oldestSq;
+    }
+
+    headCmd = table->sq[oldestSq].headCmd;
+    if (table->entry[headCmd].seqNum != table->oldestSeqNum)
+    {
+        table->oldestSeqNum = table->entry[headCmd].seqNum;
+        table->bypassCnt    = 0;
+    }
+    else if (table->oldestBlocked)
+        table->bypassCnt += admittedCnt;
+
+    table->oldestBlocked = 0;
+
+    return oldestSq;
+}
+
+/**
+ * @brief Admit the pending I/O commands by the NVMe arbitration policy.
+ *
+ * The queues below their reserved rates are served first, then the urgent queues, and then
+ * the high, medium and low classes are served by weighted round robin. Only the commands
+ * whose request credits are available and whose queues are within their QoS limits can be
+ * admitted (check `ReserveReqCredits()` and `check_nvme_io_qos_limit()`).
+ *
+ * If a queue below its reservation cannot get enough request credits, the other queues
+ * are not served in this round, so that the freed request entries are left to it.
+ *
+ * @sa `NVME_IO_CMD_MAX_BYPASS`.
+ *
+ * @return unsigned int the number of admitted commands.
+ */
+unsigned int admit_nvme_io_cmds()
+{
+    P_NVME_IO_CMD_PENDING_TABLE table = &nvmeIoCmdPendingTable;
+    unsigned int prio, sqIdx, iCmd, oldestSq, admittedCnt, cnt, classCnt, reservedBlocked;
+
+    refill_nvme_io_qos();
+
+    admittedCnt     = 0;
+    reservedBlocked = 0;
+    oldestSq        = track_oldest_nvme_io_cmd(0);
+
+    if (table->bypassCnt >= NVME_IO_CMD_MAX_BYPASS)
+    {
+        // the oldest command is starving, wait until it can be admitted
+        if (ReserveReqCredits(table->entry[table->sq[oldestSq].headCmd].creditCnt))
+        {
+            admit_nvme_io_cmd(oldestSq, NVME_IO_CMD_NONE, table->sq[oldestSq].headCmd);
+            admittedCnt++;
+        }
+    }
+    else
+    {
+        for (sqIdx = 0; sqIdx < MAX_NUM_OF_IO_SQ; sqIdx++)
+            while (table->sq[sqIdx].cmdCnt && check_nvme_io_qos_reserved(sqIdx))
+            {
+                sqCreditBlocked = 0;
+                if (!admit_nvme_io_sq(sqIdx, 1))
+                {
+                    reservedBlocked |= sqCreditBlocked;
+                    break;
+                }
+
+                nvmeIoQos.sq[sqIdx].reservedCnt++;
+                admittedCnt++;
+            }
+    }
+
+    if (table->bypassCnt < NVME_IO_CMD_MAX_BYPASS && !reservedBlocked)
+    {
+        admittedCnt += admit_nvme_io_class(NVME_IO_SQ_PRIO_URGENT, NVME_IO_CMD_PENDING_MAX);
+
+        do
+        {
+            cnt = 0;
+            for (prio = NVME_IO_SQ_PRIO_HIGH; prio < NVME_IO_SQ_PRIO_CLASSES; prio++)
+            {
+                if (nvmeIoArb.credit[prio] == 0)
+                    continue;
+
+                classCnt = admit_nvme_io_class(prio, nvmeIoArb.credit[prio]);
+                nvmeIoArb.credit[prio] -= classCnt;
+                cnt += classCnt;
+            }
+            admittedCnt += cnt;
+        } while (cnt || refill_nvme_io_arb_credits());
+    }
+
+    track_oldest_nvme_io_cmd(admittedCnt);
+
+    // the remaining commands have to wait for another round
+    for (sqIdx = 0; sqIdx < MAX_NUM_OF_IO_SQ; sqIdx++)
+        for (iCmd = table->sq[sqIdx].headCmd; iCmd != NVME_IO_CMD_NONE; iCmd = table->entry[iCmd].nextCmd)
+            if (table->entry[iCmd].waitRounds++ == 0)
+                nvmeIoAdmitStat.deferredCnt++;
+
+    return admittedCnt;
+}
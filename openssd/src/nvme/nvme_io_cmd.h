@@ -47,6 +47,160 @@
 #ifndef __NVME_IO_CMD_H_
 #define __NVME_IO_CMD_H_
 
+#include "nvme_qos.h"
+
+/**
+ * @brief The capacity of the pending I/O command table.
+ *
+ * The fetched I/O commands are admitted only if the request pool can hold all of their
+ * slice requests (check `ReserveReqCredits()`), otherwise they wait in the pending table
+ * and the main loop keeps running the back-end instead of spinning in `SyncAvailFreeReq()`.
+ *
+ * The table is shared by all the I/O submission queues, each of them has its own pending
+ * list so that the admission can pick commands by the arbitration policy.
+ */
+#define NVME_IO_CMD_PENDING_MAX 64
+#define NVME_IO_CMD_NONE        0xff // no pending command, used for the tail of lists
+
+/**
+ * @brief How many times the oldest pending command can be bypassed by younger commands.
+ *
+ * When the oldest pending command cannot get enough request credits, younger commands
+ * (reads of the same queue, or commands of other queues) are still admitted. But once
+ * it has been bypassed this many times, only the oldest command is considered until it
+ * is admitted, so that it won't be starved.
+ */
+#define NVME_IO_CMD_MAX_BYPASS 64
+
+/**
+ * @brief The priority classes of I/O submission queues, the `QPRIO` of CREATE_IO_SQ.
+ *
+ * The commands of urgent queues are admitted before the others, and the high, medium
+ * and low classes share the remaining admissions by weighted round robin.
+ *
+ * @note `QPRIO` is only meaningful when the host selected WRR in `CC.AMS`, some hosts set
+ * it anyway, so it is ignored under round robin and all queues fall into the urgent class.
+ */
+#define NVME_IO_SQ_PRIO_URGENT  0
+#define NVME_IO_SQ_PRIO_HIGH    1
+#define NVME_IO_SQ_PRIO_MEDIUM  2
+#define NVME_IO_SQ_PRIO_LOW     3
+#define NVME_IO_SQ_PRIO_CLASSES 4
+
+#define NVME_IO_ARB_BURST_NO_LIMIT 0x7 // the `AB` value of no arbitration burst limit
+
+/**
+ * @brief The arbitration mechanism selected by the host (`CC.AMS`).
+ *
+ * The controller IP handles `CAP` and `CC` by itself and only exposes `CC.EN` and `CC.SHN`
+ * to the firmware (check `NVME_STATUS_REG`), so the mechanism the host may select is fixed
+ * here. Only change it to WRR for a controller IP that advertises WRR in `CAP.AMS`.
+ */
+#define NVME_CC_AMS_RR  0x0 // round robin
+#define NVME_CC_AMS_WRR 0x1 // weighted round robin with urgent priority class
+#define NVME_CC_AMS     NVME_CC_AMS_RR
+
+typedef struct _NVME_IO_CMD_PENDING_ENTRY
+{
+    NVME_COMMAND cmd;
+    XTime fetchTick;           // the time this command was fetched
+    unsigned int seqNum;       // the fetching order of this command
+    unsigned int sliceCnt;     // the number of slice requests to be created
+    unsigned int creditCnt;    // the request credits to be reserved at admission
+    unsigned int blockCnt;     // the number of NVMe blocks accessed by this command
+    unsigned short waitRounds; // the admission rounds this command has waited
+    unsigned char nextCmd;     // the next pending command of the same queue, or free entry
+    unsigned char reserved0;
+} NVME_IO_CMD_PENDING_ENTRY, *P_NVME_IO_CMD_PENDING_ENTRY;
+
+typedef struct _NVME_IO_SQ_PENDING_LIST
+{
+    unsigned char headCmd;
+    unsigned char tailCmd;
+    unsigned short cmdCnt;
+} NVME_IO_SQ_PENDING_LIST, *P_NVME_IO_SQ_PENDING_LIST;
+
+/**
+ * @brief The pending I/O commands, linked into per-SQ lists ordered by fetching time.
+ */
+typedef struct _NVME_IO_CMD_PENDING_TABLE
+{
+    unsigned int cmdCnt;        // the number of pending commands
+    unsigned int nextSeqNum;    // the sequence number of the next fetched command
+    unsigned int oldestSeqNum;  // the sequence number of the oldest pending command
+    unsigned int oldestBlocked; // whether the oldest command failed to get credits in this round
+    unsigned int bypassCnt;     // the times the oldest command was bypassed while being blocked
+    unsigned char freeCmd;      // the head of free entries
+    NVME_IO_SQ_PENDING_LIST sq[MAX_NUM_OF_IO_SQ];
+    NVME_IO_CMD_PENDING_ENTRY entry[NVME_IO_CMD_PENDING_MAX];
+} NVME_IO_CMD_PENDING_TABLE, *P_NVME_IO_CMD_PENDING_TABLE;
+
+/**
+ * @brief The arbitration states of the I/O submission queues.
+ *
+ * The weights and the arbitration burst are set by the Arbitration feature (Set Features
+ * FID 0x01), and the priority class of each queue is set when it is created.
+ */
+typedef struct _NVME_IO_ARB
+{
+    unsigned int arbDword;                        // the raw Arbitration feature value
+    unsigned int burst;                           // the commands admitted from a queue per turn
+    unsigned int weight[NVME_IO_SQ_PRIO_CLASSES]; // the commands admitted from a class per WRR round
+    unsigned int credit[NVME_IO_SQ_PRIO_CLASSES]; // the remaining commands of the current WRR round
+    unsigned int cursor[NVME_IO_SQ_PRIO_CLASSES]; // the queue to be served first in each class
+    unsigned char sqPrio[MAX_NUM_OF_IO_SQ];       // the priority class of each queue
+} NVME_IO_ARB, *P_NVME_IO_ARB;
+
+/**
+ * @brief The admission statistics of a single I/O submission queue.
+ *
+ * The shares of admitted commands and slices show the throughput share of each queue,
+ * and the waiting rounds show the admission latency added by the arbitration.
+ */
+typedef struct _NVME_IO_SQ_STAT
+{
+    unsigned int admittedCnt;
+    unsigned int admittedSlices;
+    unsigned int waitRounds;
+    unsigned int maxWaitRounds;
+} NVME_IO_SQ_STAT, *P_NVME_IO_SQ_STAT;
+
+/**
+ * @brief The statistics of the I/O command admission.
+ *
+ * - admittedCnt: I/O commands handed to the FTL
+ * - deferredCnt: I/O commands that could not be admitted in the round they were fetched
+ * - bypassCnt: reads admitted ahead of older pending commands of the same queue
+ * - maxPendingCnt: the peak number of pending commands
+ * - readWaitRounds / maxReadWaitRounds: the admission rounds spent waiting by reads
+ */
+typedef struct _NVME_IO_ADMIT_STAT
+{
+    unsigned int admittedCnt;
+    unsigned int deferredCnt;
+    unsigned int bypassCnt;
+    unsigned int maxPendingCnt;
+    unsigned int readWaitRounds;
+    unsigned int maxReadWaitRounds;
+    NVME_IO_SQ_STAT sq[MAX_NUM_OF_IO_SQ];
+} NVME_IO_ADMIT_STAT, *P_NVME_IO_ADMIT_STAT;
+
+/**
+ * @brief Check if the pending I/O command table has no room for newly fetched commands.
+ */
+#define NVME_IO_CMD_PENDING_FULL() (nvmeIoCmdPendingTable.cmdCnt == NVME_IO_CMD_PENDING_MAX)
+
 void handle_nvme_io_cmd(NVME_COMMAND *nvmeCmd);
 
+void init_nvme_io_arbitration();
+void set_nvme_io_arbitration(unsigned int arbDword);
+void set_nvme_io_sq_prio(unsigned int sqIdx, unsigned int qPrio);
+
+void defer_nvme_io_cmd(NVME_COMMAND *nvmeCmd);
+unsigned int admit_nvme_io_cmds();
+
+extern NVME_IO_CMD_PENDING_TABLE nvmeIoCmdPendingTable;
+extern NVME_IO_ARB nvmeIoArb;
+extern NVME_IO_ADMIT_STAT nvmeIoAdmitStat;
+
 #endif //__NVME_IO_CMD_H_
@@ -72,14 +72,32 @@
 
 volatile NVME_CONTEXT g_nvmeTask;
 
+/**
+ * @brief Decide how many NVMe commands can be fetched in this iteration.
+ *
+ * @return unsigned int The batch size, between 1 and `NVME_CMD_BATCH_MAX`.
+ */
+static unsigned int nvme_cmd_batch_size()
+{
+    unsigned int batchSize = freeReqQ.reqCnt / NVME_CMD_BATCH_REQ_RESERVE;
+
+    if (batchSize > NVME_CMD_BATCH_MAX)
+        return NVME_CMD_BATCH_MAX;
+
+    return batchSize ? batchSize : 1;
+}
+
 void nvme_main()
 {
-    unsigned int exeLlr;
     unsigned int rstCnt = 0;
 
     xil_printf("!!! Wait until FTL reset complete !!! \r\n");
 
     InitFTL();
+#if (NAND_DUAL_CORE)
+    StartNandCore();
+#endif
+    init_nvme_io_arbitration();
 
     xil_printf("\r\nFTL reset complete!!! \r\n");
     xil_printf("Turn on the host PC \r\n");
@@ -94,8 +112,6 @@ void nvme_main()
      */
     while (1)
     {
-        exeLlr = 1;
-
         if (g_nvmeTask.status == NVME_TASK_WAIT_CC_EN)
         {
             unsigned int ccEn;
@@ -111,9 +127,7 @@ void nvme_main()
         else if (g_nvmeTask.status == NVME_TASK_RUNNING)
         {
             NVME_COMMAND nvmeCmd;
-            unsigned int cmdValid;
-
-            cmdValid = get_nvme_cmd(&nvmeCmd.qID, &nvmeCmd.cmdSlotTag, &nvmeCmd.cmdSeqNum, nvmeCmd.cmdDword);
+            unsigned int cmdValid, cmdCnt, batchSize;
 
             /**
              *  Interpret NVMe commands received from host.
@@ -127,9 +141,19 @@ void nvme_main()
              * - If it's I/O (NVM) command:
              *
              * 		Forward to the NVM Command Manager (FTL).
+             *
+             *  Up to `batchSize` commands are drained from the command FIFO. The I/O commands
+             *  are not split immediately, they are put into the pending table and admitted
+             *  only if the request pool can hold all of their requests, so the main loop will
+             *  never spin in `SyncAvailFreeReq()` for a command that doesn't fit.
              */
-            if (cmdValid == 1)
+            batchSize = nvme_cmd_batch_size();
+            for (cmdCnt = 0; cmdCnt < batchSize && !NVME_IO_CMD_PENDING_FULL(); cmdCnt++)
             {
+                cmdValid = get_nvme_cmd(&nvmeCmd.qID, &nvmeCmd.cmdSlotTag, &nvmeCmd.cmdSeqNum, nvmeCmd.cmdDword);
+                if (cmdValid != 1)
+                    break;
+
                 rstCnt = 0;
                 if (nvmeCmd.qID == 0)
                 {
@@ -137,11 +161,21 @@ void nvme_main()
                 }
                 else
                 {
-                    handle_nvme_io_cmd(&nvmeCmd);
-                    ReqTransSliceToLowLevel();
-                    exeLlr = 0;
+                    defer_nvme_io_cmd(&nvmeCmd);
                 }
             }
+
+            // the slice requests of the admitted commands are translated in one go
+            if (nvmeIoCmdPendingTable.cmdCnt && admit_nvme_io_cmds())
+                ReqTransSliceToLowLevel();
+
+#if (NAND_ECC_REFRESH || READ_DISTURB_REFRESH || GROWN_BAD_BLOCK_SALVAGE)
+            // relocate the grown bad blocks and the blocks running out of ECC margin or read too many times
+            RefreshQueuedBlock();
+#endif
+#if (GROWN_BAD_BLOCK_SALVAGE)
+            UpdateBadBlockTableLazily();
+#endif
         }
         else if (g_nvmeTask.status == NVME_TASK_SHUTDOWN)
         {
@@ -201,6 +235,9 @@ void nvme_main()
             else
                 rstCnt++;
 
+            // the pending commands were discarded by the host along with the queues
+            init_nvme_io_arbitration();
+
             g_nvmeTask.cacheEn = 0;
             set_nvme_admin_queue(0, 0, 0);
             set_nvme_csts_shst(0);
@@ -218,8 +255,10 @@ void nvme_main()
          *
          * As described in the paper, Host DMA operations have the highest priority, so
          * we should call the `CheckDoneNvmeDmaReq` first, then `SchedulingNandReq`.
+         *
+         * The back-end stages run once after each batch of NVMe commands.
          */
-        if (exeLlr && ((nvmeDmaReqQ.headReq != REQ_SLOT_TAG_NONE) || notCompletedNandReqCnt || blockedReqCnt))
+        if ((nvmeDmaReqQ.headReq != REQ_SLOT_TAG_NONE) || notCompletedNandReqCnt || blockedReqCnt)
         {
             CheckDoneNvmeDmaReq();
             if (nvmeDmaReqQ.headReq == REQ_SLOT_TAG_NONE) // wait until DMA finished
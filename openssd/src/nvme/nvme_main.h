@@ -47,6 +47,16 @@
 #ifndef __NVME_MAIN_H_
 #define __NVME_MAIN_H_
 
+/**
+ * @brief The number of NVMe commands fetched in one iteration of the main loop.
+ *
+ * The fetched commands are split into slice requests in one go, and then the back-end
+ * stages are executed once. To avoid exhausting the request pool, the batch size shrinks
+ * to `freeReqQ.reqCnt / NVME_CMD_BATCH_REQ_RESERVE` (at least 1) under pool pressure.
+ */
+#define NVME_CMD_BATCH_MAX         16
+#define NVME_CMD_BATCH_REQ_RESERVE 32 // free request entries reserved for each fetched command
+
 void nvme_main();
 
 #endif //__NVME_MAIN_H_
@@ -0,0 +1,240 @@
+//////////////////////////////////////////////////////////////////////////////////
+// nvme_qos.c for Cosmos+ OpenSSD
+//
+// This file is part of Cosmos+ OpenSSD.
+//
+// Cosmos+ OpenSSD is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3, or (at your option)
+// any later version.
+//
+// Cosmos+ OpenSSD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Cosmos+ OpenSSD; see the file COPYING.
+// If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+// Project Name: Cosmos+ OpenSSD
+// Design Name: Cosmos+ Firmware
+// Module Name: NVMe I/O QoS
+// File Name: nvme_qos.c
+//
+// Version: v1.0.0
+//
+// Description:
+//   - throttles and reserves the admission of I/O commands per submission queue
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+// Revision History:
+//
+// * v1.0.0
+//   - First draft
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "xil_printf.h"
+#include "debug.h"
+#include "xtime_l.h"
+
+#include "nvme.h"
+#include "nvme_qos.h"
+
+#include "../ftl_config.h"
+
+NVME_IO_QOS nvmeIoQos;
+
+/**
+ * @brief Reset the given token bucket to a full bucket of the new rate.
+ *
+ * @param bucket the token bucket to be reset.
+ * @param rate the new rate in tokens per second, 0 for disabling this bucket.
+ */
+static void reset_nvme_io_qos_bucket(P_NVME_IO_QOS_BUCKET bucket, unsigned int rate)
+{
+    bucket->rate  = rate;
+    bucket->depth = (long long)rate * COUNTS_PER_SECOND / 1000 * NVME_IO_QOS_BUCKET_DEPTH_MS;
+
+    // the bucket should hold at least one token
+    if (rate && bucket->depth < COUNTS_PER_SECOND)
+        bucket->depth = COUNTS_PER_SECOND;
+
+    bucket->tokens = bucket->depth;
+}
+
+/**
+ * @brief Disable the QoS of all the I/O submission queues and clear the statistics.
+ */
+void init_nvme_io_qos()
+{
+    unsigned int sqIdx, attr, iBucket;
+
+    for (sqIdx = 0; sqIdx < MAX_NUM_OF_IO_SQ; sqIdx++)
+    {
+        for (attr = 0; attr < NVME_IO_QOS_ATTRS; attr++)
+            reset_nvme_io_qos_bucket(&nvmeIoQos.sq[sqIdx].bucket[attr], 0);
+
+        nvmeIoQos.sq[sqIdx].throttledCnt = 0;
+        nvmeIoQos.sq[sqIdx].reservedCnt  = 0;
+        nvmeIoQos.sq[sqIdx].admittedKiB  = 0;
+        for (iBucket = 0; iBucket < NVME_IO_QOS_WAIT_BUCKETS; iBucket++)
+            nvmeIoQos.sq[sqIdx].admitWaitHist[iBucket] = 0;
+    }
+
+    XTime_GetTime(&nvmeIoQos.lastTick);
+    nvmeIoQos.statStartTick = nvmeIoQos.lastTick;
+}
+
+/**
+ * @brief Handle the vendor specific Set Features command of I/O QoS.
+ *
+ * @param dword11 the dword11 of the Set Features command, check `VENDOR_IO_QOS`.
+ * @param value the new value of the specified attribute.
+ * @return unsigned int the status code of the completion entry.
+ */
+unsigned int set_nvme_io_qos(unsigned int dword11, unsigned int value)
+{
+    ADMIN_SET_FEATURES_IO_QOS_DW11 qos;
+
+    qos.dword = dword11;
+    if (qos.QID == 0 || qos.QID > MAX_NUM_OF_IO_SQ || qos.ATTR >= NVME_IO_QOS_ATTRS)
+    {
+        pr_warn("Invalid I/O QoS setting: QID = %u, ATTR = %u", qos.QID, qos.ATTR);
+        return SC_INVALID_FIELD_IN_COMMAND;
+    }
+
+    reset_nvme_io_qos_bucket(&nvmeIoQos.sq[qos.QID - 1].bucket[qos.ATTR], value);
+    pr_info("SQ[%u] I/O QoS attribute %u set to %u", qos.QID, qos.ATTR, value);
+
+    return SC_SUCCESSFUL_COMPLETION;
+}
+
+/**
+ * @brief Handle the vendor specific Get Features command of I/O QoS.
+ *
+ * @param dword11 the dword11 of the Get Features command, check `VENDOR_IO_QOS`.
+ * @return unsigned int the value of the specified attribute, 0 for invalid fields.
+ */
+unsigned int get_nvme_io_qos(unsigned int dword11)
+{
+    ADMIN_SET_FEATURES_IO_QOS_DW11 qos;
+
+    qos.dword = dword11;
+    if (qos.QID == 0 || qos.QID > MAX_NUM_OF_IO_SQ || qos.ATTR >= NVME_IO_QOS_ATTRS)
+        return 0;
+
+    return nvmeIoQos.sq[qos.QID - 1].bucket[qos.ATTR].rate;
+}
+
+/**
+ * @brief Refill the token buckets of all queues by the time elapsed since the last refill.
+ *
+ * @note This should be called once before each admission round.
+ */
+void refill_nvme_io_qos()
+{
+    P_NVME_IO_QOS_BUCKET bucket;
+    XTime now, elapsed;
+    unsigned int sqIdx, attr;
+
+    XTime_GetTime(&now);
+    elapsed            = now - nvmeIoQos.lastTick;
+    nvmeIoQos.lastTick = now;
+
+    // a full second is enough to fill any bucket, avoid overflow after a long idle time
+    if (elapsed > COUNTS_PER_SECOND)
+        elapsed = COUNTS_PER_SECOND;
+
+    for (sqIdx = 0; sqIdx < MAX_NUM_OF_IO_SQ; sqIdx++)
+        for (attr = 0; attr < NVME_IO_QOS_ATTRS; attr++)
+        {
+            bucket = &nvmeIoQos.sq[sqIdx].bucket[attr];
+            if (bucket->rate == 0)
+                continue;
+
+            bucket->tokens += (long long)elapsed * bucket->rate;
+            if (bucket->tokens > bucket->depth)
+                bucket->tokens = bucket->depth;
+        }
+}
+
+/**
+ * @brief Check if the given queue is allowed to admit one more command by its limits.
+ *
+ * @param sqIdx the zero-based index of the I/O submission queue.
+ * @return unsigned int 1 if none of the limit buckets is in debt, otherwise 0.
+ */
+unsigned int check_nvme_io_qos_limit(unsigned int sqIdx)
+{
+    P_NVME_IO_SQ_QOS sqQos = &nvmeIoQos.sq[sqIdx];
+
+    if (sqQos->bucket[NVME_IO_QOS_ATTR_IOPS_LIMIT].rate && sqQos->bucket[NVME_IO_QOS_ATTR_IOPS_LIMIT].tokens < 0)
+        return 0;
+    if (sqQos->bucket[NVME_IO_QOS_ATTR_BW_LIMIT].rate && sqQos->bucket[NVME_IO_QOS_ATTR_BW_LIMIT].tokens < 0)
+        return 0;
+
+    return 1;
+}
+
+/**
+ * @brief Check if the given queue is still below one of its reserved rates.
+ *
+ * @param sqIdx the zero-based index of the I/O submission queue.
+ * @return unsigned int 1 if the queue should be served before the arbitration, otherwise 0.
+ */
+unsigned int check_nvme_io_qos_reserved(unsigned int sqIdx)
+{
+    P_NVME_IO_SQ_QOS sqQos = &nvmeIoQos.sq[sqIdx];
+
+    if (sqQos->bucket[NVME_IO_QOS_ATTR_IOPS_MIN].rate && sqQos->bucket[NVME_IO_QOS_ATTR_IOPS_MIN].tokens >= 0)
+        return 1;
+    if (sqQos->bucket[NVME_IO_QOS_ATTR_BW_MIN].rate && sqQos->bucket[NVME_IO_QOS_ATTR_BW_MIN].tokens >= 0)
+        return 1;
+
+    return 0;
+}
+
+/**
+ * @brief Charge an admitted command to the buckets of its queue and record its wait.
+ *
+ * The reservation buckets never go deeper than one bucket of debt, so a queue that was
+ * served above its reservation in the past will not lose its guarantee for a long time.
+ *
+ * @param sqIdx the zero-based index of the I/O submission queue.
+ * @param blockCnt the number of NVMe blocks accessed by the command.
+ * @param fetchTick the time the command was fetched.
+ */
+void charge_nvme_io_qos(unsigned int sqIdx, unsigned int blockCnt, XTime fetchTick)
+{
+    P_NVME_IO_SQ_QOS sqQos = &nvmeIoQos.sq[sqIdx];
+    P_NVME_IO_QOS_BUCKET bucket;
+    unsigned int attr, kib, cost, iBucket;
+    XTime waitUs;
+
+    kib = blockCnt * (BYTES_PER_NVME_BLOCK / 1024);
+
+    for (attr = 0; attr < NVME_IO_QOS_ATTRS; attr++)
+    {
+        bucket = &sqQos->bucket[attr];
+        if (bucket->rate == 0)
+            continue;
+
+        cost = (attr == NVME_IO_QOS_ATTR_IOPS_LIMIT || attr == NVME_IO_QOS_ATTR_IOPS_MIN) ? 1 : kib;
+        bucket->tokens -= (long long)cost * COUNTS_PER_SECOND;
+
+        if ((attr == NVME_IO_QOS_ATTR_IOPS_MIN || attr == NVME_IO_QOS_ATTR_BW_MIN) && bucket->tokens < -bucket->depth)
+            bucket->tokens = -bucket->depth;
+    }
+
+    sqQos->admittedKiB += kib;
+
+    // the buckets were refilled at the beginning of this admission round
+    waitUs = (nvmeIoQos.lastTick > fetchTick) ? (nvmeIoQos.lastTick - fetchTick) * 1000000 / COUNTS_PER_SECOND : 0;
+    for (iBucket = 0; waitUs && iBucket < NVME_IO_QOS_WAIT_BUCKETS - 1; iBucket++)
+        waitUs >>= 1;
+    sqQos->admitWaitHist[iBucket]++;
+}
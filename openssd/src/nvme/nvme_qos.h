@@ -0,0 +1,142 @@
+//////////////////////////////////////////////////////////////////////////////////
+// nvme_qos.h for Cosmos+ OpenSSD
+//
+// This file is part of Cosmos+ OpenSSD.
+//
+// Cosmos+ OpenSSD is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3, or (at your option)
+// any later version.
+//
+// Cosmos+ OpenSSD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Cosmos+ OpenSSD; see the file COPYING.
+// If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+// Project Name: Cosmos+ OpenSSD
+// Design Name: Cosmos+ Firmware
+// Module Name: NVMe I/O QoS
+// File Name: nvme_qos.h
+//
+// Version: v1.0.0
+//
+// Description:
+//   - declares the token buckets and statistics of the I/O QoS
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+// Revision History:
+//
+// * v1.0.0
+//   - First draft
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __NVME_QOS_H_
+#define __NVME_QOS_H_
+
+#include "xtime_l.h"
+
+/**
+ * @brief The vendor specific feature for configuring the I/O QoS of submission queues.
+ *
+ * Set Features (FID 0xC0):
+ *
+ * - dword11: bit[00,07] the QID of the I/O submission queue, bit[08,15] the attribute
+ *   (`NVME_IO_QOS_ATTR_*`) to be set.
+ * - dword12: the new value of the attribute, 0 for no limit (or no reservation).
+ *
+ * Get Features (FID 0xC0) takes the same dword11 and returns the attribute in dword0 of
+ * the completion entry.
+ */
+#define VENDOR_IO_QOS 0xC0
+
+#define NVME_IO_QOS_ATTR_IOPS_LIMIT 0 // the maximum commands per second
+#define NVME_IO_QOS_ATTR_BW_LIMIT   1 // the maximum KiB per second
+#define NVME_IO_QOS_ATTR_IOPS_MIN   2 // the reserved commands per second
+#define NVME_IO_QOS_ATTR_BW_MIN     3 // the reserved KiB per second
+#define NVME_IO_QOS_ATTRS           4
+
+/**
+ * @brief The depth of the token buckets, in milliseconds of the configured rate.
+ *
+ * A command is admitted as long as the bucket is not in debt, and its whole cost is then
+ * charged to the bucket, so commands larger than the bucket depth are still admitted and
+ * the following commands of the same queue will be throttled until the debt is repaid.
+ */
+#define NVME_IO_QOS_BUCKET_DEPTH_MS 10
+
+/**
+ * @brief The number of buckets of the admission wait histograms.
+ *
+ * The i-th bucket counts the commands waited for [2^(i-1), 2^i) us between being fetched
+ * and being admitted, and the last bucket also counts the longer ones.
+ *
+ * @note This is not the command latency, the time spent in the FTL and on NAND is not
+ * included since the completions are posted by the DMA engine.
+ */
+#define NVME_IO_QOS_WAIT_BUCKETS 20
+
+typedef struct _ADMIN_SET_FEATURES_IO_QOS_DW11
+{
+    union
+    {
+        unsigned int dword;
+        struct
+        {
+            unsigned char QID;
+            unsigned char ATTR;
+            unsigned short reserved0;
+        };
+    };
+} ADMIN_SET_FEATURES_IO_QOS_DW11;
+
+/**
+ * @brief A token bucket, the tokens are scaled by `COUNTS_PER_SECOND`.
+ *
+ * Refilling the bucket for `t` timer ticks adds `t * rate` scaled tokens, so no division
+ * is needed on the admission path.
+ */
+typedef struct _NVME_IO_QOS_BUCKET
+{
+    unsigned int rate; // tokens per second, 0 for disabled
+    long long tokens;  // the scaled tokens, negative for debt
+    long long depth;   // the maximum scaled tokens
+} NVME_IO_QOS_BUCKET, *P_NVME_IO_QOS_BUCKET;
+
+/**
+ * @brief The QoS states and statistics of a single I/O submission queue.
+ */
+typedef struct _NVME_IO_SQ_QOS
+{
+    NVME_IO_QOS_BUCKET bucket[NVME_IO_QOS_ATTRS];
+    unsigned int throttledCnt;                            // admission rounds stopped by the limits
+    unsigned int reservedCnt;                             // commands admitted by the reservations
+    unsigned long long admittedKiB;                       // for the achieved bandwidth
+    unsigned int admitWaitHist[NVME_IO_QOS_WAIT_BUCKETS]; // the admission wait histogram
+} NVME_IO_SQ_QOS, *P_NVME_IO_SQ_QOS;
+
+typedef struct _NVME_IO_QOS
+{
+    XTime lastTick;      // the last time the buckets were refilled
+    XTime statStartTick; // the start time of the statistics
+    NVME_IO_SQ_QOS sq[MAX_NUM_OF_IO_SQ];
+} NVME_IO_QOS, *P_NVME_IO_QOS;
+
+void init_nvme_io_qos();
+unsigned int set_nvme_io_qos(unsigned int dword11, unsigned int value);
+unsigned int get_nvme_io_qos(unsigned int dword11);
+
+void refill_nvme_io_qos();
+unsigned int check_nvme_io_qos_limit(unsigned int sqIdx);
+unsigned int check_nvme_io_qos_reserved(unsigned int sqIdx);
+void charge_nvme_io_qos(unsigned int sqIdx, unsigned int blockCnt, XTime fetchTick);
+
+extern NVME_IO_QOS nvmeIoQos;
+
+#endif //__NVME_QOS_H_
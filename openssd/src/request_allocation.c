@@ -45,11 +45,13 @@
 
 #include "xil_printf.h"
 #include <assert.h>
+#include "debug.h"
 #include "memory_map.h"
 
 P_REQ_POOL reqPoolPtr;
 FREE_REQUEST_QUEUE freeReqQ;
 SLICE_REQUEST_QUEUE sliceReqQ;
+REQ_CREDIT_POOL reqCreditPool;
 BLOCKED_BY_BUFFER_DEPENDENCY_REQUEST_QUEUE blockedByBufDepReqQ;
 BLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE blockedByRowAddrDepReqQ[USER_CHANNELS][USER_WAYS];
 NVME_DMA_REQUEST_QUEUE nvmeDmaReqQ;
@@ -68,7 +70,7 @@ unsigned int blockedReqCnt;
  * After all the queues are initialized, we next have to initialize the request pool:
  *
  * - all the entries should belongs to `freeReqQ` by default
- * - all the entries should be connected in serial order
+ * - all the entries should be appended to the ring of `freeReqQ` in serial order
  * - no request exists at the beginning, therefore:
  *      - the number of not completed NAND request is zero
  *      - the number of blocking requests is zero
@@ -78,14 +80,20 @@ void InitReqPool()
 {
     int chNo, wayNo, reqSlotTag;
 
+    STATIC_ASSERT(REQ_RING_QUEUE_CAPACITY >= AVAILABLE_OUNTSTANDING_REQ_COUNT);
+    STATIC_ASSERT(sizeof(SSD_REQ_FORMAT) == 16); // keep two hot entries per cache line
+
     reqPoolPtr = (P_REQ_POOL)REQ_POOL_ADDR; // revise address
 
-    freeReqQ.headReq = 0;
-    freeReqQ.tailReq = AVAILABLE_OUNTSTANDING_REQ_COUNT - 1;
+    freeReqQ.head = 0;
+    freeReqQ.tail = 0;
+
+    sliceReqQ.head   = 0;
+    sliceReqQ.tail   = 0;
+    sliceReqQ.reqCnt = 0;
 
-    sliceReqQ.headReq = REQ_SLOT_TAG_NONE;
-    sliceReqQ.tailReq = REQ_SLOT_TAG_NONE;
-    sliceReqQ.reqCnt  = 0;
+    reqCreditPool.admittedCredits = 0;
+    reqCreditPool.queuedCredits   = 0;
 
     blockedByBufDepReqQ.headReq = REQ_SLOT_TAG_NONE;
     blockedByBufDepReqQ.tailReq = REQ_SLOT_TAG_NONE;
@@ -98,41 +106,71 @@ void InitReqPool()
     for (chNo = 0; chNo < USER_CHANNELS; chNo++)
         for (wayNo = 0; wayNo < USER_WAYS; wayNo++)
         {
-            blockedByRowAddrDepReqQ[chNo][wayNo].headReq = REQ_SLOT_TAG_NONE;
-            blockedByRowAddrDepReqQ[chNo][wayNo].tailReq = REQ_SLOT_TAG_NONE;
-            blockedByRowAddrDepReqQ[chNo][wayNo].reqCnt  = 0;
+            blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockHead = ROW_ADDR_DEP_BLOCK_NONE;
+            blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockTail = ROW_ADDR_DEP_BLOCK_NONE;
+            blockedByRowAddrDepReqQ[chNo][wayNo].reqCnt        = 0;
 
             nandReqQ[chNo][wayNo].headReq = REQ_SLOT_TAG_NONE;
             nandReqQ[chNo][wayNo].tailReq = REQ_SLOT_TAG_NONE;
             nandReqQ[chNo][wayNo].reqCnt  = 0;
         }
 
+    freeReqQ.reqCnt = 0;
     for (reqSlotTag = 0; reqSlotTag < AVAILABLE_OUNTSTANDING_REQ_COUNT; reqSlotTag++)
     {
-        reqPoolPtr->reqPool[reqSlotTag].reqQueueType    = REQ_QUEUE_TYPE_FREE;
         reqPoolPtr->reqPool[reqSlotTag].prevBlockingReq = REQ_SLOT_TAG_NONE;
         reqPoolPtr->reqPool[reqSlotTag].nextBlockingReq = REQ_SLOT_TAG_NONE;
-        reqPoolPtr->reqPool[reqSlotTag].prevReq         = reqSlotTag - 1;
-        reqPoolPtr->reqPool[reqSlotTag].nextReq         = reqSlotTag + 1;
+        PutToFreeReqQ(reqSlotTag);
     }
 
-    reqPoolPtr->reqPool[0].prevReq                                    = REQ_SLOT_TAG_NONE;
-    reqPoolPtr->reqPool[AVAILABLE_OUNTSTANDING_REQ_COUNT - 1].nextReq = REQ_SLOT_TAG_NONE;
-    freeReqQ.reqCnt = AVAILABLE_OUNTSTANDING_REQ_COUNT; // TODO: move this up ?
-
     notCompletedNandReqCnt = 0;
     blockedReqCnt          = 0;
 }
 
+/**
+ * @brief Append the request index to the tail of the given ring queue.
+ *
+ * @param ringQ the ring queue to be appended.
+ * @param reqSlotTag the request pool entry index of the request to be added.
+ */
+static void PutToReqRingQ(P_REQUEST_RING_QUEUE ringQ, unsigned int reqSlotTag)
+{
+    ASSERT(ringQ->reqCnt < REQ_RING_QUEUE_CAPACITY, "ring queue overflow");
+
+    ringQ->reqSlotTag[ringQ->tail] = reqSlotTag;
+    if (++ringQ->tail == REQ_RING_QUEUE_CAPACITY)
+        ringQ->tail = 0;
+
+    ringQ->reqCnt++;
+}
+
+/**
+ * @brief Pop the request index at the head of the given ring queue.
+ *
+ * @param ringQ the ring queue to be popped, must not be empty.
+ * @return unsigned int the request pool entry index of the first request.
+ */
+static unsigned int GetFromReqRingQ(P_REQUEST_RING_QUEUE ringQ)
+{
+    unsigned int reqSlotTag;
+
+    reqSlotTag = ringQ->reqSlotTag[ringQ->head];
+    if (++ringQ->head == REQ_RING_QUEUE_CAPACITY)
+        ringQ->head = 0;
+
+    ringQ->reqCnt--;
+
+    return reqSlotTag;
+}
+
 /**
  * @brief Add the given request to the free request queue.
  *
- * Insert the given request into the tail of the free queue and update the corresponding
- * field of the given request.
+ * Append the given request into the tail of the free queue ring and update the queue
+ * type of the given request.
  *
- * @note this function will not modify the `prevReq` of the next request in the original
- * request queue. That is, the prev request entry index of the original next request may
- * still be `reqSlotTag`.
+ * @note this function will not modify the `prevReq` and `nextReq` of the given request,
+ * since the requests in the ring queues are not linked.
  *
  * @note also, this function will not modify the `prevBlockingReq` and `nextBlockingReq`
  * of the original request.
@@ -141,23 +179,8 @@ void InitReqPool()
  */
 void PutToFreeReqQ(unsigned int reqSlotTag)
 {
-    if (freeReqQ.tailReq != REQ_SLOT_TAG_NONE)
-    {
-        reqPoolPtr->reqPool[reqSlotTag].prevReq       = freeReqQ.tailReq;
-        reqPoolPtr->reqPool[reqSlotTag].nextReq       = REQ_SLOT_TAG_NONE;
-        reqPoolPtr->reqPool[freeReqQ.tailReq].nextReq = reqSlotTag;
-        freeReqQ.tailReq                              = reqSlotTag;
-    }
-    else
-    {
-        reqPoolPtr->reqPool[reqSlotTag].prevReq = REQ_SLOT_TAG_NONE;
-        reqPoolPtr->reqPool[reqSlotTag].nextReq = REQ_SLOT_TAG_NONE;
-        freeReqQ.headReq                        = reqSlotTag;
-        freeReqQ.tailReq                        = reqSlotTag;
-    }
-
+    PutToReqRingQ(&freeReqQ, reqSlotTag);
     reqPoolPtr->reqPool[reqSlotTag].reqQueueType = REQ_QUEUE_TYPE_FREE;
-    freeReqQ.reqCnt++;
 }
 
 /**
@@ -173,33 +196,79 @@ unsigned int GetFromFreeReqQ()
 {
     unsigned int reqSlotTag;
 
-    reqSlotTag = freeReqQ.headReq;
-
     // try to release some request entries by doing scheduling
-    if (reqSlotTag == REQ_SLOT_TAG_NONE)
-    {
+    if (freeReqQ.reqCnt == 0)
         SyncAvailFreeReq();
-        reqSlotTag = freeReqQ.headReq;
-    }
 
-    // if the free queue becomes empty, don't forget to update its tail pointer
-    if (reqPoolPtr->reqPool[reqSlotTag].nextReq != REQ_SLOT_TAG_NONE)
-    {
-        freeReqQ.headReq = reqPoolPtr->reqPool[reqSlotTag].nextReq;
-        reqPoolPtr->reqPool[reqPoolPtr->reqPool[reqSlotTag].nextReq].prevReq = REQ_SLOT_TAG_NONE;
-    }
-    else
-    {
-        freeReqQ.headReq = REQ_SLOT_TAG_NONE;
-        freeReqQ.tailReq = REQ_SLOT_TAG_NONE;
-    }
+    reqSlotTag = GetFromReqRingQ(&freeReqQ);
 
     reqPoolPtr->reqPool[reqSlotTag].reqQueueType = REQ_QUEUE_TYPE_NONE;
-    freeReqQ.reqCnt--;
+    reqPoolPtr->reqPool[reqSlotTag].reqOpt.fua   = REQ_OPT_FUA_OFF; // only set by FUA writes explicitly
+
+    // for the deadline and the queueing delay of NAND requests
+    XTime_GetTime(&REQ_CREATE_TICK(reqSlotTag));
 
     return reqSlotTag;
 }
 
+/**
+ * @brief Get the number of request pool entries that can still be promised to commands.
+ *
+ * The slice requests of admitted commands are allocated right away, but the sub-requests
+ * of the slice requests waiting in `sliceReqQ` are not, so the credits reserved for them
+ * must be excluded from the free entries.
+ *
+ * @return unsigned int the number of available request credits.
+ */
+unsigned int GetAvailReqCredits()
+{
+    unsigned int reservedCredits = reqCreditPool.admittedCredits + reqCreditPool.queuedCredits;
+
+    if (freeReqQ.reqCnt <= reservedCredits)
+        return 0;
+
+    return freeReqQ.reqCnt - reservedCredits;
+}
+
+/**
+ * @brief Reserve the request credits of a command if the pool can hold all its requests.
+ *
+ * A command is admitted only if all of its slice requests and their sub-requests can be
+ * allocated from the free request queue, so that splitting the command will not fall into
+ * `SyncAvailFreeReq()` and stall the front end. The reserved credits are handed over to the
+ * slice requests when they are added to `sliceReqQ`, and the caller should drop the rest
+ * by `ReleaseReqCredits()` after the command is split.
+ *
+ * @note The credits of a huge command are capped at `REQ_CREDITS_MAX`, otherwise it could
+ * never be admitted. Such a command may still wait in `SyncAvailFreeReq()` while splitting.
+ *
+ * @param credits the credits needed by the command, check `REQ_CREDITS_PER_SLICE`.
+ * @return unsigned int 1 if the credits are reserved, otherwise 0.
+ */
+unsigned int ReserveReqCredits(unsigned int credits)
+{
+    if (credits > REQ_CREDITS_MAX)
+        credits = REQ_CREDITS_MAX;
+
+    if (GetAvailReqCredits() < credits)
+        return 0;
+
+    reqCreditPool.admittedCredits += credits;
+
+    return 1;
+}
+
+/**
+ * @brief Drop the credits of the admitted command that were not taken by slice requests.
+ *
+ * Commands without data blocks (e.g. flush) create no slice request, so their credits
+ * would be leaked without this.
+ */
+void ReleaseReqCredits()
+{
+    reqCreditPool.admittedCredits = 0;
+}
+
 /**
  * @brief Add the given request to the slice request queue.
  *
@@ -209,23 +278,17 @@ unsigned int GetFromFreeReqQ()
  */
 void PutToSliceReqQ(unsigned int reqSlotTag)
 {
-    if (sliceReqQ.tailReq != REQ_SLOT_TAG_NONE)
-    {
-        reqPoolPtr->reqPool[reqSlotTag].prevReq        = sliceReqQ.tailReq;
-        reqPoolPtr->reqPool[reqSlotTag].nextReq        = REQ_SLOT_TAG_NONE;
-        reqPoolPtr->reqPool[sliceReqQ.tailReq].nextReq = reqSlotTag;
-        sliceReqQ.tailReq                              = reqSlotTag;
-    }
-    else
-    {
-        reqPoolPtr->reqPool[reqSlotTag].prevReq = REQ_SLOT_TAG_NONE;
-        reqPoolPtr->reqPool[reqSlotTag].nextReq = REQ_SLOT_TAG_NONE;
-        sliceReqQ.headReq                       = reqSlotTag;
-        sliceReqQ.tailReq                       = reqSlotTag;
-    }
+    unsigned int credits = REQ_SLICE_CREDITS(reqSlotTag);
 
+    PutToReqRingQ(&sliceReqQ, reqSlotTag);
     reqPoolPtr->reqPool[reqSlotTag].reqQueueType = REQ_QUEUE_TYPE_SLICE;
-    sliceReqQ.reqCnt++;
+
+    // the slice request itself is allocated, the rest are held for its sub-requests
+    if (reqCreditPool.admittedCredits > credits)
+        reqCreditPool.admittedCredits -= credits;
+    else
+        reqCreditPool.admittedCredits = 0;
+    reqCreditPool.queuedCredits += credits - 1;
 }
 
 /**
@@ -242,24 +305,13 @@ unsigned int GetFromSliceReqQ()
 {
     unsigned int reqSlotTag;
 
-    reqSlotTag = sliceReqQ.headReq;
-
-    if (reqSlotTag == REQ_SLOT_TAG_NONE)
+    if (sliceReqQ.reqCnt == 0)
         return REQ_SLOT_TAG_FAIL;
 
-    if (reqPoolPtr->reqPool[reqSlotTag].nextReq != REQ_SLOT_TAG_NONE)
-    {
-        sliceReqQ.headReq = reqPoolPtr->reqPool[reqSlotTag].nextReq;
-        reqPoolPtr->reqPool[reqPoolPtr->reqPool[reqSlotTag].nextReq].prevReq = REQ_SLOT_TAG_NONE;
-    }
-    else
-    {
-        sliceReqQ.headReq = REQ_SLOT_TAG_NONE;
-        sliceReqQ.tailReq = REQ_SLOT_TAG_NONE;
-    }
+    reqSlotTag = GetFromReqRingQ(&sliceReqQ);
 
     reqPoolPtr->reqPool[reqSlotTag].reqQueueType = REQ_QUEUE_TYPE_NONE;
-    sliceReqQ.reqCnt--;
+    reqCreditPool.queuedCredits -= REQ_SLICE_CREDITS(reqSlotTag) - 1;
 
     return reqSlotTag;
 }
@@ -345,7 +397,8 @@ void SelectiveGetFromBlockedByBufDepReqQ(unsigned int reqSlotTag)
 /**
  * @brief Add the given request to `blockedByRowAddrDepReqQ`.
  *
- * Similar to `PutToBlockedByBufDepReqQ()`.
+ * Similar to `PutToBlockedByBufDepReqQ()`, but the request is appended to the queue of its
+ * target block in the row address dependency table.
  *
  * @note the request blocked by row address dependency is also a blocked request, the
  * `blockedReqCnt` thus should also be increased.
@@ -356,19 +409,21 @@ void SelectiveGetFromBlockedByBufDepReqQ(unsigned int reqSlotTag)
  */
 void PutToBlockedByRowAddrDepReqQ(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo)
 {
-    if (blockedByRowAddrDepReqQ[chNo][wayNo].tailReq != REQ_SLOT_TAG_NONE)
+    P_ROW_ADDR_DEPENDENCY_QUEUE blockQ = ROW_ADDR_DEP_QUEUE(chNo, wayNo, Vsa2VblockTranslation(REQ_VSA(reqSlotTag)));
+
+    if (blockQ->tailReq != REQ_SLOT_TAG_NONE)
     {
-        reqPoolPtr->reqPool[reqSlotTag].prevReq = blockedByRowAddrDepReqQ[chNo][wayNo].tailReq;
-        reqPoolPtr->reqPool[reqSlotTag].nextReq = REQ_SLOT_TAG_NONE;
-        reqPoolPtr->reqPool[blockedByRowAddrDepReqQ[chNo][wayNo].tailReq].nextReq = reqSlotTag;
-        blockedByRowAddrDepReqQ[chNo][wayNo].tailReq                              = reqSlotTag;
+        reqPoolPtr->reqPool[reqSlotTag].prevReq      = blockQ->tailReq;
+        reqPoolPtr->reqPool[reqSlotTag].nextReq      = REQ_SLOT_TAG_NONE;
+        reqPoolPtr->reqPool[blockQ->tailReq].nextReq = reqSlotTag;
+        blockQ->tailReq                              = reqSlotTag;
     }
     else
     {
-        reqPoolPtr->reqPool[reqSlotTag].prevReq      = REQ_SLOT_TAG_NONE;
-        reqPoolPtr->reqPool[reqSlotTag].nextReq      = REQ_SLOT_TAG_NONE;
-        blockedByRowAddrDepReqQ[chNo][wayNo].headReq = reqSlotTag;
-        blockedByRowAddrDepReqQ[chNo][wayNo].tailReq = reqSlotTag;
+        reqPoolPtr->reqPool[reqSlotTag].prevReq = REQ_SLOT_TAG_NONE;
+        reqPoolPtr->reqPool[reqSlotTag].nextReq = REQ_SLOT_TAG_NONE;
+        blockQ->headReq                         = reqSlotTag;
+        blockQ->tailReq                         = reqSlotTag;
     }
 
     reqPoolPtr->reqPool[reqSlotTag].reqQueueType = REQ_QUEUE_TYPE_BLOCKED_BY_ROW_ADDR_DEP;
@@ -387,11 +442,13 @@ void PutToBlockedByRowAddrDepReqQ(unsigned int reqSlotTag, unsigned int chNo, un
  */
 void SelectiveGetFromBlockedByRowAddrDepReqQ(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo)
 {
+    P_ROW_ADDR_DEPENDENCY_QUEUE blockQ;
     unsigned int prevReq, nextReq;
 
     if (reqSlotTag == REQ_SLOT_TAG_NONE)
         assert(!"[WARNING] Wrong reqSlotTag [WARNING]");
 
+    blockQ  = ROW_ADDR_DEP_QUEUE(chNo, wayNo, Vsa2VblockTranslation(REQ_VSA(reqSlotTag)));
     prevReq = reqPoolPtr->reqPool[reqSlotTag].prevReq;
     nextReq = reqPoolPtr->reqPool[reqSlotTag].nextReq;
 
@@ -402,18 +459,18 @@ void SelectiveGetFromBlockedByRowAddrDepReqQ(unsigned int reqSlotTag, unsigned i
     }
     else if ((nextReq == REQ_SLOT_TAG_NONE) && (prevReq != REQ_SLOT_TAG_NONE))
     {
-        reqPoolPtr->reqPool[prevReq].nextReq         = REQ_SLOT_TAG_NONE;
-        blockedByRowAddrDepReqQ[chNo][wayNo].tailReq = prevReq;
+        reqPoolPtr->reqPool[prevReq].nextReq = REQ_SLOT_TAG_NONE;
+        blockQ->tailReq                      = prevReq;
     }
     else if ((nextReq != REQ_SLOT_TAG_NONE) && (prevReq == REQ_SLOT_TAG_NONE))
     {
-        reqPoolPtr->reqPool[nextReq].prevReq         = REQ_SLOT_TAG_NONE;
-        blockedByRowAddrDepReqQ[chNo][wayNo].headReq = nextReq;
+        reqPoolPtr->reqPool[nextReq].prevReq = REQ_SLOT_TAG_NONE;
+        blockQ->headReq                      = nextReq;
     }
     else
     {
-        blockedByRowAddrDepReqQ[chNo][wayNo].headReq = REQ_SLOT_TAG_NONE;
-        blockedByRowAddrDepReqQ[chNo][wayNo].tailReq = REQ_SLOT_TAG_NONE;
+        blockQ->headReq = REQ_SLOT_TAG_NONE;
+        blockQ->tailReq = REQ_SLOT_TAG_NONE;
     }
 
     reqPoolPtr->reqPool[reqSlotTag].reqQueueType = REQ_QUEUE_TYPE_NONE;
@@ -421,6 +478,62 @@ void SelectiveGetFromBlockedByRowAddrDepReqQ(unsigned int reqSlotTag, unsigned i
     blockedReqCnt--;
 }
 
+/**
+ * @brief Put the given block to the wake list of its die if it has blocked requests.
+ *
+ * This should be called whenever the dependency info of the block is relaxed, so that its
+ * blocked requests will be rechecked by `ReleaseBlockedByRowAddrDepReq()`.
+ *
+ * @param chNo the channel number of the block.
+ * @param wayNo the way number of the block.
+ * @param blockNo the virtual block number of the block.
+ */
+void PutToRowAddrDepWakeList(unsigned int chNo, unsigned int wayNo, unsigned int blockNo)
+{
+    P_ROW_ADDR_DEPENDENCY_QUEUE blockQ = ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockNo);
+
+    if (blockQ->wakeFlag || blockQ->headReq == REQ_SLOT_TAG_NONE)
+        return;
+
+    if (blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockTail != ROW_ADDR_DEP_BLOCK_NONE)
+        ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockTail)->nextWakeBlock = blockNo;
+    else
+        blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockHead = blockNo;
+
+    blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockTail = blockNo;
+    blockQ->nextWakeBlock                              = ROW_ADDR_DEP_BLOCK_NONE;
+    blockQ->wakeFlag                                   = 1;
+
+    MARK_NAND_WAY_PENDING(chNo, wayNo);
+}
+
+/**
+ * @brief Get the first block from the wake list of the specified die.
+ *
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ * @return unsigned int the block number, or `ROW_ADDR_DEP_BLOCK_NONE` if the list is empty.
+ */
+unsigned int GetFromRowAddrDepWakeList(unsigned int chNo, unsigned int wayNo)
+{
+    P_ROW_ADDR_DEPENDENCY_QUEUE blockQ;
+    unsigned int blockNo;
+
+    blockNo = blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockHead;
+    if (blockNo == ROW_ADDR_DEP_BLOCK_NONE)
+        return ROW_ADDR_DEP_BLOCK_NONE;
+
+    blockQ                                             = ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockNo);
+    blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockHead = blockQ->nextWakeBlock;
+    if (blockQ->nextWakeBlock == ROW_ADDR_DEP_BLOCK_NONE)
+        blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockTail = ROW_ADDR_DEP_BLOCK_NONE;
+
+    blockQ->nextWakeBlock = ROW_ADDR_DEP_BLOCK_NONE;
+    blockQ->wakeFlag      = 0;
+
+    return blockNo;
+}
+
 /**
  * @brief Add the given request to the NVMe DMA request queue and update its status.
  *
@@ -505,12 +618,32 @@ void SelectiveGetFromNvmeDmaReqQ(unsigned int reqSlotTag)
  * @note we should not only increase the size of the specified request queue, but also
  * increase the number of uncompleted nand request.
  *
+ * Once core 1 is running (`NAND_DUAL_CORE`), the queues belong to core 1 and the request
+ * is handed over through `nandReqRingPtr` instead.
+ *
  * @param reqSlotTag the request pool entry index of the request to be added.
  * @param chNo the channel number of the specified queue.
  * @param wayNo the die number of the specified queue.
  */
 void PutToNandReqQ(unsigned int reqSlotTag, unsigned chNo, unsigned wayNo)
 {
+#if (NAND_DUAL_CORE)
+    NAND_IPC_MSG msg;
+
+    if (nandCoreRunning)
+    {
+        msg.dword      = 0;
+        msg.reqSlotTag = reqSlotTag;
+        msg.chNo       = chNo;
+        msg.wayNo      = wayNo;
+        if (!PushIpcRing(nandReqRingPtr, msg.dword))
+            assert(!"[WARNING] NAND request ring is full [WARNING]");
+
+        notCompletedNandReqCnt++;
+        return;
+    }
+#endif
+
     if (nandReqQ[chNo][wayNo].tailReq != REQ_SLOT_TAG_NONE)
     {
         reqPoolPtr->reqPool[reqSlotTag].prevReq                    = nandReqQ[chNo][wayNo].tailReq;
@@ -529,6 +662,41 @@ void PutToNandReqQ(unsigned int reqSlotTag, unsigned chNo, unsigned wayNo)
     reqPoolPtr->reqPool[reqSlotTag].reqQueueType = REQ_QUEUE_TYPE_NAND;
     nandReqQ[chNo][wayNo].reqCnt++;
     notCompletedNandReqCnt++;
+
+    MARK_NAND_WAY_PENDING(chNo, wayNo);
+}
+
+/**
+ * @brief Move the given request to the head of its `nandReqQ`, so it will be issued next.
+ *
+ * @warning The head request must not be started yet, check `PromoteNandReadReq()`.
+ *
+ * @param reqSlotTag the request pool entry index of the request to be moved.
+ * @param chNo the target channel
+ * @param wayNo the target way
+ */
+void MoveToNandReqQHead(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo)
+{
+    unsigned int prevReq, nextReq;
+
+    if (nandReqQ[chNo][wayNo].headReq == reqSlotTag)
+        return;
+
+    // unlink, the request must have a previous request since it's not the head
+    prevReq = reqPoolPtr->reqPool[reqSlotTag].prevReq;
+    nextReq = reqPoolPtr->reqPool[reqSlotTag].nextReq;
+
+    reqPoolPtr->reqPool[prevReq].nextReq = nextReq;
+    if (nextReq != REQ_SLOT_TAG_NONE)
+        reqPoolPtr->reqPool[nextReq].prevReq = prevReq;
+    else
+        nandReqQ[chNo][wayNo].tailReq = prevReq;
+
+    // insert at head
+    reqPoolPtr->reqPool[reqSlotTag].prevReq                    = REQ_SLOT_TAG_NONE;
+    reqPoolPtr->reqPool[reqSlotTag].nextReq                    = nandReqQ[chNo][wayNo].headReq;
+    reqPoolPtr->reqPool[nandReqQ[chNo][wayNo].headReq].prevReq = reqSlotTag;
+    nandReqQ[chNo][wayNo].headReq                              = reqSlotTag;
 }
 
 /**
@@ -548,6 +716,9 @@ void PutToNandReqQ(unsigned int reqSlotTag, unsigned chNo, unsigned wayNo)
 void GetFromNandReqQ(unsigned int chNo, unsigned int wayNo, unsigned int reqStatus, unsigned int reqCode)
 {
     unsigned int reqSlotTag;
+#if (NAND_CORE_SIDE)
+    NAND_IPC_MSG msg;
+#endif
 
     reqSlotTag = nandReqQ[chNo][wayNo].headReq;
     if (reqSlotTag == REQ_SLOT_TAG_NONE)
@@ -568,6 +739,43 @@ void GetFromNandReqQ(unsigned int chNo, unsigned int wayNo, unsigned int reqStat
     nandReqQ[chNo][wayNo].reqCnt--;
     notCompletedNandReqCnt--;
 
+#if (NAND_CORE_SIDE)
+    // the request entry is released by core 0, check `CheckDoneNandReq()`
+    msg.dword      = 0;
+    msg.reqSlotTag = reqSlotTag;
+    msg.chNo       = chNo;
+    msg.wayNo      = wayNo;
+    msg.reqStatus  = reqStatus;
+    if (!PushIpcRing(nandDoneRingPtr, msg.dword))
+        assert(!"[WARNING] NAND completion ring is full [WARNING]");
+#else
+    CompleteNandReq(reqSlotTag, reqStatus);
+#endif
+}
+
+/**
+ * @brief Release the request entry of a finished NAND request and the requests it blocks.
+ *
+ * A failed program of a valid slice is dispatched again instead of being released, check
+ * `RetargetFailedProgram()`.
+ *
+ * @param reqSlotTag the request pool entry index of the finished request.
+ * @param reqStatus the final status of the request.
+ */
+void CompleteNandReq(unsigned int reqSlotTag, unsigned int reqStatus)
+{
+#if (GROWN_BAD_BLOCK_SALVAGE)
+    // a retargeted program is counted again on its new block
+    UpdateInFlightProgramCnt(reqSlotTag, 0);
+
+    // the block has been marked, check `UpdateGrownBadBlockOfNandReq()`
+    if (reqStatus == REQ_STATUS_FAIL && RetargetFailedProgram(reqSlotTag))
+        return;
+#endif
+
+    if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.fua == REQ_OPT_FUA_ON)
+        ReleaseFuaProgramReq(reqSlotTag, reqStatus);
+
     PutToFreeReqQ(reqSlotTag);
     ReleaseBlockedByBufDepReq(reqSlotTag);
 }
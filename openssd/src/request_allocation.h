@@ -46,6 +46,8 @@
 #ifndef REQUEST_ALLOCATION_H_
 #define REQUEST_ALLOCATION_H_
 
+#include "xtime_l.h"
+
 #include "ftl_config.h"
 #include "request_format.h"
 #include "request_queue.h"
@@ -59,6 +61,40 @@
 #define REQ_SLOT_TAG_NONE 0xffff // no request pool entry, used for checking tail entry
 #define REQ_SLOT_TAG_FAIL 0xffff // request pool entry not found, used for return error
 
+/**
+ * @brief The request pool entries reserved for each slice request at command admission.
+ *
+ * A slice request may allocate up to 3 entries before all of its sub-requests are issued:
+ * the slice request itself (reused as the NVMe DMA request), the program request for the
+ * evicted buffer victim and the read request for filling the buffer entry. The slice of a
+ * FUA write also allocates the program request for its own data right after the Rx DMA.
+ *
+ * @sa `ReserveReqCredits()`.
+ */
+#define REQ_CREDITS_PER_SLICE     3
+#define REQ_CREDITS_PER_FUA_SLICE 4
+#define REQ_CREDITS_MAX           (AVAILABLE_OUNTSTANDING_REQ_COUNT / 2) // the most credits charged to a command
+
+/**
+ * @brief Get the request credits held by the given slice request.
+ */
+#define REQ_SLICE_CREDITS(reqSlotTag)                                                                                 \
+    ((reqPoolPtr->reqPool[(reqSlotTag)].reqOpt.fua == REQ_OPT_FUA_ON) ? REQ_CREDITS_PER_FUA_SLICE                    \
+                                                                        : REQ_CREDITS_PER_SLICE)
+
+/**
+ * @brief The request credits promised to the admitted commands.
+ *
+ * - admittedCredits: reserved for the command being split into slice requests, the credits
+ *   of each slice request are moved to `queuedCredits` once it is added to `sliceReqQ`
+ * - queuedCredits: held by the slice requests in `sliceReqQ` for their sub-requests
+ */
+typedef struct _REQ_CREDIT_POOL
+{
+    unsigned int admittedCredits;
+    unsigned int queuedCredits;
+} REQ_CREDIT_POOL, *P_REQ_CREDIT_POOL;
+
 /**
  * @brief The request entries pool for both NVMe and NAND requests.
  *
@@ -68,10 +104,20 @@
  * Unlike the schematic in the paper, this queue is shared by both host and flash
  * operations, so the structure of `SSD_REQ_FORMAT` contains some members for
  * distinguishing which type is the request.
+ *
+ * The pool is split into a hot part and a cold part. `reqPool` only holds the fields
+ * used while walking queues and making scheduling decisions, and the remaining info of
+ * the i-th request is stored at index i of the parallel arrays below, so that scanning
+ * the queues doesn't pull the payload of every visited request into the D-cache.
  */
 typedef struct _REQ_POOL
 {
-    SSD_REQ_FORMAT reqPool[AVAILABLE_OUNTSTANDING_REQ_COUNT];
+    SSD_REQ_FORMAT reqPool[AVAILABLE_OUNTSTANDING_REQ_COUNT];        // hot: type, options and queue links
+    unsigned int logicalSliceAddr[AVAILABLE_OUNTSTANDING_REQ_COUNT]; // cold: LSA of slice requests
+    DATA_BUF_INFO dataBufInfo[AVAILABLE_OUNTSTANDING_REQ_COUNT];     // cold: data buffer entry or address
+    NVME_DMA_INFO nvmeDmaInfo[AVAILABLE_OUNTSTANDING_REQ_COUNT];     // cold: NVMe DMA info
+    NAND_INFO nandInfo[AVAILABLE_OUNTSTANDING_REQ_COUNT];            // cold: VSA or physical address
+    XTime createTick[AVAILABLE_OUNTSTANDING_REQ_COUNT];              // cold: the time the request was allocated
 } REQ_POOL, *P_REQ_POOL;
 
 void InitReqPool();
@@ -79,6 +125,10 @@ void InitReqPool();
 void PutToFreeReqQ(unsigned int reqSlotTag);
 unsigned int GetFromFreeReqQ();
 
+unsigned int GetAvailReqCredits();
+unsigned int ReserveReqCredits(unsigned int credits);
+void ReleaseReqCredits();
+
 void PutToSliceReqQ(unsigned int reqSlotTag);
 unsigned int GetFromSliceReqQ();
 
@@ -87,16 +137,21 @@ void SelectiveGetFromBlockedByBufDepReqQ(unsigned int reqSlotTag);
 
 void PutToBlockedByRowAddrDepReqQ(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo);
 void SelectiveGetFromBlockedByRowAddrDepReqQ(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo);
+void PutToRowAddrDepWakeList(unsigned int chNo, unsigned int wayNo, unsigned int blockNo);
+unsigned int GetFromRowAddrDepWakeList(unsigned int chNo, unsigned int wayNo);
 
 void PutToNvmeDmaReqQ(unsigned int reqSlotTag);
 void SelectiveGetFromNvmeDmaReqQ(unsigned int regSlotTag);
 
 void PutToNandReqQ(unsigned int reqSlotTag, unsigned chNo, unsigned wayNo);
+void MoveToNandReqQHead(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo);
 void GetFromNandReqQ(unsigned int chNo, unsigned int wayNo, unsigned int reqStatus, unsigned int reqCode);
+void CompleteNandReq(unsigned int reqSlotTag, unsigned int reqStatus);
 
 extern P_REQ_POOL reqPoolPtr;
 extern FREE_REQUEST_QUEUE freeReqQ;
 extern SLICE_REQUEST_QUEUE sliceReqQ;
+extern REQ_CREDIT_POOL reqCreditPool;
 extern BLOCKED_BY_BUFFER_DEPENDENCY_REQUEST_QUEUE blockedByBufDepReqQ;
 extern BLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE blockedByRowAddrDepReqQ[USER_CHANNELS][USER_WAYS];
 extern NVME_DMA_REQUEST_QUEUE nvmeDmaReqQ;
@@ -116,9 +171,20 @@ extern unsigned int blockedReqCnt;
  * @return The address of request pool entry.
  */
 #define REQ_ENTRY(iEntry) (&reqPoolPtr->reqPool[(iEntry)])
-#define REQ_BUF(iEntry)   (REQ_ENTRY((iEntry))->dataBufInfo.entry)
-#define REQ_LSA(iEntry)   (REQ_ENTRY((iEntry))->logicalSliceAddr)
-#define REQ_VSA(iEntry)   (REQ_ENTRY((iEntry))->nandInfo.virtualSliceAddr)
+#define REQ_BUF(iEntry)   (REQ_DATA_BUF_INFO((iEntry)).entry)
+#define REQ_VSA(iEntry)   (REQ_NAND_INFO((iEntry)).virtualSliceAddr)
+
+/**
+ * @brief Get the cold info of the request entry by entry index.
+ *
+ * @param iEntry Index of request pool entry.
+ * @return The lvalue of the specified info of the request pool entry.
+ */
+#define REQ_LSA(iEntry)           (reqPoolPtr->logicalSliceAddr[(iEntry)])
+#define REQ_DATA_BUF_INFO(iEntry) (reqPoolPtr->dataBufInfo[(iEntry)])
+#define REQ_NVME_DMA_INFO(iEntry) (reqPoolPtr->nvmeDmaInfo[(iEntry)])
+#define REQ_NAND_INFO(iEntry)     (reqPoolPtr->nandInfo[(iEntry)])
+#define REQ_CREATE_TICK(iEntry)   (reqPoolPtr->createTick[(iEntry)])
 
 /**
  * @brief Check the request code of the given request pool entry index
@@ -89,7 +89,7 @@
 
 /**
  * These values are for the 2 bits flag `SSD_REQ_FORMAT::REQ_OPTION::dataBufFormat`. The
- * flag will be used for checking the meaning of `SSD_REQ_FORMAT::dataBufInfo`.
+ * flag will be used for checking the meaning of `REQ_POOL::dataBufInfo`.
  *
  * If the flag is set to `REQ_OPT_DATA_BUF_ENTRY` or `REQ_OPT_DATA_BUF_TEMP_ENTRY`, this
  * means that the data stored in the `dataBufInfo` is a index of the specified buffer.
@@ -145,6 +145,25 @@
 #define REQ_OPT_BLOCK_SPACE_MAIN  0 // main blocks only
 #define REQ_OPT_BLOCK_SPACE_TOTAL 1 // main blocks and extended blocks
 
+/**
+ * @brief Whether the slice request should bypass the data buffer cache.
+ *
+ * Large streaming transfers are served by transient buffer entries that are never
+ * inserted into the hash table and LRU list (check `ReqTransSliceToBypass()`).
+ */
+#define REQ_OPT_DATA_BUF_BYPASS_OFF 0
+#define REQ_OPT_DATA_BUF_BYPASS_ON  1
+
+/**
+ * @brief Whether the request belongs to a write command with FUA (Force Unit Access) set.
+ *
+ * The data of a FUA write is programmed to NAND right after it is received, and the NVMe
+ * command will not be completed until all its programs are confirmed (check
+ * `ReqTransSliceToLowLevel()` and `ReleaseFuaProgramReq()`).
+ */
+#define REQ_OPT_FUA_OFF 0
+#define REQ_OPT_FUA_ON  1
+
 #define LOGICAL_SLICE_ADDR_NONE 0xffffffff
 
 /**
@@ -216,14 +235,14 @@ typedef struct _NAND_INFO
 typedef struct _REQ_OPTION
 {
     /**
-     * @brief Type of address stored in the `SSD_REQ_FORMAT::dataBufInfo`.
+     * @brief Type of address stored in the `REQ_POOL::dataBufInfo`.
      *
      * REQ_OPT_DATA_BUF_(ENTRY|TEMP_ENTRY|ADDR|NONE)
      */
     unsigned int dataBufFormat : 2;
 
     /**
-     * @brief Type of address stored in the `SSD_REQ_FORMAT::nandInfo`.
+     * @brief Type of address stored in the `REQ_POOL::nandInfo`.
      *
      * 0 for VSA, 1 for PHY
      */
@@ -232,7 +251,9 @@ typedef struct _REQ_OPTION
     unsigned int nandEccWarning : 1;         // 0 for OFF, 1 for ON
     unsigned int rowAddrDependencyCheck : 1; // whether this request needs to check dependency.
     unsigned int blockSpace : 1;             // 0 for MAIN, 1 for TOTAL
-    unsigned int reserved0 : 24;
+    unsigned int dataBufBypass : 1;          // 0 for cached, 1 for transient buffer (slice only)
+    unsigned int fua : 1;                    // 0 for OFF, 1 for ON
+    unsigned int reserved0 : 22;
 } REQ_OPTION, *P_REQ_OPTION; /* NOTE: 32 bits */
 
 /**
@@ -251,6 +272,11 @@ typedef struct _REQ_OPTION
  * - request info
  * - relation between requests:
  *
+ * @note Only the members touched by queue walks and the schedulers are kept here, the
+ * per-request payload (LSA, buffer, DMA and NAND info) is stored in the parallel arrays
+ * of `REQ_POOL` and should be accessed through `REQ_LSA()`, `REQ_DATA_BUF_INFO()`,
+ * `REQ_NVME_DMA_INFO()` and `REQ_NAND_INFO()`. This keeps each entry at 16 bytes so
+ * that two entries share a single 32-byte cache line on the Cortex-A9.
  */
 typedef struct _SSD_REQ_FORMAT
 {
@@ -259,19 +285,14 @@ typedef struct _SSD_REQ_FORMAT
     unsigned int reqCode : 8;         // READ/WRITE/RxDMA/TxDMA/etc. (check REQ_CODE_*)
     unsigned int nvmeCmdSlotTag : 16; // TODO
 
-    unsigned int logicalSliceAddr;
-
-    REQ_OPTION reqOpt;         // optional request configs
-    DATA_BUF_INFO dataBufInfo; // request data buffer entry info of this request
-    NVME_DMA_INFO nvmeDmaInfo; // NVMe requests related info
-    NAND_INFO nandInfo;        // address info of this NAND request
+    REQ_OPTION reqOpt; // optional request configs
 
     unsigned int prevReq : 16;         // the request pool index of prev request queue entry
     unsigned int nextReq : 16;         // the request pool index of next request queue entry
     unsigned int prevBlockingReq : 16; // request entry index of the prev request in blocking request queue
     unsigned int nextBlockingReq : 16; // request entry index of the next request in blocking request queue
 
-    // 4 4 8+4+12+8 8 Bytes
+    // 4 4 8 Bytes
 
 } SSD_REQ_FORMAT, *P_SSD_REQ_FORMAT;
 
@@ -45,54 +45,64 @@
 #ifndef REQUEST_QUEUE_H_
 #define REQUEST_QUEUE_H_
 
-// TODO these structures are exactly the same, should be simplified into 1 structure
+#include "ftl_config.h"
 
-typedef struct _FREE_REQUEST_QUEUE
-{
-    unsigned int headReq : 16;
-    unsigned int tailReq : 16;
-    unsigned int reqCnt : 16;
-    unsigned int reserved0 : 16;
-} FREE_REQUEST_QUEUE, *P_FREE_REQUEST_QUEUE;
+// the capacity of ring queues, must not be less than `AVAILABLE_OUNTSTANDING_REQ_COUNT`
+#define REQ_RING_QUEUE_CAPACITY ((USER_DIES)*128)
 
-typedef struct _SLICE_REQUEST_QUEUE
+/**
+ * @brief The FIFO ring of request pool entry indices.
+ *
+ * Used for the strictly FIFO queues (`freeReqQ` and `sliceReqQ`) that never remove a
+ * request selectively. Unlike the other queues, the requests in a ring queue are not
+ * linked through `prevReq` and `nextReq`, so enqueue and dequeue only touch the ring.
+ *
+ * Since the capacity equals the size of request pool, the ring never overflows.
+ */
+typedef struct _REQUEST_RING_QUEUE
 {
-    unsigned int headReq : 16;
-    unsigned int tailReq : 16;
+    unsigned int head : 16; // the ring slot of the first request
+    unsigned int tail : 16; // the ring slot for the next request to be appended
     unsigned int reqCnt : 16;
     unsigned int reserved0 : 16;
-} SLICE_REQUEST_QUEUE, *P_SLICE_REQUEST_QUEUE;
+    unsigned short reqSlotTag[REQ_RING_QUEUE_CAPACITY];
+} REQUEST_RING_QUEUE, *P_REQUEST_RING_QUEUE;
 
-typedef struct _BLOCKED_BY_BUFFER_DEPENDENCY_REQUEST_QUEUE
-{
-    unsigned int headReq : 16;
-    unsigned int tailReq : 16;
-    unsigned int reqCnt : 16;
-    unsigned int reserved0 : 16;
-} BLOCKED_BY_BUFFER_DEPENDENCY_REQUEST_QUEUE, *P_BLOCKED_BY_BUFFER_DEPENDENCY_REQUEST_QUEUE;
+typedef REQUEST_RING_QUEUE FREE_REQUEST_QUEUE, *P_FREE_REQUEST_QUEUE;
+typedef REQUEST_RING_QUEUE SLICE_REQUEST_QUEUE, *P_SLICE_REQUEST_QUEUE;
 
-typedef struct _BLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE
+/**
+ * @brief The doubly linked list of requests.
+ *
+ * Used for the queues whose requests may be removed from the middle, the requests are
+ * linked through their `prevReq` and `nextReq`.
+ */
+typedef struct _REQUEST_LINKED_QUEUE
 {
     unsigned int headReq : 16;
     unsigned int tailReq : 16;
     unsigned int reqCnt : 16;
     unsigned int reserved0 : 16;
-} BLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE, *PBLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE;
+} REQUEST_LINKED_QUEUE, *P_REQUEST_LINKED_QUEUE;
 
-typedef struct _NVME_DMA_REQUEST_QUEUE
-{
-    unsigned int headReq : 16;
-    unsigned int tailReq : 16;
-    unsigned int reqCnt : 16;
-    unsigned int reserved0 : 16;
-} NVME_DMA_REQUEST_QUEUE, *P_NVME_DMA_REQUEST_QUEUE;
+typedef REQUEST_LINKED_QUEUE BLOCKED_BY_BUFFER_DEPENDENCY_REQUEST_QUEUE, *P_BLOCKED_BY_BUFFER_DEPENDENCY_REQUEST_QUEUE;
+typedef REQUEST_LINKED_QUEUE NVME_DMA_REQUEST_QUEUE, *P_NVME_DMA_REQUEST_QUEUE;
+typedef REQUEST_LINKED_QUEUE NAND_REQUEST_QUEUE, *P_NAND_REQUEST_QUEUE;
 
-typedef struct _NAND_REQUEST_QUEUE
+/**
+ * @brief The requests blocked by row address dependency on a die.
+ *
+ * The blocked requests are queued on their target blocks (check `ROW_ADDR_DEPENDENCY_QUEUE`),
+ * and this structure only links the blocks whose dependency info changed since they were
+ * last checked, so that `ReleaseBlockedByRowAddrDepReq()` doesn't need to recheck all the
+ * blocked requests of the die.
+ */
+typedef struct _BLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE
 {
-    unsigned int headReq : 16;
-    unsigned int tailReq : 16;
-    unsigned int reqCnt : 16;
+    unsigned int wakeBlockHead : 16; // the first block to be rechecked
+    unsigned int wakeBlockTail : 16; // the last block to be rechecked
+    unsigned int reqCnt : 16;        // the number of blocked requests on this die
     unsigned int reserved0 : 16;
-} NAND_REQUEST_QUEUE, *P_NAND_REQUEST_QUEUE;
+} BLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE, *PBLOCKED_BY_ROW_ADDR_DEPENDENCY_REQUEST_QUEUE;
 
 #endif /* REQUEST_QUEUE_H_ */
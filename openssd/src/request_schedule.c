@@ -47,7 +47,11 @@
 //////////////////////////////////////////////////////////////////////////////////
 
 #include <assert.h>
+#include <string.h>
 #include "xil_printf.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xpseudo_asm.h"
 #include "memory_map.h"
 #include "debug.h"
 
@@ -59,6 +63,54 @@ P_RETRY_LIMIT_TABLE retryLimitTablePtr;
 P_DIE_STATE_TABLE dieStateTablePtr;
 P_WAY_PRIORITY_TABLE wayPriorityTablePtr;
 
+NAND_READ_PRIO_STAT nandReadPrioStat;
+NAND_REQ_DEADLINE_STAT nandReqDeadlineStat;
+NAND_CH_ISSUE_STAT nandChIssueStat[USER_CHANNELS];
+XTime nandReqDeadline[NAND_REQ_CLASSES]; // in timer ticks, 0 for no deadline
+static unsigned char readOvertakeCnt[USER_CHANNELS][USER_WAYS]; // reads issued ahead of the waiting head
+
+NAND_SUSPEND_STAT nandSuspendStat;
+#if (NAND_SUSPEND)
+static NAND_SUSPEND_ENTRY nandSuspendTable[USER_CHANNELS][USER_WAYS];
+#endif
+
+NAND_MULTI_PLANE_STAT nandMultiPlaneStat;
+#if (NAND_MULTI_PLANE)
+static unsigned short nandPlanePairedReq[USER_CHANNELS][USER_WAYS]; // issued with the head by multi-plane command
+#endif
+
+NAND_SCHED_STAT nandSchedStat;
+NAND_DIE_UTIL_STAT nandDieUtilStat[USER_CHANNELS][USER_WAYS];
+NAND_CH_UTIL_STAT nandChUtilStat[USER_CHANNELS];
+XTime nandUtilStartTick; // when the utilization statistics were reset
+unsigned int nandChPendingMap;                   // channels to be visited, check `NAND_SCHED_EVENT`
+unsigned int nandWayPendingMap[USER_CHANNELS];   // ways that got requests since the last visit
+
+NAND_CACHE_STAT nandCacheStat;
+#if (NAND_CACHE_OPS)
+static NAND_CACHE_ENTRY nandCacheTable[USER_CHANNELS][USER_WAYS];
+#endif
+
+NAND_READ_RETRY_STAT nandReadRetryStat;
+#if (NAND_READ_RETRY)
+static P_NAND_READ_RETRY_HISTORY_TABLE readRetryHistoryTablePtr;
+static P_NAND_READ_RETRY_PAY_LOAD_TABLE readRetryPayLoadTablePtr;
+static NAND_READ_RETRY_ENTRY nandReadRetryTable[USER_CHANNELS][USER_WAYS];
+
+// the feature values of the read levels, level 0 is the default one
+static const unsigned char nandReadRetryLevel[NAND_READ_RETRY_LEVELS] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05};
+#endif
+
+NAND_ECC_MARGIN_STAT nandEccMarginStat;
+#if (NAND_ECC_REFRESH)
+static P_NAND_ECC_MARGIN_TABLE eccMarginTablePtr;
+#endif
+
+P_IPC_RING nandReqRingPtr;
+P_IPC_RING nandDoneRingPtr;
+P_IPC_RING nandRefreshRingPtr; // produced by the scheduler, consumed by `RefreshQueuedBlock()`
+unsigned int nandCoreRunning; // core 1 owns the dies, only set on core 0, check `NAND_DUAL_CORE`
+
 /**
  * @brief Initialize scheduling related tables.
  *
@@ -79,6 +131,12 @@ P_WAY_PRIORITY_TABLE wayPriorityTablePtr;
  * - all the dies are in idle state and connected in serial order
  * - the completion count and status report of all die are set to 0
  * - the retry limit number of each die is set to `RETRY_LIMIT`
+ *
+ * @note The tables above, the read retry history, the ECC margin table and the refresh
+ * ring live in the memory map. With `NAND_DUAL_CORE` they are initialized by core 0 only,
+ * and core 1 just points to them and resets the states private to its own image. Core 1
+ * must not reset them, since the history learned during `InitFTL()` would be lost and
+ * `RefreshQueuedBlock()` on core 0 may be consuming the refresh ring already.
  */
 void InitReqScheduler()
 {
@@ -92,6 +150,16 @@ void InitReqScheduler()
     dieStateTablePtr    = (P_DIE_STATE_TABLE)DIE_STATE_TABLE_ADDR;
     wayPriorityTablePtr = (P_WAY_PRIORITY_TABLE)WAY_PRIORITY_TABLE_ADDR;
 
+#if (NAND_READ_RETRY)
+    readRetryHistoryTablePtr = (P_NAND_READ_RETRY_HISTORY_TABLE)READ_RETRY_HISTORY_TABLE_ADDR;
+    readRetryPayLoadTablePtr = (P_NAND_READ_RETRY_PAY_LOAD_TABLE)READ_RETRY_PAY_LOAD_ADDR;
+#endif
+#if (NAND_ECC_REFRESH)
+    eccMarginTablePtr  = (P_NAND_ECC_MARGIN_TABLE)ECC_MARGIN_TABLE_ADDR;
+    nandRefreshRingPtr = (P_IPC_RING)NAND_REFRESH_RING_ADDR;
+#endif
+
+#if (!NAND_CORE_SIDE)
     for (chNo = 0; chNo < USER_CHANNELS; ++chNo)
     {
         wayPriorityTablePtr->wayPriority[chNo].idleHead         = 0;
@@ -123,6 +191,68 @@ void InitReqScheduler()
         dieStateTablePtr->dieState[chNo][0].prevWay             = WAY_NONE;
         dieStateTablePtr->dieState[chNo][USER_WAYS - 1].nextWay = WAY_NONE;
     }
+
+#if (NAND_READ_RETRY)
+    memset(readRetryHistoryTablePtr, 0, sizeof(NAND_READ_RETRY_HISTORY_TABLE));
+#endif
+#if (NAND_ECC_REFRESH)
+    memset(eccMarginTablePtr, 0, sizeof(NAND_ECC_MARGIN_TABLE));
+    InitIpcRing(nandRefreshRingPtr);
+#endif
+#endif
+
+    // the states below are private to each core image
+    for (chNo = 0; chNo < USER_CHANNELS; ++chNo)
+    {
+        for (wayNo = 0; wayNo < USER_WAYS; ++wayNo)
+        {
+            readOvertakeCnt[chNo][wayNo] = 0;
+#if (NAND_SUSPEND)
+            nandSuspendTable[chNo][wayNo].suspendedReq = REQ_SLOT_TAG_NONE;
+            nandSuspendTable[chNo][wayNo].readReq      = REQ_SLOT_TAG_NONE;
+            nandSuspendTable[chNo][wayNo].suspendCnt   = 0;
+#endif
+#if (NAND_MULTI_PLANE)
+            nandPlanePairedReq[chNo][wayNo] = REQ_SLOT_TAG_NONE;
+#endif
+#if (NAND_CACHE_OPS)
+            nandCacheTable[chNo][wayNo].cachedReq = REQ_SLOT_TAG_NONE;
+            nandCacheTable[chNo][wayNo].cacheOp   = NAND_CACHE_OP_NONE;
+#endif
+#if (NAND_READ_RETRY)
+            nandReadRetryTable[chNo][wayNo].curLevel     = 0;
+            nandReadRetryTable[chNo][wayNo].levelSetting = 0;
+            nandReadRetryTable[chNo][wayNo].levelSet     = 0;
+#endif
+        }
+
+        // visit everything once
+        nandWayPendingMap[chNo] = (1 << USER_WAYS) - 1;
+    }
+
+    nandReadPrioStat.promotedCnt   = 0;
+    nandReadPrioStat.conflictCnt   = 0;
+    nandReadPrioStat.starvationCnt = 0;
+
+    nandReqDeadline[NAND_REQ_CLASS_HOST_READ]  = (XTime)NAND_REQ_DEADLINE_US_HOST_READ * COUNTS_PER_SECOND / 1000000;
+    nandReqDeadline[NAND_REQ_CLASS_HOST_WRITE] = (XTime)NAND_REQ_DEADLINE_US_HOST_WRITE * COUNTS_PER_SECOND / 1000000;
+    nandReqDeadline[NAND_REQ_CLASS_INTERNAL]   = (XTime)NAND_REQ_DEADLINE_US_INTERNAL * COUNTS_PER_SECOND / 1000000;
+    nandReqDeadline[NAND_REQ_CLASS_ERASE]      = (XTime)NAND_REQ_DEADLINE_US_ERASE * COUNTS_PER_SECOND / 1000000;
+    nandReqDeadline[NAND_REQ_CLASS_PHY]        = (XTime)NAND_REQ_DEADLINE_US_PHY * COUNTS_PER_SECOND / 1000000;
+    memset(&nandReqDeadlineStat, 0, sizeof(nandReqDeadlineStat));
+    memset(nandChIssueStat, 0, sizeof(nandChIssueStat));
+    memset(&nandSuspendStat, 0, sizeof(nandSuspendStat));
+    memset(&nandMultiPlaneStat, 0, sizeof(nandMultiPlaneStat));
+    memset(&nandCacheStat, 0, sizeof(nandCacheStat));
+    memset(&nandSchedStat, 0, sizeof(nandSchedStat));
+    memset(nandDieUtilStat, 0, sizeof(nandDieUtilStat));
+    for (chNo = 0; chNo < USER_CHANNELS; chNo++)
+        for (wayNo = 0; wayNo < USER_WAYS; wayNo++)
+            nandDieUtilStat[chNo][wayNo].busyOp = NAND_UTIL_OP_NONE;
+    ResetNandUtilStat();
+    memset(&nandReadRetryStat, 0, sizeof(nandReadRetryStat));
+    memset(&nandEccMarginStat, 0, sizeof(nandEccMarginStat));
+    nandChPendingMap = (1 << USER_CHANNELS) - 1;
 }
 
 /**
@@ -149,7 +279,7 @@ void SyncAllLowLevelReqDone()
  */
 void SyncAvailFreeReq()
 {
-    while (freeReqQ.headReq == REQ_SLOT_TAG_NONE)
+    while (freeReqQ.reqCnt == 0)
     {
         CheckDoneNvmeDmaReq();
         SchedulingNandReq();
@@ -186,9 +316,632 @@ void SyncReleaseEraseReq(unsigned int chNo, unsigned int wayNo, unsigned int blo
 void SchedulingNandReq()
 {
     int chNo;
+#if (NAND_SCHED_PROFILE)
+    XTime startTick, endTick;
+#endif
+
+#if (NAND_DUAL_CORE)
+    // the dies are scheduled by core 1, only complete the requests it returns
+    if (nandCoreRunning)
+    {
+        CheckDoneNandReq();
+        return;
+    }
+#endif
+
+#if (NAND_SCHED_PROFILE)
+    XTime_GetTime(&startTick);
+#endif
 
+    nandSchedStat.passCnt++;
     for (chNo = 0; chNo < USER_CHANNELS; chNo++)
+    {
+#if (NAND_SCHED_EVENT)
+        if (!(nandChPendingMap & (1 << chNo)))
+            continue;
+#endif
+        nandSchedStat.chVisitCnt++;
         SchedulingNandReqPerCh(chNo);
+    }
+
+#if (NAND_SCHED_PROFILE)
+    XTime_GetTime(&endTick);
+    nandSchedStat.passTicks += endTick - startTick;
+    if (endTick - startTick > nandSchedStat.maxPassTicks)
+        nandSchedStat.maxPassTicks = endTick - startTick;
+#endif
+}
+
+#if (NAND_SCHED_EVENT)
+/**
+ * @brief Check if all the dies of the given channel are idle.
+ *
+ * @param chNo the channel number to check.
+ * @return unsigned int 1 if no die of this channel is in any list other than the idle list.
+ */
+static unsigned int IsNandChIdle(unsigned int chNo)
+{
+    P_WAY_PRIORITY_ENTRY wayPriority = &wayPriorityTablePtr->wayPriority[chNo];
+
+    return wayPriority->statusReportHead == WAY_NONE && wayPriority->statusCheckHead == WAY_NONE &&
+           wayPriority->readTriggerHead == WAY_NONE && wayPriority->readTransferHead == WAY_NONE &&
+           wayPriority->writeHead == WAY_NONE && wayPriority->eraseHead == WAY_NONE;
+}
+#endif
+
+/**
+ * @brief Issue the READ_TRANSFER requests of the ways in the `readTransfer` list.
+ *
+ * @param chNo the channel number for scheduling
+ * @param cmdSlots the number of commands that can be issued
+ * @return unsigned int the number of remaining slots.
+ */
+static unsigned int IssueNandReadTransferReqs(unsigned int chNo, unsigned int cmdSlots)
+{
+    unsigned int wayNo, nextWay;
+
+    wayNo = wayPriorityTablePtr->wayPriority[chNo].readTransferHead;
+    while (wayNo != WAY_NONE && cmdSlots)
+    {
+        nextWay = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
+
+        ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
+
+        SelectiveGetFromNandReadTransferList(chNo, wayNo);
+        PutToNandStatusReportList(chNo, wayNo);
+
+        cmdSlots--;
+        wayNo = nextWay;
+    }
+
+    return cmdSlots;
+}
+
+/**
+ * @brief Get the deadline class of the given NAND request.
+ *
+ * @param reqSlotTag the request pool entry index of the NAND request.
+ * @return unsigned int the class of the request, check `NAND_REQ_CLASS_*`.
+ */
+unsigned int GetNandReqClass(unsigned int reqSlotTag)
+{
+    P_SSD_REQ_FORMAT req = REQ_ENTRY(reqSlotTag);
+
+    if (req->reqOpt.nandAddr != REQ_OPT_NAND_ADDR_VSA)
+        return NAND_REQ_CLASS_PHY;
+    if (req->reqCode == REQ_CODE_ERASE)
+        return NAND_REQ_CLASS_ERASE;
+    if (req->reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_TEMP_ENTRY)
+        return NAND_REQ_CLASS_INTERNAL;
+    if (req->reqCode == REQ_CODE_WRITE)
+        return NAND_REQ_CLASS_HOST_WRITE;
+
+    return NAND_REQ_CLASS_HOST_READ;
+}
+
+/**
+ * @brief Record the queueing delay of a NAND request that is going to be issued.
+ *
+ * @param reqSlotTag the request pool entry index of the NAND request.
+ */
+static void RecordNandReqDelay(unsigned int reqSlotTag)
+{
+    unsigned int reqClass, iBucket;
+    XTime now, delay, delayUs;
+
+    XTime_GetTime(&now);
+    reqClass = GetNandReqClass(reqSlotTag);
+    delay    = now - REQ_CREATE_TICK(reqSlotTag);
+
+    if (nandReqDeadline[reqClass] && delay > nandReqDeadline[reqClass])
+        nandReqDeadlineStat.missedCnt[reqClass]++;
+
+    delayUs = delay * 1000000 / COUNTS_PER_SECOND;
+    for (iBucket = 0; delayUs && iBucket < NAND_REQ_DELAY_BUCKETS - 1; iBucket++)
+        delayUs >>= 1;
+    nandReqDeadlineStat.delayHist[reqClass][iBucket]++;
+}
+
+/**
+ * @brief Clear the utilization statistics of all the dies and channels.
+ *
+ * The operations in progress are kept, and only their time after the reset is accounted.
+ *
+ * @note Each core image has its own copy of the statistics. With `NAND_DUAL_CORE`, this
+ * is called by the monitor on core 0 and only clears the copy of core 0, which covers the
+ * operations issued before `StartNandCore()`.
+ */
+void ResetNandUtilStat()
+{
+    P_NAND_DIE_UTIL_STAT dieUtil;
+    unsigned int chNo, wayNo, op;
+
+    XTime_GetTime(&nandUtilStartTick);
+    memset(nandChUtilStat, 0, sizeof(nandChUtilStat));
+
+    for (chNo = 0; chNo < USER_CHANNELS; chNo++)
+        for (wayNo = 0; wayNo < USER_WAYS; wayNo++)
+        {
+            dieUtil = &nandDieUtilStat[chNo][wayNo];
+            for (op = 0; op < NAND_UTIL_OPS; op++)
+            {
+                dieUtil->busyTicks[op] = 0;
+                dieUtil->opCnt[op]     = 0;
+            }
+            dieUtil->waitTicks      = 0;
+            dieUtil->waitCnt        = 0;
+            dieUtil->depthSum       = 0;
+            dieUtil->depthSampleCnt = 0;
+            dieUtil->maxDepth       = 0;
+
+            if (dieUtil->busyOp != NAND_UTIL_OP_NONE)
+                dieUtil->busyStartTick = nandUtilStartTick;
+            if (dieUtil->listed)
+                dieUtil->listedTick = nandUtilStartTick;
+        }
+}
+
+#if (NAND_UTIL_STAT)
+/**
+ * @brief Start the busy time of a die for the operation of the given request.
+ *
+ * @param reqSlotTag the request pool entry index of the request to be issued.
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ */
+static void BeginNandDieBusy(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo)
+{
+    P_NAND_DIE_UTIL_STAT dieUtil = &nandDieUtilStat[chNo][wayNo];
+    unsigned int depth           = nandReqQ[chNo][wayNo].reqCnt;
+
+    XTime_GetTime(&dieUtil->busyStartTick);
+
+    if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ))
+        dieUtil->busyOp = NAND_UTIL_OP_READ;
+    else if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ_TRANSFER))
+        dieUtil->busyOp = NAND_UTIL_OP_TRANSFER;
+    else if (REQ_CODE_IS(reqSlotTag, REQ_CODE_WRITE))
+        dieUtil->busyOp = NAND_UTIL_OP_PROGRAM;
+    else if (REQ_CODE_IS(reqSlotTag, REQ_CODE_ERASE))
+        dieUtil->busyOp = NAND_UTIL_OP_ERASE;
+    else
+        dieUtil->busyOp = NAND_UTIL_OP_OTHER;
+
+    if (dieUtil->listed)
+    {
+        dieUtil->waitTicks += dieUtil->busyStartTick - dieUtil->listedTick;
+        dieUtil->waitCnt++;
+        dieUtil->listed = 0;
+    }
+
+    dieUtil->depthSum += depth;
+    dieUtil->depthSampleCnt++;
+    if (depth > dieUtil->maxDepth)
+        dieUtil->maxDepth = depth;
+}
+
+/**
+ * @brief Stop the busy time of a die and account it to its operation.
+ *
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ */
+static void EndNandDieBusy(unsigned int chNo, unsigned int wayNo)
+{
+    P_NAND_DIE_UTIL_STAT dieUtil = &nandDieUtilStat[chNo][wayNo];
+    unsigned int op              = dieUtil->busyOp;
+    XTime now;
+
+    if (op == NAND_UTIL_OP_NONE)
+        return;
+
+#if (NAND_READ_RETRY)
+    // the read was preceded by setting the read level, check `SetNandReadRetryLevel()`
+    if (nandReadRetryTable[chNo][wayNo].levelSetting)
+        op = NAND_UTIL_OP_OTHER;
+#endif
+
+    XTime_GetTime(&now);
+    dieUtil->busyTicks[op] += now - dieUtil->busyStartTick;
+    dieUtil->opCnt[op]++;
+    dieUtil->busyOp = NAND_UTIL_OP_NONE;
+}
+#endif
+
+#if (NAND_READ_PRIORITY || NAND_REQ_DEADLINE || NAND_SUSPEND)
+/**
+ * @brief Get the block number of the given NAND request.
+ *
+ * @note The returned block number is virtual for VSA requests and physical for the others,
+ * the caller should compare the `nandAddr` and `blockSpace` options as well.
+ *
+ * @param reqSlotTag the request pool entry index of the NAND request.
+ * @return unsigned int the block number of the request.
+ */
+static unsigned int GetNandReqBlockNo(unsigned int reqSlotTag)
+{
+    if (REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr == REQ_OPT_NAND_ADDR_VSA)
+        return Vsa2VblockTranslation(REQ_VSA(reqSlotTag));
+
+    return REQ_NAND_INFO(reqSlotTag).physicalBlock;
+}
+
+/**
+ * @brief Check if the given request can be issued ahead of the older requests on its die.
+ *
+ * `CheckRowAddrDep()` allows a read to enter `nandReqQ` as soon as the program of its page
+ * is queued, so a request must not overtake any older request on the same block unless
+ * both of them are reads. The requests with different address formats are conservatively
+ * regarded as conflicts.
+ *
+ * @param promoteReqSlotTag the request pool entry index of the request to be promoted.
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ * @return unsigned int 1 if the request can be promoted, otherwise 0.
+ */
+static unsigned int CheckNandReqOvertake(unsigned int promoteReqSlotTag, unsigned int chNo, unsigned int wayNo)
+{
+    P_REQ_OPTION promoteOpt = &REQ_ENTRY(promoteReqSlotTag)->reqOpt;
+    unsigned int reqSlotTag, blockNo, isRead;
+
+    blockNo = GetNandReqBlockNo(promoteReqSlotTag);
+    isRead  = REQ_CODE_IS(promoteReqSlotTag, REQ_CODE_READ);
+    for (reqSlotTag = nandReqQ[chNo][wayNo].headReq; reqSlotTag != promoteReqSlotTag;
+         reqSlotTag = REQ_ENTRY(reqSlotTag)->nextReq)
+    {
+        if (isRead && REQ_CODE_IS(reqSlotTag, REQ_CODE_READ))
+            continue;
+
+        if (REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr != promoteOpt->nandAddr ||
+            REQ_ENTRY(reqSlotTag)->reqOpt.blockSpace != promoteOpt->blockSpace ||
+            GetNandReqBlockNo(reqSlotTag) == blockNo)
+            return 0;
+    }
+
+    return 1;
+}
+#endif
+
+#if (NAND_REQ_DEADLINE)
+/**
+ * @brief Get how long the given NAND request has been waiting beyond its deadline.
+ *
+ * @param reqSlotTag the request pool entry index of the NAND request.
+ * @param now the current time.
+ * @return long long the lateness in timer ticks, negative if the deadline is not missed.
+ */
+static long long GetNandReqLateness(unsigned int reqSlotTag, XTime now)
+{
+    XTime deadline = nandReqDeadline[GetNandReqClass(reqSlotTag)];
+
+    if (deadline == 0)
+        return -1;
+
+    return (long long)(now - REQ_CREATE_TICK(reqSlotTag)) - (long long)deadline;
+}
+
+/**
+ * @brief Move the queued request that missed its deadline the most to the head.
+ *
+ * The head request is only preempted if it is a program, an erase or a read not triggered
+ * yet, and a request is promoted only if it is later than the head.
+ *
+ * @param chNo the channel number of the idle die.
+ * @param wayNo the way number of the idle die.
+ * @return unsigned int 1 if a request was promoted, otherwise 0.
+ */
+static unsigned int PromoteNandReqByDeadline(unsigned int chNo, unsigned int wayNo)
+{
+    unsigned int headReq, reqSlotTag, promoteReq, depth;
+    long long lateness, maxLateness;
+    XTime now;
+
+    headReq = nandReqQ[chNo][wayNo].headReq;
+    if (!REQ_CODE_IS(headReq, REQ_CODE_READ) && !REQ_CODE_IS(headReq, REQ_CODE_WRITE) &&
+        !REQ_CODE_IS(headReq, REQ_CODE_ERASE))
+        return 0;
+
+    XTime_GetTime(&now);
+    maxLateness = GetNandReqLateness(headReq, now);
+    if (maxLateness < 0)
+        maxLateness = 0;
+
+    promoteReq = REQ_SLOT_TAG_NONE;
+    reqSlotTag = REQ_ENTRY(headReq)->nextReq;
+    for (depth = 1; reqSlotTag != REQ_SLOT_TAG_NONE && depth < NAND_READ_PRIO_SCAN_DEPTH;
+         depth++, reqSlotTag = REQ_ENTRY(reqSlotTag)->nextReq)
+    {
+        lateness = GetNandReqLateness(reqSlotTag, now);
+        if (lateness <= maxLateness || !CheckNandReqOvertake(reqSlotTag, chNo, wayNo))
+            continue;
+
+        maxLateness = lateness;
+        promoteReq  = reqSlotTag;
+    }
+
+    if (promoteReq == REQ_SLOT_TAG_NONE)
+        return 0;
+
+    MoveToNandReqQHead(promoteReq, chNo, wayNo);
+    nandReqDeadlineStat.promotedCnt[GetNandReqClass(promoteReq)]++;
+
+    return 1;
+}
+#endif
+
+#if (NAND_READ_PRIORITY)
+/**
+ * @brief Move a queued read ahead of the program or erase at the head.
+ *
+ * @param chNo the channel number of the idle die.
+ * @param wayNo the way number of the idle die.
+ */
+static void PromoteNandReadReq(unsigned int chNo, unsigned int wayNo)
+{
+    unsigned int headReq, reqSlotTag, depth;
+
+    headReq = nandReqQ[chNo][wayNo].headReq;
+    if (!REQ_CODE_IS(headReq, REQ_CODE_WRITE) && !REQ_CODE_IS(headReq, REQ_CODE_ERASE))
+        return;
+
+    // the waiting program or erase reached the bound, issue it now
+    if (readOvertakeCnt[chNo][wayNo] >= NAND_READ_PRIO_MAX_OVERTAKE)
+    {
+        readOvertakeCnt[chNo][wayNo] = 0;
+        nandReadPrioStat.starvationCnt++;
+        return;
+    }
+
+    reqSlotTag = REQ_ENTRY(headReq)->nextReq;
+    for (depth = 1; reqSlotTag != REQ_SLOT_TAG_NONE && depth < NAND_READ_PRIO_SCAN_DEPTH;
+         depth++, reqSlotTag = REQ_ENTRY(reqSlotTag)->nextReq)
+    {
+        if (!REQ_CODE_IS(reqSlotTag, REQ_CODE_READ))
+            continue;
+
+        if (!CheckNandReqOvertake(reqSlotTag, chNo, wayNo))
+        {
+            nandReadPrioStat.conflictCnt++;
+            continue;
+        }
+
+        MoveToNandReqQHead(reqSlotTag, chNo, wayNo);
+        readOvertakeCnt[chNo][wayNo]++;
+        nandReadPrioStat.promotedCnt++;
+        return;
+    }
+
+    // no read can be promoted, the program or erase goes first
+    readOvertakeCnt[chNo][wayNo] = 0;
+}
+#endif
+
+/**
+ * @brief Reorder the `nandReqQ` of an idle die before it is put to the way priority table.
+ *
+ * A request that missed its deadline is promoted first, otherwise a read may overtake the
+ * program or erase at the head. A head that is being retried or a read being transferred
+ * is never preempted, since the retry counter of the die belongs to the head, and nothing
+ * is reordered while a program or erase is suspended on the die or the die is in a cache
+ * read or program sequence.
+ *
+ * @sa `NAND_REQ_DEADLINE`, `NAND_READ_PRIORITY`.
+ *
+ * @param chNo the channel number of the idle die.
+ * @param wayNo the way number of the idle die.
+ */
+void PromoteNandReq(unsigned int chNo, unsigned int wayNo)
+{
+    // the head is being retried
+    if (retryLimitTablePtr->retryLimit[chNo][wayNo] != RETRY_LIMIT)
+        return;
+
+#if (NAND_CACHE_OPS)
+    // the head was already started by the previous cache operation
+    if (nandCacheTable[chNo][wayNo].cacheOp != NAND_CACHE_OP_NONE)
+        return;
+#endif
+
+#if (NAND_SUSPEND)
+    // only the head read can be served while a program or erase is suspended
+    if (nandSuspendTable[chNo][wayNo].suspendedReq != REQ_SLOT_TAG_NONE)
+        return;
+#endif
+
+#if (NAND_REQ_DEADLINE)
+    if (PromoteNandReqByDeadline(chNo, wayNo))
+        return;
+#endif
+
+#if (NAND_READ_PRIORITY)
+    PromoteNandReadReq(chNo, wayNo);
+#endif
+}
+
+#if (NAND_SUSPEND)
+/**
+ * @brief Suspend the program or erase running on the die if a host read is waiting.
+ *
+ * The read must not touch the block of the suspended operation or of any other request
+ * ahead of it. The die stays in the `statusCheck` list until the suspension completes,
+ * then `ExecuteNandReq()` moves the read to the head.
+ *
+ * @sa `NAND_SUSPEND`.
+ *
+ * @param chNo the channel number of the busy die.
+ * @param wayNo the way number of the busy die.
+ * @return unsigned int 1 if a suspend command was issued, otherwise 0.
+ */
+static unsigned int TrySuspendNandReq(unsigned int chNo, unsigned int wayNo)
+{
+    P_NAND_SUSPEND_ENTRY suspendEntry = &nandSuspendTable[chNo][wayNo];
+    unsigned int headReq, reqSlotTag, depth;
+
+    headReq = nandReqQ[chNo][wayNo].headReq;
+    if (dieStateTablePtr->dieState[chNo][wayNo].dieState != DIE_STATE_EXE)
+        return 0;
+#if (NAND_MULTI_PLANE)
+    if (nandPlanePairedReq[chNo][wayNo] != REQ_SLOT_TAG_NONE)
+        return 0;
+#endif
+#if (NAND_CACHE_OPS)
+    if (nandCacheTable[chNo][wayNo].cacheOp != NAND_CACHE_OP_NONE)
+        return 0;
+#endif
+    if (!REQ_CODE_IS(headReq, REQ_CODE_ERASE) && !(NAND_SUSPEND_PROGRAM && REQ_CODE_IS(headReq, REQ_CODE_WRITE)))
+        return 0;
+
+    reqSlotTag = REQ_ENTRY(headReq)->nextReq;
+    for (depth = 1; reqSlotTag != REQ_SLOT_TAG_NONE && depth < NAND_READ_PRIO_SCAN_DEPTH;
+         depth++, reqSlotTag = REQ_ENTRY(reqSlotTag)->nextReq)
+        if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ) && GetNandReqClass(reqSlotTag) == NAND_REQ_CLASS_HOST_READ &&
+            CheckNandReqOvertake(reqSlotTag, chNo, wayNo))
+            break;
+
+    if (reqSlotTag == REQ_SLOT_TAG_NONE || depth == NAND_READ_PRIO_SCAN_DEPTH)
+        return 0;
+
+    if (suspendEntry->suspendCnt >= NAND_SUSPEND_MAX_PER_OP)
+    {
+        // only count once for each operation
+        if (suspendEntry->suspendCnt == NAND_SUSPEND_MAX_PER_OP)
+        {
+            suspendEntry->suspendCnt++;
+            nandSuspendStat.limitCnt++;
+        }
+        return 0;
+    }
+
+    V2FSuspendAsync(&chCtlReg[chNo], wayNo);
+
+    suspendEntry->suspendedReq = headReq;
+    suspendEntry->readReq      = reqSlotTag;
+    suspendEntry->suspendCnt++;
+    dieStateTablePtr->dieState[chNo][wayNo].dieState = DIE_STATE_SUSPENDING;
+    nandSuspendStat.suspendCnt++;
+
+    return 1;
+}
+#endif
+
+/**
+ * @brief Issue the commands of the ways in the die state lists by the flash operation priority.
+ *
+ * Each status check, read trigger, read transfer, program and erase takes one slot of the
+ * command queue of the channel controller, and the free slots are counted once before
+ * issuing, so several ways can be served in one pass without polling the controller after
+ * each command.
+ *
+ * @note The way is moved to another list after its command is issued, so the next way must
+ * be saved before that.
+ *
+ * @param chNo the channel number for scheduling
+ * @param cmdSlots the number of commands that can be issued
+ * @return unsigned int the number of remaining slots.
+ */
+static unsigned int IssueNandReqPerCh(unsigned int chNo, unsigned int cmdSlots)
+{
+    unsigned int readyBusy, wayNo, nextWay;
+
+    if (wayPriorityTablePtr->wayPriority[chNo].statusCheckHead != WAY_NONE)
+    {
+        readyBusy = V2FReadyBusyAsync(&chCtlReg[chNo]);
+        wayNo     = wayPriorityTablePtr->wayPriority[chNo].statusCheckHead;
+
+        while (wayNo != WAY_NONE)
+        {
+            nextWay = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
+
+            if (V2FWayReady(readyBusy, wayNo)) // TODO why this need?
+            {
+                // FIXME: called again in second stage status check?? redundant?
+                CheckReqStatus(chNo, wayNo);
+
+                SelectiveGetFromNandStatusCheckList(chNo, wayNo);
+                PutToNandStatusReportList(chNo, wayNo);
+
+                if (--cmdSlots == 0)
+                    return 0;
+            }
+#if (NAND_SUSPEND)
+            else if (TrySuspendNandReq(chNo, wayNo) && --cmdSlots == 0)
+                return 0;
+#endif
+
+            wayNo = nextWay;
+        }
+    }
+    if (wayPriorityTablePtr->wayPriority[chNo].readTriggerHead != WAY_NONE)
+    {
+        wayNo = wayPriorityTablePtr->wayPriority[chNo].readTriggerHead;
+
+        while (wayNo != WAY_NONE)
+        {
+            nextWay = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
+
+            ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
+
+            SelectiveGetFromNandReadTriggerList(chNo, wayNo);
+            PutToNandStatusCheckList(chNo, wayNo);
+
+            if (--cmdSlots == 0)
+                return 0;
+
+            wayNo = nextWay;
+        }
+    }
+
+#if (NAND_READ_PRIORITY)
+    // the read data are waiting in the page registers, transfer them before programs
+    cmdSlots = IssueNandReadTransferReqs(chNo, cmdSlots);
+    if (cmdSlots == 0)
+        return 0;
+#endif
+
+    if (wayPriorityTablePtr->wayPriority[chNo].eraseHead != WAY_NONE)
+    {
+        wayNo = wayPriorityTablePtr->wayPriority[chNo].eraseHead;
+
+        while (wayNo != WAY_NONE)
+        {
+            nextWay = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
+
+            ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
+
+            SelectiveGetFromNandEraseList(chNo, wayNo);
+            PutToNandStatusCheckList(chNo, wayNo);
+
+            if (--cmdSlots == 0)
+                return 0;
+
+            wayNo = nextWay;
+        }
+    }
+    if (wayPriorityTablePtr->wayPriority[chNo].writeHead != WAY_NONE)
+    {
+        wayNo = wayPriorityTablePtr->wayPriority[chNo].writeHead;
+
+        while (wayNo != WAY_NONE)
+        {
+            nextWay = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
+
+            ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
+
+            SelectiveGetFromNandWriteList(chNo, wayNo);
+            PutToNandStatusCheckList(chNo, wayNo);
+
+            if (--cmdSlots == 0)
+                return 0;
+
+            wayNo = nextWay;
+        }
+    }
+
+#if (NAND_READ_PRIORITY == 0)
+    cmdSlots = IssueNandReadTransferReqs(chNo, cmdSlots);
+#endif
+
+    return cmdSlots;
 }
 
 /**
@@ -210,7 +963,23 @@ void SchedulingNandReq()
  */
 void SchedulingNandReqPerCh(unsigned int chNo)
 {
-    unsigned int readyBusy, wayNo, reqStatus, nextWay, waitWayCnt;
+    unsigned int readyBusy, wayNo, reqStatus, nextWay, waitWayCnt, cmdSlots, issuedCmdCnt;
+#if (NAND_SCHED_EVENT)
+    unsigned int pendingWays;
+
+    pendingWays             = nandWayPendingMap[chNo];
+    nandWayPendingMap[chNo] = 0;
+#endif
+#if (NAND_UTIL_STAT)
+    unsigned int depth = 0;
+
+    for (wayNo = 0; wayNo < USER_WAYS; wayNo++)
+        depth += nandReqQ[chNo][wayNo].reqCnt;
+    nandChUtilStat[chNo].depthSum += depth;
+    nandChUtilStat[chNo].depthSampleCnt++;
+    if (depth > nandChUtilStat[chNo].maxDepth)
+        nandChUtilStat[chNo].maxDepth = depth;
+#endif
 
     waitWayCnt = 0;
 
@@ -226,6 +995,16 @@ void SchedulingNandReqPerCh(unsigned int chNo)
         wayNo = wayPriorityTablePtr->wayPriority[chNo].idleHead;
         while (wayNo != WAY_NONE)
         {
+#if (NAND_SCHED_EVENT)
+            // no request was queued or released on this idle way since the last visit
+            if (!(pendingWays & (1 << wayNo)))
+            {
+                wayNo = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
+                waitWayCnt++;
+                continue;
+            }
+#endif
+
             /**
              * Currently no available requests should be executed on this way, but there
              * may be some requests in the `blockedByRowAddrDepReqQ` instead. Try to
@@ -248,6 +1027,7 @@ void SchedulingNandReqPerCh(unsigned int chNo)
             {
                 nextWay = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
                 SelectivGetFromNandIdleList(chNo, wayNo);
+                PromoteNandReq(chNo, wayNo);
                 PutToNandWayPriorityTable(nandReqQ[chNo][wayNo].headReq, chNo, wayNo);
                 wayNo = nextWay;
             }
@@ -305,7 +1085,10 @@ void SchedulingNandReqPerCh(unsigned int chNo)
                         ReleaseBlockedByRowAddrDepReq(chNo, wayNo);
 
                     if (nandReqQ[chNo][wayNo].headReq != REQ_SLOT_TAG_NONE)
+                    {
+                        PromoteNandReq(chNo, wayNo);
                         PutToNandWayPriorityTable(nandReqQ[chNo][wayNo].headReq, chNo, wayNo);
+                    }
                     else
                     {
                         PutToNandIdleList(chNo, wayNo);
@@ -360,11 +1143,11 @@ void SchedulingNandReqPerCh(unsigned int chNo)
      * therefore DO NOT break the order of these 'if' conditions as long as there is no
      * need to adjust the priority of flash operations.
      *
-     * If there is at least one request should be scheduled and their ways and the channel
-     * is not busy, we can issue the requests by calling `ExecuteNandReq()`.
-     *
-     * @note Since some request may make the channel controller busy, we should skip the
-     * remaining requests right away as the channel become busy.
+     * If there is at least one request should be scheduled and the command queue of the
+     * channel controller is not full, we can issue the requests by calling
+     * `IssueNandReqPerCh()`, which fills the free slots of the controller queue with the
+     * commands of different ways (up to `NAND_CH_CMDS_PER_PASS`), e.g. a read trigger for
+     * one way, and status checks and data transfers for the others.
      *
      * After the command is issued, we should move the die to the state list `statusCheck`
      * or `statusReport` based on the request type:
@@ -400,100 +1183,33 @@ void SchedulingNandReqPerCh(unsigned int chNo)
      *      @warning here should second stage status check
      */
     if (waitWayCnt != USER_WAYS)
-        if (!V2FIsControllerBusy(&chCtlReg[chNo]))
-        {
-            if (wayPriorityTablePtr->wayPriority[chNo].statusCheckHead != WAY_NONE)
-            {
-                readyBusy = V2FReadyBusyAsync(&chCtlReg[chNo]);
-                wayNo     = wayPriorityTablePtr->wayPriority[chNo].statusCheckHead;
-
-                while (wayNo != WAY_NONE)
-                {
-                    if (V2FWayReady(readyBusy, wayNo)) // TODO why this need?
-                    {
-                        // FIXME: called again in second stage status check?? redundant?
-                        reqStatus = CheckReqStatus(chNo, wayNo);
-
-                        SelectiveGetFromNandStatusCheckList(chNo, wayNo);
-                        PutToNandStatusReportList(chNo, wayNo);
-
-                        if (V2FIsControllerBusy(&chCtlReg[chNo]))
-                            return;
-                    }
-
-                    wayNo = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
-                }
-            }
-            if (wayPriorityTablePtr->wayPriority[chNo].readTriggerHead != WAY_NONE)
-            {
-                wayNo = wayPriorityTablePtr->wayPriority[chNo].readTriggerHead;
-
-                while (wayNo != WAY_NONE)
-                {
-                    ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
-
-                    SelectiveGetFromNandReadTriggerList(chNo, wayNo);
-                    PutToNandStatusCheckList(chNo, wayNo);
-
-                    if (V2FIsControllerBusy(&chCtlReg[chNo]))
-                        return;
-
-                    wayNo = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
-                }
-            }
-
-            if (wayPriorityTablePtr->wayPriority[chNo].eraseHead != WAY_NONE)
-            {
-                wayNo = wayPriorityTablePtr->wayPriority[chNo].eraseHead;
-
-                while (wayNo != WAY_NONE)
-                {
-                    ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
-
-                    SelectiveGetFromNandEraseList(chNo, wayNo);
-                    PutToNandStatusCheckList(chNo, wayNo);
-
-                    if (V2FIsControllerBusy(&chCtlReg[chNo]))
-                        return;
+    {
+        cmdSlots = V2FGetFreeQueueCount(&chCtlReg[chNo]);
+        if (cmdSlots > NAND_CH_CMDS_PER_PASS)
+            cmdSlots = NAND_CH_CMDS_PER_PASS;
 
-                    wayNo = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
-                }
-            }
-            if (wayPriorityTablePtr->wayPriority[chNo].writeHead != WAY_NONE)
+        if (cmdSlots)
+        {
+            issuedCmdCnt = cmdSlots - IssueNandReqPerCh(chNo, cmdSlots);
+            if (issuedCmdCnt)
             {
-                wayNo = wayPriorityTablePtr->wayPriority[chNo].writeHead;
-
-                while (wayNo != WAY_NONE)
-                {
-                    ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
-
-                    SelectiveGetFromNandWriteList(chNo, wayNo);
-                    PutToNandStatusCheckList(chNo, wayNo);
-
-                    if (V2FIsControllerBusy(&chCtlReg[chNo]))
-                        return;
-
-                    wayNo = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
-                }
-            }
-            if (wayPriorityTablePtr->wayPriority[chNo].readTransferHead != WAY_NONE)
-            {
-                wayNo = wayPriorityTablePtr->wayPriority[chNo].readTransferHead;
-
-                while (wayNo != WAY_NONE)
-                {
-                    ExecuteNandReq(chNo, wayNo, REQ_STATUS_RUNNING);
-
-                    SelectiveGetFromNandReadTransferList(chNo, wayNo);
-                    PutToNandStatusReportList(chNo, wayNo);
-
-                    if (V2FIsControllerBusy(&chCtlReg[chNo]))
-                        return;
-
-                    wayNo = dieStateTablePtr->dieState[chNo][wayNo].nextWay;
-                }
+                nandChIssueStat[chNo].passCnt++;
+                nandChIssueStat[chNo].cmdCnt += issuedCmdCnt;
+                if (issuedCmdCnt > nandChIssueStat[chNo].maxCmdsPerPass)
+                    nandChIssueStat[chNo].maxCmdsPerPass = issuedCmdCnt;
+                if (issuedCmdCnt == cmdSlots)
+                    nandChIssueStat[chNo].slotsExhaustedCnt++;
             }
         }
+        else
+            nandChIssueStat[chNo].queueFullCnt++;
+    }
+
+#if (NAND_SCHED_EVENT)
+    // nothing in flight and nothing to schedule, skip this channel until new requests come
+    if (!nandWayPendingMap[chNo] && IsNandChIdle(chNo))
+        nandChPendingMap &= ~(1 << chNo);
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -510,6 +1226,11 @@ void SchedulingNandReqPerCh(unsigned int chNo)
  */
 void PutToNandWayPriorityTable(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo)
 {
+#if (NAND_UTIL_STAT)
+    XTime_GetTime(&nandDieUtilStat[chNo][wayNo].listedTick);
+    nandDieUtilStat[chNo][wayNo].listed = 1;
+#endif
+
     if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_READ)
         PutToNandReadTriggerList(chNo, wayNo);
     else if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_READ_TRANSFER)
@@ -978,6 +1699,193 @@ void SelectiveGetFromNandStatusCheckList(unsigned int chNo, unsigned int wayNo)
 /*                end of functions for managing die state lists               */
 /* -------------------------------------------------------------------------- */
 
+#if (NAND_MULTI_PLANE)
+/**
+ * @brief Find the request that can be issued together with the head by a multi-plane command.
+ *
+ * Only the request right behind the head is checked, so the pair always leaves the queue
+ * in order. Reads being retried and raw reads are not paired.
+ *
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ * @param rowAddr the row address of the head request.
+ * @return unsigned int the request pool index of the paired request, or `REQ_SLOT_TAG_NONE`.
+ */
+static unsigned int GetNandReqPlanePair(unsigned int chNo, unsigned int wayNo, unsigned int rowAddr)
+{
+    unsigned int headReq, reqSlotTag, pairedRowAddr;
+
+    headReq    = nandReqQ[chNo][wayNo].headReq;
+    reqSlotTag = REQ_ENTRY(headReq)->nextReq;
+    if (reqSlotTag == REQ_SLOT_TAG_NONE || REQ_ENTRY(reqSlotTag)->reqCode != REQ_ENTRY(headReq)->reqCode)
+        return REQ_SLOT_TAG_NONE;
+
+    if (REQ_CODE_IS(headReq, REQ_CODE_READ))
+    {
+        if (retryLimitTablePtr->retryLimit[chNo][wayNo] != RETRY_LIMIT ||
+            REQ_ENTRY(headReq)->reqOpt.nandEcc != REQ_OPT_NAND_ECC_ON ||
+            REQ_ENTRY(reqSlotTag)->reqOpt.nandEcc != REQ_OPT_NAND_ECC_ON)
+            return REQ_SLOT_TAG_NONE;
+    }
+    else if (!REQ_CODE_IS(headReq, REQ_CODE_WRITE) && !REQ_CODE_IS(headReq, REQ_CODE_ERASE))
+        return REQ_SLOT_TAG_NONE;
+
+    // same LUN, same page offset, different planes
+    pairedRowAddr = GenerateNandRowAddr(reqSlotTag);
+    if ((rowAddr / LUN_1_BASE_ADDR) != (pairedRowAddr / LUN_1_BASE_ADDR) ||
+        (rowAddr % PAGES_PER_MLC_BLOCK) != (pairedRowAddr % PAGES_PER_MLC_BLOCK) ||
+        Pblock2PlaneTranslation((rowAddr % LUN_1_BASE_ADDR) / PAGES_PER_MLC_BLOCK) ==
+            Pblock2PlaneTranslation((pairedRowAddr % LUN_1_BASE_ADDR) / PAGES_PER_MLC_BLOCK))
+        return REQ_SLOT_TAG_NONE;
+
+    return reqSlotTag;
+}
+
+/**
+ * @brief Issue the head request and the given paired request by a multi-plane command.
+ *
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ * @param pairedReq the request pool index of the paired request.
+ */
+static void IssueNandMultiPlaneReq(unsigned int chNo, unsigned int wayNo, unsigned int pairedReq)
+{
+    unsigned int reqSlotTag[V2F_MULTI_PLANES], rowAddr[V2F_MULTI_PLANES];
+    void *dataBufAddr[V2F_MULTI_PLANES];
+    void *spareDataBufAddr[V2F_MULTI_PLANES];
+    unsigned int plane, headPlane;
+
+    // the command takes the rows in plane order
+    headPlane = Pblock2PlaneTranslation(
+        (GenerateNandRowAddr(nandReqQ[chNo][wayNo].headReq) % LUN_1_BASE_ADDR) / PAGES_PER_MLC_BLOCK);
+    reqSlotTag[headPlane]     = nandReqQ[chNo][wayNo].headReq;
+    reqSlotTag[headPlane ^ 1] = pairedReq;
+
+    for (plane = 0; plane < V2F_MULTI_PLANES; plane++)
+    {
+        rowAddr[plane]          = GenerateNandRowAddr(reqSlotTag[plane]);
+        dataBufAddr[plane]      = (void *)GenerateDataBufAddr(reqSlotTag[plane]);
+        spareDataBufAddr[plane] = (void *)GenerateSpareDataBufAddr(reqSlotTag[plane]);
+    }
+
+    dieStateTablePtr->dieState[chNo][wayNo].reqStatusCheckOpt = REQ_STATUS_CHECK_OPT_CHECK;
+    nandPlanePairedReq[chNo][wayNo]                           = pairedReq;
+
+    if (REQ_CODE_IS(pairedReq, REQ_CODE_READ))
+    {
+        V2FReadPageTriggerMultiPlaneAsync(&chCtlReg[chNo], wayNo, rowAddr);
+        nandMultiPlaneStat.readCnt++;
+    }
+    else if (REQ_CODE_IS(pairedReq, REQ_CODE_WRITE))
+    {
+        V2FProgramPageMultiPlaneAsync(&chCtlReg[chNo], wayNo, rowAddr, dataBufAddr, spareDataBufAddr);
+        nandMultiPlaneStat.programCnt++;
+    }
+    else
+    {
+        V2FEraseBlockMultiPlaneAsync(&chCtlReg[chNo], wayNo, rowAddr);
+        nandMultiPlaneStat.eraseCnt++;
+    }
+
+    RecordNandReqDelay(pairedReq);
+#if (NAND_CACHE_OPS)
+    // a multi-plane program ends the cache program sequence
+    nandCacheTable[chNo][wayNo].cacheOp = NAND_CACHE_OP_NONE;
+#endif
+}
+#endif
+
+#if (NAND_CACHE_OPS)
+/**
+ * @brief Trigger the next read of the die by a cache read before the transfer of the head.
+ *
+ * If the request behind the head read transfer is also a read, the page of the head is
+ * moved to the cache register and the array read of the next read starts right away.
+ * Otherwise, the cache read mode is left if the page of the head was read by a cache read.
+ *
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ * @param rowAddr the row address of the head read transfer.
+ */
+static void IssueNandCacheReadReq(unsigned int chNo, unsigned int wayNo, unsigned int rowAddr)
+{
+    P_NAND_CACHE_ENTRY cacheEntry = &nandCacheTable[chNo][wayNo];
+    unsigned int headReq, reqSlotTag, nextRowAddr, sequential;
+
+    headReq    = nandReqQ[chNo][wayNo].headReq;
+    reqSlotTag = REQ_ENTRY(headReq)->nextReq;
+
+    if (reqSlotTag != REQ_SLOT_TAG_NONE && REQ_CODE_IS(reqSlotTag, REQ_CODE_READ) &&
+        REQ_ENTRY(headReq)->reqOpt.nandEcc == REQ_OPT_NAND_ECC_ON &&
+        REQ_ENTRY(reqSlotTag)->reqOpt.nandEcc == REQ_OPT_NAND_ECC_ON)
+    {
+        nextRowAddr = GenerateNandRowAddr(reqSlotTag);
+        sequential  = (nextRowAddr == rowAddr + 1) && (nextRowAddr % PAGES_PER_MLC_BLOCK);
+
+        V2FReadPageCacheAsync(&chCtlReg[chNo], wayNo, nextRowAddr, sequential);
+        cacheEntry->cachedReq = reqSlotTag;
+        cacheEntry->cacheOp   = NAND_CACHE_OP_READ;
+        RecordNandReqDelay(reqSlotTag);
+
+        if (sequential)
+            nandCacheStat.seqReadCnt++;
+        else
+            nandCacheStat.randomReadCnt++;
+    }
+    else if (cacheEntry->cacheOp == NAND_CACHE_OP_READ)
+    {
+        V2FReadPageCacheEndAsync(&chCtlReg[chNo], wayNo);
+        cacheEntry->cacheOp = NAND_CACHE_OP_NONE;
+    }
+}
+#endif
+
+#if (NAND_READ_RETRY)
+/**
+ * @brief Set the read level of the die for the head read if the die is at another level.
+ *
+ * The first read of a block starts from the level that worked last time on the block, and
+ * each retry moves to the next level, check `NAND_READ_RETRY` for details.
+ *
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ * @param rowAddr the row address of the head read.
+ * @return unsigned int 1 if the die is busy with setting the level, 0 if the read can be
+ * triggered right away.
+ */
+static unsigned int SetNandReadRetryLevel(unsigned int chNo, unsigned int wayNo, unsigned int rowAddr)
+{
+    P_NAND_READ_RETRY_ENTRY retryEntry = &nandReadRetryTable[chNo][wayNo];
+    unsigned int histLevel, level;
+
+    histLevel = readRetryHistoryTablePtr->level[chNo][wayNo][ROW_ADDR_TO_PBLOCK(rowAddr)];
+    level     = (histLevel + RETRY_LIMIT - retryLimitTablePtr->retryLimit[chNo][wayNo]) % NAND_READ_RETRY_LEVELS;
+
+    if (level != retryEntry->curLevel)
+    {
+        readRetryPayLoadTablePtr->payload[chNo][wayNo] = nandReadRetryLevel[level];
+        V2FSetReadRetryAsync(&chCtlReg[chNo], wayNo, &readRetryPayLoadTablePtr->payload[chNo][wayNo]);
+
+        retryEntry->curLevel     = level;
+        retryEntry->levelSetting = 1;
+        nandReadRetryStat.levelSetCnt++;
+        return 1;
+    }
+
+    retryEntry->levelSet = 0;
+    if (retryLimitTablePtr->retryLimit[chNo][wayNo] == RETRY_LIMIT)
+    {
+        nandReadRetryStat.readCnt++;
+        if (histLevel)
+            nandReadRetryStat.historyCnt++;
+    }
+    else
+        nandReadRetryStat.retryCnt++;
+
+    return 0;
+}
+#endif
+
 /**
  * @brief Issue a flash operations to the storage controller.
  *
@@ -1017,9 +1925,44 @@ void IssueNandReq(unsigned int chNo, unsigned int wayNo)
     void *spareDataBufAddr;
     unsigned int *errorInfo;
     unsigned int *completion;
+#if (NAND_MULTI_PLANE)
+    unsigned int pairedReq;
+#endif
+#if (NAND_CACHE_OPS)
+    unsigned int nextReq;
+#endif
+
+    reqSlotTag = nandReqQ[chNo][wayNo].headReq;
+    rowAddr    = GenerateNandRowAddr(reqSlotTag);
+
+#if (NAND_CACHE_OPS)
+    // leave the cache read mode before any other operation, e.g., retrying a failed read
+    if (!REQ_CODE_IS(reqSlotTag, REQ_CODE_READ_TRANSFER) &&
+        nandCacheTable[chNo][wayNo].cacheOp == NAND_CACHE_OP_READ)
+    {
+        V2FReadPageCacheEndAsync(&chCtlReg[chNo], wayNo);
+        nandCacheTable[chNo][wayNo].cacheOp = NAND_CACHE_OP_NONE;
+    }
+#endif
+
+#if (NAND_READ_RETRY)
+    if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ) && SetNandReadRetryLevel(chNo, wayNo, rowAddr))
+    {
+        // the read will be triggered after the level is set
+        dieStateTablePtr->dieState[chNo][wayNo].reqStatusCheckOpt = REQ_STATUS_CHECK_OPT_CHECK;
+        return;
+    }
+#endif
+
+#if (NAND_MULTI_PLANE)
+    pairedReq = GetNandReqPlanePair(chNo, wayNo, rowAddr);
+    if (pairedReq != REQ_SLOT_TAG_NONE)
+    {
+        IssueNandMultiPlaneReq(chNo, wayNo, pairedReq);
+        return;
+    }
+#endif
 
-    reqSlotTag       = nandReqQ[chNo][wayNo].headReq;
-    rowAddr          = GenerateNandRowAddr(reqSlotTag);
     dataBufAddr      = (void *)GenerateDataBufAddr(reqSlotTag);
     spareDataBufAddr = (void *)GenerateSpareDataBufAddr(reqSlotTag);
 
@@ -1036,6 +1979,10 @@ void IssueNandReq(unsigned int chNo, unsigned int wayNo)
         errorInfo  = (unsigned int *)(&eccErrorInfoTablePtr->errorInfo[chNo][wayNo]);
         completion = (unsigned int *)(&completeFlagTablePtr->completeFlag[chNo][wayNo]);
 
+#if (NAND_CACHE_OPS)
+        IssueNandCacheReadReq(chNo, wayNo, rowAddr);
+#endif
+
         if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandEcc == REQ_OPT_NAND_ECC_ON)
             V2FReadPageTransferAsync(&chCtlReg[chNo], wayNo, dataBufAddr, spareDataBufAddr, errorInfo, completion,
                                      rowAddr);
@@ -1046,6 +1993,18 @@ void IssueNandReq(unsigned int chNo, unsigned int wayNo)
     {
         dieStateTablePtr->dieState[chNo][wayNo].reqStatusCheckOpt = REQ_STATUS_CHECK_OPT_CHECK;
 
+#if (NAND_CACHE_OPS)
+        // the last program of a sequence must be a normal one
+        nextReq = REQ_ENTRY(reqSlotTag)->nextReq;
+        if (nextReq != REQ_SLOT_TAG_NONE && REQ_CODE_IS(nextReq, REQ_CODE_WRITE))
+        {
+            V2FProgramPageCacheAsync(&chCtlReg[chNo], wayNo, rowAddr, dataBufAddr, spareDataBufAddr);
+            nandCacheTable[chNo][wayNo].cacheOp = NAND_CACHE_OP_PROGRAM;
+            nandCacheStat.programCnt++;
+            return;
+        }
+        nandCacheTable[chNo][wayNo].cacheOp = NAND_CACHE_OP_NONE;
+#endif
         V2FProgramPageAsync(&chCtlReg[chNo], wayNo, rowAddr, dataBufAddr, spareDataBufAddr);
     }
     else if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_ERASE)
@@ -1088,35 +2047,33 @@ unsigned int GenerateNandRowAddr(unsigned int reqSlotTag)
 
     if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_VSA)
     {
-        dieNo          = Vsa2VdieTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
-        virtualBlockNo = Vsa2VblockTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
+        dieNo          = Vsa2VdieTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
+        virtualBlockNo = Vsa2VblockTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
         phyBlockNo     = Vblock2PblockOfTbsTranslation(virtualBlockNo);
         lun            = phyBlockNo / TOTAL_BLOCKS_PER_LUN;
         tempBlockNo    = phyBlockMapPtr->phyBlock[dieNo][phyBlockNo].remappedPhyBlock % TOTAL_BLOCKS_PER_LUN;
-        tempPageNo     = Vsa2VpageTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
+        tempPageNo     = Vsa2VpageTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
 
         // if(BITS_PER_FLASH_CELL == SLC_MODE)
         //	tempPageNo = Vpage2PlsbPageTranslation(tempPageNo);
     }
     else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_PHY_ORG)
     {
-        dieNo = Pcw2VdieTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh,
-                                    reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay);
+        dieNo = Pcw2VdieTranslation(REQ_NAND_INFO(reqSlotTag).physicalCh, REQ_NAND_INFO(reqSlotTag).physicalWay);
         if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace == REQ_OPT_BLOCK_SPACE_TOTAL)
         {
-            lun         = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock / TOTAL_BLOCKS_PER_LUN;
-            tempBlockNo = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock % TOTAL_BLOCKS_PER_LUN;
-            tempPageNo  = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage;
+            lun         = REQ_NAND_INFO(reqSlotTag).physicalBlock / TOTAL_BLOCKS_PER_LUN;
+            tempBlockNo = REQ_NAND_INFO(reqSlotTag).physicalBlock % TOTAL_BLOCKS_PER_LUN;
+            tempPageNo  = REQ_NAND_INFO(reqSlotTag).physicalPage;
         }
         else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace == REQ_OPT_BLOCK_SPACE_MAIN)
         {
-            lun         = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock / MAIN_BLOCKS_PER_LUN;
-            tempBlockNo = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalBlock % MAIN_BLOCKS_PER_LUN +
-                          lun * TOTAL_BLOCKS_PER_LUN;
+            lun         = REQ_NAND_INFO(reqSlotTag).physicalBlock / MAIN_BLOCKS_PER_LUN;
+            tempBlockNo = REQ_NAND_INFO(reqSlotTag).physicalBlock % MAIN_BLOCKS_PER_LUN + lun * TOTAL_BLOCKS_PER_LUN;
 
             // phyBlock remap
             tempBlockNo = phyBlockMapPtr->phyBlock[dieNo][tempBlockNo].remappedPhyBlock % TOTAL_BLOCKS_PER_LUN;
-            tempPageNo  = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalPage;
+            tempPageNo  = REQ_NAND_INFO(reqSlotTag).physicalPage;
         }
     }
     else
@@ -1172,12 +2129,12 @@ unsigned int GenerateDataBufAddr(unsigned int reqSlotTag)
     {
         if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ENTRY)
             return (DATA_BUFFER_BASE_ADDR +
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry * BYTES_PER_DATA_REGION_OF_SLICE);
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry * BYTES_PER_DATA_REGION_OF_SLICE);
         else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_TEMP_ENTRY)
             return (TEMPORARY_DATA_BUFFER_BASE_ADDR +
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry * BYTES_PER_DATA_REGION_OF_SLICE);
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry * BYTES_PER_DATA_REGION_OF_SLICE);
         else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ADDR)
-            return reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.addr;
+            return REQ_DATA_BUF_INFO(reqSlotTag).addr;
 
         /*
          * For some requests not belongs to I/O requests, such as RESET, SET_FEATURE and
@@ -1190,8 +2147,8 @@ unsigned int GenerateDataBufAddr(unsigned int reqSlotTag)
         // similar to NAND request, but may have offset
         if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ENTRY)
             return (DATA_BUFFER_BASE_ADDR +
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry * BYTES_PER_DATA_REGION_OF_SLICE +
-                    reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.nvmeBlockOffset * BYTES_PER_NVME_BLOCK);
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry * BYTES_PER_DATA_REGION_OF_SLICE +
+                    REQ_NVME_DMA_INFO(reqSlotTag).nvmeBlockOffset * BYTES_PER_NVME_BLOCK);
         else
             assert(!"[WARNING] wrong reqOpt-dataBufFormat [WARNING]");
     }
@@ -1219,12 +2176,12 @@ unsigned int GenerateSpareDataBufAddr(unsigned int reqSlotTag)
     {
         if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ENTRY)
             return (SPARE_DATA_BUFFER_BASE_ADDR +
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry * BYTES_PER_SPARE_REGION_OF_SLICE);
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry * BYTES_PER_SPARE_REGION_OF_SLICE);
         else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_TEMP_ENTRY)
             return (TEMPORARY_SPARE_DATA_BUFFER_BASE_ADDR +
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry * BYTES_PER_SPARE_REGION_OF_SLICE);
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry * BYTES_PER_SPARE_REGION_OF_SLICE);
         else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ADDR)
-            return (reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.addr +
+            return (REQ_DATA_BUF_INFO(reqSlotTag).addr +
                     BYTES_PER_DATA_REGION_OF_SLICE); // modify PAGE_SIZE to other
 
         return (RESERVED_DATA_BUFFER_BASE_ADDR + BYTES_PER_DATA_REGION_OF_SLICE);
@@ -1233,7 +2190,7 @@ unsigned int GenerateSpareDataBufAddr(unsigned int reqSlotTag)
     {
         if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ENTRY)
             return (SPARE_DATA_BUFFER_BASE_ADDR +
-                    reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry * BYTES_PER_SPARE_REGION_OF_SLICE);
+                    REQ_DATA_BUF_INFO(reqSlotTag).entry * BYTES_PER_SPARE_REGION_OF_SLICE);
         else
             assert(!"[WARNING] wrong reqOpt-dataBufFormat [WARNING]");
     }
@@ -1317,6 +2274,95 @@ unsigned int CheckReqStatus(unsigned int chNo, unsigned int wayNo)
     return REQ_STATUS_RUNNING;
 }
 
+#if (NAND_ECC_REFRESH)
+/**
+ * @brief Get the ECC margin entry of the block accessed by the given request.
+ *
+ * @param reqSlotTag the request pool index of the NAND request.
+ * @return P_NAND_ECC_MARGIN_ENTRY the entry of the virtual block, or NULL if the request
+ * is not a VSA request of the main block space.
+ */
+static P_NAND_ECC_MARGIN_ENTRY GetEccMarginEntryOfNandReq(unsigned int reqSlotTag)
+{
+    unsigned int virtualSliceAddr;
+
+    if (REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr != REQ_OPT_NAND_ADDR_VSA ||
+        REQ_ENTRY(reqSlotTag)->reqOpt.blockSpace != REQ_OPT_BLOCK_SPACE_MAIN)
+        return NULL;
+
+    virtualSliceAddr = REQ_NAND_INFO(reqSlotTag).virtualSliceAddr;
+    return &eccMarginTablePtr->block[Vsa2VdieTranslation(virtualSliceAddr)][Vsa2VblockTranslation(virtualSliceAddr)];
+}
+
+/**
+ * @brief Queue the block accessed by the given request for refresh if it is not queued yet.
+ *
+ * @param reqSlotTag the request pool index of the NAND request.
+ * @param reason why the block should be refreshed, `NAND_REFRESH_REASON_*`.
+ */
+static void QueueEccRefreshOfNandReq(unsigned int reqSlotTag, unsigned int reason)
+{
+    P_NAND_ECC_MARGIN_ENTRY marginEntry = GetEccMarginEntryOfNandReq(reqSlotTag);
+    NAND_REFRESH_MSG msg;
+
+    if (marginEntry == NULL || marginEntry->refreshQueued)
+        return;
+
+    msg.dword   = 0;
+    msg.dieNo   = Vsa2VdieTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
+    msg.blockNo = Vsa2VblockTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
+    msg.reason  = reason;
+
+    if (!PushIpcRing(nandRefreshRingPtr, msg.dword))
+    {
+        nandEccMarginStat.ringFullCnt++;
+        return;
+    }
+
+    marginEntry->refreshQueued = 1;
+    nandEccMarginStat.queuedCnt[reason]++;
+}
+
+/**
+ * @brief Fold the bit errors of a decoded read into the ECC margin of its block.
+ *
+ * @param reqSlotTag the request pool index of the read transfer.
+ * @param bitErrCnt the bit errors of the worst chunk of the page.
+ */
+static void UpdateEccMarginOfNandReq(unsigned int reqSlotTag, unsigned int bitErrCnt)
+{
+    P_NAND_ECC_MARGIN_ENTRY marginEntry = GetEccMarginEntryOfNandReq(reqSlotTag);
+
+    if (marginEntry == NULL)
+        return;
+
+    marginEntry->errSum = marginEntry->errSum - (marginEntry->errSum >> NAND_ECC_MARGIN_AVG_SHIFT) + bitErrCnt;
+    if (bitErrCnt > marginEntry->maxErr)
+        marginEntry->maxErr = bitErrCnt;
+    nandEccMarginStat.sampleCnt++;
+
+    if ((marginEntry->errSum >> NAND_ECC_MARGIN_AVG_SHIFT) >= NAND_ECC_REFRESH_THRESHOLD)
+        QueueEccRefreshOfNandReq(reqSlotTag, NAND_REFRESH_REASON_MARGIN);
+}
+
+/**
+ * @brief Start over the ECC margin of the block erased by the given request.
+ *
+ * @param reqSlotTag the request pool index of the erase.
+ */
+static void ResetEccMarginOfNandReq(unsigned int reqSlotTag)
+{
+    P_NAND_ECC_MARGIN_ENTRY marginEntry = GetEccMarginEntryOfNandReq(reqSlotTag);
+
+    if (marginEntry == NULL)
+        return;
+
+    marginEntry->errSum        = 0;
+    marginEntry->maxErr        = 0;
+    marginEntry->refreshQueued = 0;
+}
+#endif
+
 unsigned int CheckEccErrorInfo(unsigned int chNo, unsigned int wayNo)
 {
     unsigned int errorInfo0, errorInfo1, reqSlotTag;
@@ -1329,6 +2375,9 @@ unsigned int CheckEccErrorInfo(unsigned int chNo, unsigned int wayNo)
     if (V2FCrcValid(eccErrorInfoTablePtr->errorInfo[chNo][wayNo]))
     // if (V2FPageDecodeSuccess(&eccErrorInfoTablePtr->errorInfo[chNo][wayNo][1]))
     {
+#if (NAND_ECC_REFRESH)
+        UpdateEccMarginOfNandReq(reqSlotTag, V2FWorstChunkErrorCount(&errorInfo0));
+#endif
         if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandEccWarning == REQ_OPT_NAND_ECC_WARNING_ON)
             if (V2FWorstChunkErrorCount(&errorInfo0) > BIT_ERROR_THRESHOLD_PER_CHUNK)
                 return ERROR_INFO_WARNING;
@@ -1339,6 +2388,50 @@ unsigned int CheckEccErrorInfo(unsigned int chNo, unsigned int wayNo)
     return ERROR_INFO_FAIL;
 }
 
+#if (NAND_READ_RETRY)
+/**
+ * @brief Remember the read level that worked for the block of the given read.
+ *
+ * @param reqSlotTag the request pool index of the read transfer that is done.
+ * @param chNo the channel number of the die.
+ * @param wayNo the way number of the die.
+ */
+static void RecordNandReadRetryLevel(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo)
+{
+    unsigned int phyBlockNo = ROW_ADDR_TO_PBLOCK(GenerateNandRowAddr(reqSlotTag));
+
+    readRetryHistoryTablePtr->level[chNo][wayNo][phyBlockNo] = nandReadRetryTable[chNo][wayNo].curLevel;
+    if (retryLimitTablePtr->retryLimit[chNo][wayNo] != RETRY_LIMIT)
+        nandReadRetryStat.recoveredCnt++;
+}
+#endif
+
+/**
+ * @brief Mark the block accessed by the given failed request as a grown bad block.
+ *
+ * @note Only called for the programs and erases that failed, and for the reads that still
+ * failed after all the retries.
+ *
+ * @param reqSlotTag the request pool entry index of the failed request.
+ * @param chNo the channel number of the request.
+ * @param wayNo the way number of the request.
+ */
+static void UpdateGrownBadBlockOfNandReq(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo)
+{
+    unsigned int rowAddr, phyBlockNo;
+
+    rowAddr    = GenerateNandRowAddr(reqSlotTag);
+    phyBlockNo = ROW_ADDR_TO_PBLOCK(rowAddr);
+    UpdatePhyBlockMapForGrownBadBlock(Pcw2VdieTranslation(chNo, wayNo), phyBlockNo);
+
+#if (GROWN_BAD_BLOCK_SALVAGE)
+    if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_VSA &&
+        reqPoolPtr->reqPool[reqSlotTag].reqOpt.blockSpace == REQ_OPT_BLOCK_SPACE_MAIN)
+        MarkGrownBadVirtualBlock(Vsa2VdieTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr),
+                                 Vsa2VblockTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr));
+#endif
+}
+
 /**
  * @brief Update die state and issue new NAND requests if the die is in IDLE state.
  *
@@ -1372,7 +2465,10 @@ unsigned int CheckEccErrorInfo(unsigned int chNo, unsigned int wayNo)
  *
  * - previous request is WARNING
  *
- *      This means ECC failed, report bad block then make die IDLE and reset retry count
+ *      This means the read is done but its bit errors are close to the ECC limit, queue the
+ *      block for refresh (check `NAND_ECC_REFRESH`) then make die IDLE and reset retry count.
+ *      The block is not retired, only failed programs, erases and reads that failed at all
+ *      the retries are.
  *
  * @todo bad block and ECC related handling
  *
@@ -1384,24 +2480,128 @@ unsigned int CheckEccErrorInfo(unsigned int chNo, unsigned int wayNo)
  */
 void ExecuteNandReq(unsigned int chNo, unsigned int wayNo, unsigned int reqStatus)
 {
-    unsigned int reqSlotTag, rowAddr, phyBlockNo;
+    unsigned int reqSlotTag, rowAddr;
     unsigned char *badCheck;
+#if (NAND_MULTI_PLANE)
+    unsigned int pairedReq;
+#endif
 
     reqSlotTag = nandReqQ[chNo][wayNo].headReq;
 
     switch (dieStateTablePtr->dieState[chNo][wayNo].dieState)
     {
     case DIE_STATE_IDLE:
+#if (NAND_UTIL_STAT)
+        BeginNandDieBusy(reqSlotTag, chNo, wayNo);
+#endif
+#if (NAND_CACHE_OPS)
+        if (nandCacheTable[chNo][wayNo].cachedReq == reqSlotTag)
+        {
+            // the array read was started by the cache read issued before the previous transfer
+            dieStateTablePtr->dieState[chNo][wayNo].reqStatusCheckOpt = REQ_STATUS_CHECK_OPT_CHECK;
+            dieStateTablePtr->dieState[chNo][wayNo].dieState          = DIE_STATE_EXE;
+            nandCacheTable[chNo][wayNo].cachedReq                     = REQ_SLOT_TAG_NONE;
+            break;
+        }
+#endif
+#if (NAND_SUSPEND)
+        if (nandSuspendTable[chNo][wayNo].suspendedReq == reqSlotTag)
+        {
+            // the reads are done, continue the suspended program or erase
+            V2FResumeAsync(&chCtlReg[chNo], wayNo);
+            dieStateTablePtr->dieState[chNo][wayNo].reqStatusCheckOpt = REQ_STATUS_CHECK_OPT_CHECK;
+            dieStateTablePtr->dieState[chNo][wayNo].dieState          = DIE_STATE_EXE;
+            nandSuspendTable[chNo][wayNo].suspendedReq                = REQ_SLOT_TAG_NONE;
+            nandSuspendStat.resumeCnt++;
+            break;
+        }
+        nandSuspendTable[chNo][wayNo].suspendCnt = 0;
+#endif
+        // only count the first issue, not the read transfer and the read retries
+        if (!REQ_CODE_IS(reqSlotTag, REQ_CODE_READ_TRANSFER) &&
+            retryLimitTablePtr->retryLimit[chNo][wayNo] == RETRY_LIMIT
+#if (NAND_READ_RETRY)
+            && !nandReadRetryTable[chNo][wayNo].levelSet
+#endif
+        )
+            RecordNandReqDelay(reqSlotTag);
         IssueNandReq(chNo, wayNo);
         dieStateTablePtr->dieState[chNo][wayNo].dieState = DIE_STATE_EXE;
         break;
+#if (NAND_SUSPEND)
+    case DIE_STATE_SUSPENDING:
+        if (reqStatus == REQ_STATUS_RUNNING)
+            break;
+#if (NAND_UTIL_STAT)
+        EndNandDieBusy(chNo, wayNo);
+#endif
+
+        if (reqStatus != REQ_STATUS_DONE)
+        {
+            // the operation had already failed before the suspension, handle it as usual
+            nandSuspendTable[chNo][wayNo].suspendedReq       = REQ_SLOT_TAG_NONE;
+            dieStateTablePtr->dieState[chNo][wayNo].dieState = DIE_STATE_EXE;
+            ExecuteNandReq(chNo, wayNo, reqStatus);
+            break;
+        }
+
+        /*
+         * The operation is suspended, or it had finished right before the suspension, in
+         * which case the resume command is ignored by the die and the status check after
+         * it still reports the result of the operation.
+         */
+        MoveToNandReqQHead(nandSuspendTable[chNo][wayNo].readReq, chNo, wayNo);
+        dieStateTablePtr->dieState[chNo][wayNo].dieState = DIE_STATE_IDLE;
+        break;
+#endif
     case DIE_STATE_EXE:
+#if (NAND_UTIL_STAT)
+        if (reqStatus != REQ_STATUS_RUNNING)
+            EndNandDieBusy(chNo, wayNo);
+#endif
+#if (NAND_READ_RETRY)
+        if (nandReadRetryTable[chNo][wayNo].levelSetting)
+        {
+            if (reqStatus == REQ_STATUS_RUNNING)
+                break;
+
+            // the die is unknown to be at the new level, set it again before the read
+            if (reqStatus == REQ_STATUS_FAIL)
+                nandReadRetryTable[chNo][wayNo].curLevel = NAND_READ_RETRY_LEVEL_UNKNOWN;
+
+            nandReadRetryTable[chNo][wayNo].levelSetting     = 0;
+            nandReadRetryTable[chNo][wayNo].levelSet         = 1;
+            dieStateTablePtr->dieState[chNo][wayNo].dieState = DIE_STATE_IDLE;
+            break;
+        }
+#endif
+#if (NAND_MULTI_PLANE)
+        pairedReq = nandPlanePairedReq[chNo][wayNo];
+        if (reqStatus != REQ_STATUS_RUNNING)
+            nandPlanePairedReq[chNo][wayNo] = REQ_SLOT_TAG_NONE;
+#endif
+#if (NAND_CACHE_OPS)
+        // the head may be retried, trigger the cached read again later
+        if (reqStatus == REQ_STATUS_FAIL)
+            nandCacheTable[chNo][wayNo].cachedReq = REQ_SLOT_TAG_NONE;
+#endif
         if (reqStatus == REQ_STATUS_DONE)
         {
             if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_READ)
                 reqPoolPtr->reqPool[reqSlotTag].reqCode = REQ_CODE_READ_TRANSFER;
             else
             {
+#if (NAND_READ_RETRY)
+                if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ_TRANSFER))
+                    RecordNandReadRetryLevel(reqSlotTag, chNo, wayNo);
+#endif
+#if (NAND_ECC_REFRESH)
+                if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ_TRANSFER) &&
+                    retryLimitTablePtr->retryLimit[chNo][wayNo] != RETRY_LIMIT)
+                    QueueEccRefreshOfNandReq(reqSlotTag, NAND_REFRESH_REASON_RETRY);
+                else if (REQ_CODE_IS(reqSlotTag, REQ_CODE_ERASE))
+                    ResetEccMarginOfNandReq(reqSlotTag);
+#endif
                 retryLimitTablePtr->retryLimit[chNo][wayNo] = RETRY_LIMIT;
                 GetFromNandReqQ(chNo, wayNo, reqStatus, reqPoolPtr->reqPool[reqSlotTag].reqCode);
             }
@@ -1412,6 +2612,7 @@ void ExecuteNandReq(unsigned int chNo, unsigned int wayNo, unsigned int reqStatu
         {
             if ((reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_READ) ||
                 (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_READ_TRANSFER))
+            {
                 if (retryLimitTablePtr->retryLimit[chNo][wayNo] > 0)
                 {
                     retryLimitTablePtr->retryLimit[chNo][wayNo]--;
@@ -1422,6 +2623,8 @@ void ExecuteNandReq(unsigned int chNo, unsigned int wayNo, unsigned int reqStatu
                     dieStateTablePtr->dieState[chNo][wayNo].dieState = DIE_STATE_IDLE;
                     return;
                 }
+                nandReadRetryStat.failCnt++;
+            }
 
             if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_READ)
                 pr_warn("Read Trigger FAIL on      ");
@@ -1441,14 +2644,14 @@ void ExecuteNandReq(unsigned int chNo, unsigned int wayNo, unsigned int reqStatu
                 if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ADDR)
                 {
                     // Request fail in the bad block detection process
-                    badCheck  = (unsigned char *)reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.addr;
+                    badCheck = (unsigned char *)REQ_DATA_BUF_INFO(reqSlotTag).addr;
                     *badCheck = PSEUDO_BAD_BLOCK_MARK; // FIXME: why not two step assign ?
                 }
 
-            // grown bad block information update
-            phyBlockNo = ((rowAddr % LUN_1_BASE_ADDR) / PAGES_PER_MLC_BLOCK) +
-                         ((rowAddr / LUN_1_BASE_ADDR) * TOTAL_BLOCKS_PER_LUN);
-            UpdatePhyBlockMapForGrownBadBlock(Pcw2VdieTranslation(chNo, wayNo), phyBlockNo);
+            // grown bad block information update, the block maps belong to core 0
+#if (!NAND_CORE_SIDE)
+            UpdateGrownBadBlockOfNandReq(reqSlotTag, chNo, wayNo);
+#endif
 
             retryLimitTablePtr->retryLimit[chNo][wayNo] = RETRY_LIMIT;
             GetFromNandReqQ(chNo, wayNo, reqStatus, reqPoolPtr->reqPool[reqSlotTag].reqCode);
@@ -1461,10 +2664,10 @@ void ExecuteNandReq(unsigned int chNo, unsigned int wayNo, unsigned int reqStatu
                        chNo, wayNo, rowAddr, completeFlagTablePtr->completeFlag[chNo][wayNo],
                        statusReportTablePtr->statusReport[chNo][wayNo]);
 
-            // grown bad block information update
-            phyBlockNo = ((rowAddr % LUN_1_BASE_ADDR) / PAGES_PER_MLC_BLOCK) +
-                         ((rowAddr / LUN_1_BASE_ADDR) * TOTAL_BLOCKS_PER_LUN);
-            UpdatePhyBlockMapForGrownBadBlock(Pcw2VdieTranslation(chNo, wayNo), phyBlockNo);
+#if (NAND_ECC_REFRESH)
+            // the data is still correctable, relocate it before the block gets worse
+            QueueEccRefreshOfNandReq(reqSlotTag, NAND_REFRESH_REASON_MARGIN);
+#endif
 
             retryLimitTablePtr->retryLimit[chNo][wayNo] = RETRY_LIMIT;
             GetFromNandReqQ(chNo, wayNo, reqStatus, reqPoolPtr->reqPool[reqSlotTag].reqCode);
@@ -1474,6 +2677,132 @@ void ExecuteNandReq(unsigned int chNo, unsigned int wayNo, unsigned int reqStatu
             break;
         else
             assert(!"[WARNING] wrong req status [WARNING]");
+#if (NAND_MULTI_PLANE)
+        /*
+         * A failed paired read has returned above to be retried alone, and the paired read
+         * will be triggered again later.
+         */
+        if (pairedReq != REQ_SLOT_TAG_NONE)
+        {
+            if (nandReqQ[chNo][wayNo].headReq == reqSlotTag)
+            {
+                // the page of the paired read is also waiting in the page register of its plane
+                REQ_ENTRY(pairedReq)->reqCode = REQ_CODE_READ_TRANSFER;
+            }
+            else
+            {
+                /*
+                 * The status of a multi-plane program or erase doesn't tell which plane
+                 * failed, so the paired request ends up with the same status as the head.
+                 */
+                if (nandReqQ[chNo][wayNo].headReq != pairedReq)
+                    assert(!"[WARNING] paired request is not behind the head [WARNING]");
+                dieStateTablePtr->dieState[chNo][wayNo].dieState = DIE_STATE_EXE;
+                ExecuteNandReq(chNo, wayNo, reqStatus);
+            }
+        }
+#endif
         break;
     }
 }
+
+#if (NAND_DUAL_CORE)
+/**
+ * @brief Hand the dies over to core 1, called by core 0 after `InitFTL()`.
+ *
+ * All the requests issued during the initialization must be done first, so that core 1
+ * starts with idle dies and empty queues. Core 1 reads the tables initialized by core 0
+ * (e.g. the die state tables and `phyBlockMapPtr`) from the memory, so the data cache is
+ * written back before core 1 is woken up.
+ */
+void StartNandCore()
+{
+    SyncAllLowLevelReqDone();
+
+    nandReqRingPtr  = (P_IPC_RING)NAND_REQ_RING_ADDR;
+    nandDoneRingPtr = (P_IPC_RING)NAND_DONE_RING_ADDR;
+    InitIpcRing(nandReqRingPtr);
+    InitIpcRing(nandDoneRingPtr);
+    nandCoreRunning = 1;
+
+    Xil_DCacheFlush();
+
+    // core 1 waits in the boot ROM for an entry address written here and an event
+    Xil_Out32(NAND_CORE_WAKE_ADDR, NAND_CORE_IMAGE_START_ADDR);
+    dsb();
+    __asm__ __volatile__("sev");
+
+    pr_info("NAND scheduling is handed over to core 1");
+}
+
+/**
+ * @brief Complete the requests returned by core 1, the core 0 side of `SchedulingNandReq()`.
+ *
+ * Besides releasing the request entries, the grown bad blocks are marked here since the
+ * block maps belong to core 0. The blocks woken in the row address dependency table are
+ * also rechecked here, which is done by `SchedulingNandReqPerCh()` on a single core.
+ */
+void CheckDoneNandReq()
+{
+    NAND_IPC_MSG msg;
+    unsigned int chNo, wayNo;
+
+    while (PopIpcRing(nandDoneRingPtr, &msg.dword))
+    {
+        // the warned reads were queued for refresh by core 1, check `ExecuteNandReq()`
+        if (msg.reqStatus == REQ_STATUS_FAIL)
+            UpdateGrownBadBlockOfNandReq(msg.reqSlotTag, msg.chNo, msg.wayNo);
+
+        notCompletedNandReqCnt--;
+        CompleteNandReq(msg.reqSlotTag, msg.reqStatus);
+    }
+
+    for (chNo = 0; chNo < USER_CHANNELS; chNo++)
+        for (wayNo = 0; wayNo < USER_WAYS; wayNo++)
+            if (blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockHead != ROW_ADDR_DEP_BLOCK_NONE)
+                ReleaseBlockedByRowAddrDepReq(chNo, wayNo);
+}
+
+/**
+ * @brief The main loop of core 1, schedule the requests handed over by core 0.
+ *
+ * Only the states private to the scheduler are initialized here, the shared tables were
+ * initialized by core 0 before `StartNandCore()`.
+ */
+void NandCoreMain()
+{
+    NAND_IPC_MSG msg;
+    unsigned int chNo, wayNo;
+
+    for (chNo = 0; chNo < USER_CHANNELS; chNo++)
+    {
+        V2FInitializeHandle(&chCtlReg[chNo], (void *)NSCS[chNo]);
+        for (wayNo = 0; wayNo < USER_WAYS; wayNo++)
+        {
+            nandReqQ[chNo][wayNo].headReq = REQ_SLOT_TAG_NONE;
+            nandReqQ[chNo][wayNo].tailReq = REQ_SLOT_TAG_NONE;
+            nandReqQ[chNo][wayNo].reqCnt  = 0;
+
+            // nothing is blocked on this core, check `CheckDoneNandReq()`
+            blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockHead = ROW_ADDR_DEP_BLOCK_NONE;
+            blockedByRowAddrDepReqQ[chNo][wayNo].wakeBlockTail = ROW_ADDR_DEP_BLOCK_NONE;
+        }
+    }
+
+    reqPoolPtr      = (P_REQ_POOL)REQ_POOL_ADDR;
+    phyBlockMapPtr  = (P_PHY_BLOCK_MAP)PHY_BLOCK_MAP_ADDR;
+    nandReqRingPtr  = (P_IPC_RING)NAND_REQ_RING_ADDR;
+    nandDoneRingPtr = (P_IPC_RING)NAND_DONE_RING_ADDR;
+    InitReqScheduler();
+
+    xil_printf("NAND scheduler started on core 1\r\n");
+
+    while (1)
+    {
+        while (PopIpcRing(nandReqRingPtr, &msg.dword))
+            PutToNandReqQ(msg.reqSlotTag, msg.chNo, msg.wayNo);
+
+        SchedulingNandReq();
+    }
+}
+#endif
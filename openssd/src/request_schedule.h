@@ -47,7 +47,12 @@
 #ifndef REQUEST_SCHEDULE_H_
 #define REQUEST_SCHEDULE_H_
 
+#include "xtime_l.h"
+
+#include "xparameters.h"
+
 #include "ftl_config.h"
+#include "ipc_ring.h"
 
 #define WAY_NONE 0xF
 
@@ -65,8 +70,265 @@
  */
 #define RETRY_LIMIT 5
 
-#define DIE_STATE_IDLE 0
-#define DIE_STATE_EXE  1
+/**
+ * @brief Retry the failed reads with different read levels.
+ *
+ * Instead of retrying a failed read with the same parameters, each of the `RETRY_LIMIT`
+ * retries moves the die to the next level of `nandReadRetryLevel` by
+ * `V2FSetReadRetryAsync()`. The level of the last successful read on each block is kept
+ * in `NAND_READ_RETRY_HISTORY_TABLE`, and the following reads on the block start from it.
+ *
+ * Setting the level is a separate step before the read trigger, the die waits for it in
+ * `DIE_STATE_EXE` like other operations, check `NAND_READ_RETRY_ENTRY`.
+ *
+ * @note The multi-plane and cache reads use the level of the die set for their head.
+ *
+ * @warning `V2F_READ_RETRY_FEATURE_ADDR` and `nandReadRetryLevel` are placeholders, they
+ * must be checked against the datasheet of the mounted device before enabling this.
+ */
+#define NAND_READ_RETRY        0
+#define NAND_READ_RETRY_LEVELS (RETRY_LIMIT + 1)
+
+// the die must be set again before the next read, e.g., the last setting failed
+#define NAND_READ_RETRY_LEVEL_UNKNOWN 0xFF
+
+/**
+ * @brief Relocate the data of the blocks that are running out of ECC margin.
+ *
+ * The worst chunk bit errors of each ECC-checked read in the main block space are folded
+ * into a moving average of its virtual block, check `NAND_ECC_MARGIN_ENTRY`. Once the
+ * average reaches `NAND_ECC_REFRESH_THRESHOLD`, or a read of the block only succeeded
+ * after retries, the block is queued once on `nandRefreshRingPtr`, and its valid slices
+ * are moved to another block in the background by `RefreshQueuedBlock()`, at most one
+ * block every `NAND_ECC_REFRESH_INTERVAL_MS`. The entry is reset when the block is erased.
+ */
+#define NAND_ECC_REFRESH             1
+#define NAND_ECC_MARGIN_AVG_SHIFT    3                                       // a new sample weighs 1/8
+#define NAND_ECC_REFRESH_THRESHOLD   (BIT_ERROR_THRESHOLD_PER_CHUNK * 3 / 4) // bit errors per chunk
+#define NAND_ECC_REFRESH_INTERVAL_MS 100
+
+#define NAND_REFRESH_REASON_MARGIN       0 // the moving average reached the threshold
+#define NAND_REFRESH_REASON_RETRY        1 // a read of the block was recovered by retries
+#define NAND_REFRESH_REASON_READ_DISTURB 2 // check `READ_DISTURB_REFRESH`
+#define NAND_REFRESH_REASON_GROWN_BAD    3 // check `GROWN_BAD_BLOCK_SALVAGE`
+#define NAND_REFRESH_REASONS             4
+
+// the physical block number of the given row address
+#define ROW_ADDR_TO_PBLOCK(rowAddr)                                                                               \
+    ((((rowAddr) % LUN_1_BASE_ADDR) / PAGES_PER_MLC_BLOCK) + (((rowAddr) / LUN_1_BASE_ADDR) * TOTAL_BLOCKS_PER_LUN))
+
+/**
+ * @brief Let the reads overtake the programs and erases queued on the same die.
+ *
+ * When a die becomes idle and the head of its `nandReqQ` is a program or an erase, the
+ * first read among the next `NAND_READ_PRIO_SCAN_DEPTH` requests that doesn't touch the
+ * blocks of the requests ahead of it is moved to the head and issued first. Read transfers
+ * are also issued before programs and erases on the channel.
+ *
+ * To bound the starvation of writes, at most `NAND_READ_PRIO_MAX_OVERTAKE` reads can be
+ * issued ahead of a waiting program or erase, which also sets the read/write ratio of a
+ * die under mixed workloads. Set `NAND_READ_PRIORITY` to 0 for the original FIFO order.
+ *
+ * @sa `PromoteNandReadReq()`.
+ */
+#define NAND_READ_PRIORITY          1
+#define NAND_READ_PRIO_MAX_OVERTAKE 4
+#define NAND_READ_PRIO_SCAN_DEPTH   16
+
+/**
+ * @brief Promote the NAND requests that waited longer than the deadline of their class.
+ *
+ * Each request is stamped when it is allocated (`REQ_CREATE_TICK()`). When a die becomes
+ * idle, the request among the next `NAND_READ_PRIO_SCAN_DEPTH` requests that missed its
+ * deadline by the longest time, and longer than the head did, is moved to the head if it
+ * doesn't conflict with the requests ahead of it. This takes precedence over the read
+ * priority, so the host reads queued behind GC reads are also served in time.
+ *
+ * The deadlines are initialized from `NAND_REQ_DEADLINE_US_*` and can be tuned at run time
+ * through `nandReqDeadline`, 0 for no deadline. Set `NAND_REQ_DEADLINE` to 0 to disable the
+ * promotion, the queueing delay statistics are always collected.
+ *
+ * @sa `GetNandReqClass()`, `PromoteNandReq()`.
+ */
+#define NAND_REQ_DEADLINE 1
+
+#define NAND_REQ_CLASS_HOST_READ  0 // reads of the data buffer entries
+#define NAND_REQ_CLASS_HOST_WRITE 1 // programs of the data buffer entries
+#define NAND_REQ_CLASS_INTERNAL   2 // reads and programs of the temporary buffers (GC, RMW fills)
+#define NAND_REQ_CLASS_ERASE      3
+#define NAND_REQ_CLASS_PHY        4 // requests with physical addresses (BBT, RESET, SET_FEATURE)
+#define NAND_REQ_CLASSES          5
+
+#define NAND_REQ_DEADLINE_US_HOST_READ  2000
+#define NAND_REQ_DEADLINE_US_HOST_WRITE 20000
+#define NAND_REQ_DEADLINE_US_INTERNAL   50000
+#define NAND_REQ_DEADLINE_US_ERASE      100000
+#define NAND_REQ_DEADLINE_US_PHY        0
+
+/**
+ * @brief The number of buckets of the queueing delay histograms.
+ *
+ * The i-th bucket counts the requests waited for [2^(i-1), 2^i) us from allocation to the
+ * first issue, and the last bucket also counts the longer ones.
+ */
+#define NAND_REQ_DELAY_BUCKETS 20
+
+/**
+ * @brief The max number of NAND commands issued on a channel in one scheduling pass.
+ *
+ * The channel controller has a command queue of 32 entries (`V2FGetFreeQueueCount()`),
+ * the scheduler fills the free entries with the commands of different ways in each pass.
+ * Set this to 1 for issuing a single command per pass.
+ */
+#define NAND_CH_CMDS_PER_PASS 32
+
+/**
+ * @brief Only visit the channels and the idle ways that have something to do.
+ *
+ * Instead of walking all the channels and their idle lists in every pass, the scheduler
+ * keeps a bitmap of the channels that have dies in flight or requests to be scheduled
+ * (`nandChPendingMap`), and a bitmap per channel of the ways that got new requests or
+ * released blocked requests (`nandWayPendingMap`). The bits are set by
+ * `MARK_NAND_WAY_PENDING()` when requests are put into `nandReqQ` or blocked requests are
+ * woken, and the channel bit is cleared when all its dies are idle and nothing is left.
+ *
+ * Set `NAND_SCHED_PROFILE` to 1 for measuring the timer ticks spent in each pass of
+ * `SchedulingNandReq()`.
+ */
+#define NAND_SCHED_EVENT   1
+#define NAND_SCHED_PROFILE 0
+
+#if (NAND_SCHED_EVENT)
+#define MARK_NAND_WAY_PENDING(chNo, wayNo)                                                                        \
+    do                                                                                                            \
+    {                                                                                                             \
+        nandWayPendingMap[(chNo)] |= 1 << (wayNo);                                                                \
+        nandChPendingMap |= 1 << (chNo);                                                                          \
+    } while (0)
+#else
+#define MARK_NAND_WAY_PENDING(chNo, wayNo)
+#endif
+
+/**
+ * @brief Account the busy time of each die and the queueing of each die and channel.
+ *
+ * The global timer is read when an operation is issued on a die and when the die reports
+ * its completion, and the busy ticks are added to the die by `NAND_UTIL_OP_*`. The idle
+ * time of a die is the time since the last reset not spent in any operation. Besides, the
+ * time a die waits in the way priority lists before its head request is issued, and the
+ * depth of `nandReqQ` are sampled per die on issue and per channel on each visit of
+ * `SchedulingNandReqPerCh()`.
+ *
+ * The results are dumped by the admin command `ADMIN_MONITOR_SCHED`.
+ *
+ * @note A suspended program or erase is accounted as two operations, and the multi-plane
+ * and cache operations are accounted once on the die of their head request.
+ *
+ * @note The statistics are globals of each core image. With `NAND_DUAL_CORE`, the monitor
+ * runs on core 0 and the report only covers the operations issued by core 0, i.e. the
+ * ones before `StartNandCore()`.
+ */
+#define NAND_UTIL_STAT 1
+
+#define NAND_UTIL_OP_READ     0 // the array read of READ_TRIGGER
+#define NAND_UTIL_OP_TRANSFER 1 // the data out of READ_TRANSFER, which occupies the channel
+#define NAND_UTIL_OP_PROGRAM  2
+#define NAND_UTIL_OP_ERASE    3
+#define NAND_UTIL_OP_OTHER    4 // reset, set features and read level setting
+#define NAND_UTIL_OPS         5
+#define NAND_UTIL_OP_NONE     0xFF // the die is not busy
+
+/**
+ * @brief Run the NAND scheduling on the second Cortex-A9 core.
+ *
+ * Core 0 keeps the NVMe handling, the slice translation and the data buffer, and core 1
+ * runs `NandCoreMain()`, which owns `nandReqQ`, the die state tables and the channel
+ * controllers. The two cores only talk through the `IPC_RING`s in shared DRAM:
+ *
+ * - `nandReqRingPtr`: the requests put into `PutToNandReqQ()` by core 0
+ * - `nandDoneRingPtr`: the requests removed by `GetFromNandReqQ()` on core 1, which are
+ *   completed by `CheckDoneNandReq()` on core 0
+ * - `nandRefreshRingPtr`: the blocks queued for refresh by core 1, check `NAND_ECC_REFRESH`
+ *
+ * The request pool is mapped uncached on both cores in this mode, since both of them
+ * write the entries in flight: core 1 writes the queue links, `reqQueueType` and
+ * `reqCode`, while core 0 may still link new blocking requests to them through
+ * `nextBlockingReq`, which is in a different word.
+ *
+ * Core 1 runs its own application built from the same sources with the BSP of
+ * ps7_cortexa9_1 (`XPAR_CPU_ID` 1), linked at `NAND_CORE_IMAGE_START_ADDR`. Core 0 runs
+ * alone until `InitFTL()` is done, and then hands the dies over in `StartNandCore()`.
+ */
+#define NAND_DUAL_CORE 0
+
+#if (NAND_DUAL_CORE) && (XPAR_CPU_ID == 1)
+#define NAND_CORE_SIDE 1 // this image runs on core 1
+#else
+#define NAND_CORE_SIDE 0
+#endif
+
+/**
+ * @brief Suspend the program or erase on a die to serve the host reads queued on it.
+ *
+ * When a die is busy with a program or an erase and a host read that doesn't touch the
+ * same block is queued behind it, the operation is suspended (`DIE_STATE_SUSPENDING`), the
+ * read is moved to the head and served, and then the suspended operation is resumed when
+ * it becomes the head again. A single operation is suspended at most
+ * `NAND_SUSPEND_MAX_PER_OP` times so that it always finishes.
+ *
+ * This needs the suspend and resume commands of the channel controller, check
+ * `V2F_SUSPEND_SUPPORTED`.
+ *
+ * @sa `TrySuspendNandReq()`.
+ */
+#define NAND_SUSPEND            V2F_SUSPEND_SUPPORTED
+#define NAND_SUSPEND_PROGRAM    1 // 0 for suspending erases only
+#define NAND_SUSPEND_MAX_PER_OP 4
+
+/**
+ * @brief Coalesce the same flash operations to different planes of a die.
+ *
+ * When a die becomes idle, the head of its `nandReqQ` and the request right behind it are
+ * issued by a single multi-plane command if they are both reads, programs or erases on
+ * the same page offset of two blocks on different planes of the same LUN. The paired
+ * request shares the status of the head: a paired program or erase completes (or fails)
+ * together with the head, and the page of a paired read is transferred right after the
+ * head from its own page register.
+ *
+ * This needs the multi-plane commands of the channel controller, check
+ * `V2F_MULTI_PLANE_SUPPORTED`, and the writes of a die are spread over two planes by
+ * `PLANE_PAIRED_BLOCKS`.
+ *
+ * @sa `GetNandReqPlanePair()`.
+ */
+#define NAND_MULTI_PLANE V2F_MULTI_PLANE_SUPPORTED
+
+/**
+ * @brief Overlap the array access of a die with the data transfer of its previous request.
+ *
+ * - Cache read: when the head of `nandReqQ` is a read transfer and the next request is
+ *   also a read, the next read is triggered by a (sequential or random) cache read right
+ *   before the transfer, so its array read overlaps the transfer of the head.
+ * - Cache program: when the next request of a program is also a program, the program is
+ *   issued by a cache program and completes as soon as the die can take the next page,
+ *   while the array is still programming it in the background.
+ *
+ * Nothing is reordered on a die while it is in a cache read or program sequence.
+ *
+ * @note A program failure found by a cache program is reported by the status of the
+ * following program on the die.
+ *
+ * This needs the cache commands of the channel controller, check `V2F_CACHE_OPS_SUPPORTED`.
+ */
+#define NAND_CACHE_OPS V2F_CACHE_OPS_SUPPORTED
+
+#define NAND_CACHE_OP_NONE    0
+#define NAND_CACHE_OP_READ    1 // the die is in the cache read mode
+#define NAND_CACHE_OP_PROGRAM 2 // the last program was a cache program
+
+#define DIE_STATE_IDLE       0
+#define DIE_STATE_EXE        1
+#define DIE_STATE_SUSPENDING 2 // waiting for the program or erase to be suspended
 
 #define REQ_STATUS_CHECK_OPT_NONE            0 // no need to check the request status
 #define REQ_STATUS_CHECK_OPT_CHECK           1 //
@@ -183,6 +445,287 @@ typedef struct _WAY_PRIORITY_TABLE
     WAY_PRIORITY_ENTRY wayPriority[USER_CHANNELS];
 } WAY_PRIORITY_TABLE, *P_WAY_PRIORITY_TABLE;
 
+/**
+ * @brief The statistics of the read-priority NAND scheduling.
+ *
+ * - promotedCnt: reads issued ahead of a queued program or erase
+ * - conflictCnt: reads not promoted since they touch the block of an older request
+ * - starvationCnt: promotions refused since the waiting program or erase reached the bound
+ */
+typedef struct _NAND_READ_PRIO_STAT
+{
+    unsigned int promotedCnt;
+    unsigned int conflictCnt;
+    unsigned int starvationCnt;
+} NAND_READ_PRIO_STAT, *P_NAND_READ_PRIO_STAT;
+
+/**
+ * @brief The per-class statistics of the NAND request deadlines.
+ *
+ * - promotedCnt: requests moved to the head since they missed their deadlines
+ * - missedCnt: requests issued after their deadlines
+ * - delayHist: the queueing delay histograms, check `NAND_REQ_DELAY_BUCKETS`
+ */
+typedef struct _NAND_REQ_DEADLINE_STAT
+{
+    unsigned int promotedCnt[NAND_REQ_CLASSES];
+    unsigned int missedCnt[NAND_REQ_CLASSES];
+    unsigned int delayHist[NAND_REQ_CLASSES][NAND_REQ_DELAY_BUCKETS];
+} NAND_REQ_DEADLINE_STAT, *P_NAND_REQ_DEADLINE_STAT;
+
+/**
+ * @brief The command issue statistics of a channel.
+ *
+ * - passCnt: scheduling passes that issued at least one command
+ * - cmdCnt: commands issued, `cmdCnt / passCnt` is the average batch size
+ * - maxCmdsPerPass: the largest batch issued in one pass
+ * - slotsExhaustedCnt: passes that used up all the free slots (or `NAND_CH_CMDS_PER_PASS`)
+ * - queueFullCnt: passes skipped since the controller queue was full
+ */
+typedef struct _NAND_CH_ISSUE_STAT
+{
+    unsigned int passCnt;
+    unsigned int cmdCnt;
+    unsigned int maxCmdsPerPass;
+    unsigned int slotsExhaustedCnt;
+    unsigned int queueFullCnt;
+} NAND_CH_ISSUE_STAT, *P_NAND_CH_ISSUE_STAT;
+
+/**
+ * @brief The statistics of the scheduling passes.
+ *
+ * - passCnt: calls of `SchedulingNandReq()`
+ * - chVisitCnt: channels scheduled, `chVisitCnt / passCnt` is the average channels visited
+ * - passTicks: the total timer ticks spent in the passes, `NAND_SCHED_PROFILE` only
+ * - maxPassTicks: the longest pass in timer ticks, `NAND_SCHED_PROFILE` only
+ */
+typedef struct _NAND_SCHED_STAT
+{
+    unsigned int passCnt;
+    unsigned int chVisitCnt;
+    unsigned long long passTicks;
+    unsigned int maxPassTicks;
+} NAND_SCHED_STAT, *P_NAND_SCHED_STAT;
+
+/**
+ * @brief The busy time and queueing statistics of a die, check `NAND_UTIL_STAT`.
+ *
+ * - busyTicks: the timer ticks spent in operations, by `NAND_UTIL_OP_*`
+ * - opCnt: the operations completed, by `NAND_UTIL_OP_*`
+ * - waitTicks: the timer ticks the die waited in the way priority lists before issuing
+ * - waitCnt: the issues that waited in the way priority lists
+ * - depthSum, depthSampleCnt, maxDepth: the depth of `nandReqQ` sampled on each issue
+ * - busyStartTick, busyOp: the operation in progress, `NAND_UTIL_OP_NONE` if idle
+ * - listedTick, listed: when the die was put into a way priority list
+ */
+typedef struct _NAND_DIE_UTIL_STAT
+{
+    XTime busyTicks[NAND_UTIL_OPS];
+    unsigned int opCnt[NAND_UTIL_OPS];
+    XTime waitTicks;
+    unsigned int waitCnt;
+    unsigned long long depthSum;
+    unsigned int depthSampleCnt;
+    unsigned int maxDepth;
+    XTime busyStartTick;
+    XTime listedTick;
+    unsigned char busyOp;
+    unsigned char listed;
+} NAND_DIE_UTIL_STAT, *P_NAND_DIE_UTIL_STAT;
+
+/**
+ * @brief The queueing statistics of a channel, check `NAND_UTIL_STAT`.
+ *
+ * - depthSum, depthSampleCnt, maxDepth: the requests queued in `nandReqQ` of all the ways
+ *   of the channel, sampled on each visit of `SchedulingNandReqPerCh()`
+ */
+typedef struct _NAND_CH_UTIL_STAT
+{
+    unsigned long long depthSum;
+    unsigned int depthSampleCnt;
+    unsigned int maxDepth;
+} NAND_CH_UTIL_STAT, *P_NAND_CH_UTIL_STAT;
+
+/**
+ * @brief The program or erase suspended on a die.
+ *
+ * - suspendedReq: the suspended request, which stays in `nandReqQ` and will be resumed
+ *   instead of reissued when it becomes the head again
+ * - readReq: the read to be moved to the head once the die is suspended
+ * - suspendCnt: the number of times the current program or erase was suspended
+ */
+typedef struct _NAND_SUSPEND_ENTRY
+{
+    unsigned int suspendedReq : 16;
+    unsigned int readReq : 16;
+    unsigned int suspendCnt : 8;
+    unsigned int reserved0 : 24;
+} NAND_SUSPEND_ENTRY, *P_NAND_SUSPEND_ENTRY;
+
+/**
+ * @brief The cache operation state of a die.
+ *
+ * - cachedReq: the read triggered by the cache read behind the transfer of the head, it
+ *   won't be triggered again when it becomes the head
+ * - cacheOp: `NAND_CACHE_OP_*`
+ */
+typedef struct _NAND_CACHE_ENTRY
+{
+    unsigned short cachedReq;
+    unsigned short cacheOp;
+} NAND_CACHE_ENTRY, *P_NAND_CACHE_ENTRY;
+
+/**
+ * @brief The read level of each block that worked last time, check `NAND_READ_RETRY`.
+ */
+typedef struct _NAND_READ_RETRY_HISTORY_TABLE
+{
+    unsigned char level[USER_CHANNELS][USER_WAYS][TOTAL_BLOCKS_PER_DIE]; // the index of `nandReadRetryLevel`
+} NAND_READ_RETRY_HISTORY_TABLE, *P_NAND_READ_RETRY_HISTORY_TABLE;
+
+/**
+ * @brief The parameters of the set features commands of each die, must be uncached.
+ */
+typedef struct _NAND_READ_RETRY_PAY_LOAD_TABLE
+{
+    unsigned int payload[USER_CHANNELS][USER_WAYS];
+} NAND_READ_RETRY_PAY_LOAD_TABLE, *P_NAND_READ_RETRY_PAY_LOAD_TABLE;
+
+/**
+ * @brief The read retry state of a die.
+ *
+ * - curLevel: the level the die is set to, the index of `nandReadRetryLevel`
+ * - levelSetting: the die is busy with `V2FSetReadRetryAsync()` for its head read
+ * - levelSet: the level was set for the head read, which has been issued once already
+ */
+typedef struct _NAND_READ_RETRY_ENTRY
+{
+    unsigned char curLevel;
+    unsigned char levelSetting;
+    unsigned char levelSet;
+} NAND_READ_RETRY_ENTRY, *P_NAND_READ_RETRY_ENTRY;
+
+/**
+ * @brief The statistics of the read retries.
+ *
+ * The average reads per NAND read request is `(readCnt + retryCnt) / readCnt`.
+ *
+ * - readCnt: reads triggered for the first time
+ * - retryCnt: reads triggered again after a failure
+ * - recoveredCnt: reads done after retries
+ * - failCnt: reads failed at all the levels
+ * - historyCnt: reads started from the level in the history instead of the default one
+ * - levelSetCnt: read level changes
+ */
+typedef struct _NAND_READ_RETRY_STAT
+{
+    unsigned int readCnt;
+    unsigned int retryCnt;
+    unsigned int recoveredCnt;
+    unsigned int failCnt;
+    unsigned int historyCnt;
+    unsigned int levelSetCnt;
+} NAND_READ_RETRY_STAT, *P_NAND_READ_RETRY_STAT;
+
+/**
+ * @brief The ECC health of a virtual block since its last erase, check `NAND_ECC_REFRESH`.
+ *
+ * - errSum: the moving average of the worst chunk bit errors, scaled by 2^`NAND_ECC_MARGIN_AVG_SHIFT`
+ * - maxErr: the worst chunk bit errors of all the reads
+ * - refreshQueued: the block is already queued on `nandRefreshRingPtr`
+ */
+typedef struct _NAND_ECC_MARGIN_ENTRY
+{
+    unsigned short errSum;
+    unsigned char maxErr;
+    unsigned char refreshQueued;
+} NAND_ECC_MARGIN_ENTRY, *P_NAND_ECC_MARGIN_ENTRY;
+
+typedef struct _NAND_ECC_MARGIN_TABLE
+{
+    NAND_ECC_MARGIN_ENTRY block[USER_DIES][USER_BLOCKS_PER_DIE];
+} NAND_ECC_MARGIN_TABLE, *P_NAND_ECC_MARGIN_TABLE;
+
+/**
+ * @brief The message of `nandRefreshRingPtr`, a virtual block to be refreshed.
+ */
+typedef union _NAND_REFRESH_MSG
+{
+    unsigned int dword;
+    struct
+    {
+        unsigned int blockNo : 16;
+        unsigned int dieNo : 8;
+        unsigned int reason : 8;
+    };
+} NAND_REFRESH_MSG, *P_NAND_REFRESH_MSG;
+
+/**
+ * @brief The statistics of the ECC margin tracking.
+ *
+ * - sampleCnt: reads folded into the moving averages
+ * - queuedCnt: blocks queued for refresh, by `NAND_REFRESH_REASON_*`
+ * - ringFullCnt: blocks not queued since the ring was full, queued again by the next read
+ */
+typedef struct _NAND_ECC_MARGIN_STAT
+{
+    unsigned int sampleCnt;
+    unsigned int queuedCnt[NAND_REFRESH_REASONS];
+    unsigned int ringFullCnt;
+} NAND_ECC_MARGIN_STAT, *P_NAND_ECC_MARGIN_STAT;
+
+/**
+ * @brief The statistics of the cache operations.
+ */
+typedef struct _NAND_CACHE_STAT
+{
+    unsigned int seqReadCnt;    // sequential cache reads
+    unsigned int randomReadCnt; // random cache reads
+    unsigned int programCnt;    // cache programs
+} NAND_CACHE_STAT, *P_NAND_CACHE_STAT;
+
+/**
+ * @brief The statistics of the multi-plane commands, each command serves two requests.
+ */
+typedef struct _NAND_MULTI_PLANE_STAT
+{
+    unsigned int readCnt;
+    unsigned int programCnt;
+    unsigned int eraseCnt;
+} NAND_MULTI_PLANE_STAT, *P_NAND_MULTI_PLANE_STAT;
+
+/**
+ * @brief The message passed through `nandReqRingPtr` and `nandDoneRingPtr`.
+ *
+ * `reqStatus` is only used by the completion messages.
+ */
+typedef union _NAND_IPC_MSG
+{
+    unsigned int dword;
+    struct
+    {
+        unsigned int reqSlotTag : 16;
+        unsigned int chNo : 4;
+        unsigned int wayNo : 4;
+        unsigned int reqStatus : 4; // REQ_STATUS_*
+        unsigned int reserved0 : 4;
+    };
+} NAND_IPC_MSG;
+
+/**
+ * @brief The statistics of the program/erase suspension.
+ *
+ * - suspendCnt: programs or erases suspended for a read
+ * - resumeCnt: suspended programs or erases resumed
+ * - limitCnt: operations that reached `NAND_SUSPEND_MAX_PER_OP` with a read waiting
+ */
+typedef struct _NAND_SUSPEND_STAT
+{
+    unsigned int suspendCnt;
+    unsigned int resumeCnt;
+    unsigned int limitCnt;
+} NAND_SUSPEND_STAT, *P_NAND_SUSPEND_STAT;
+
 void InitReqScheduler();
 
 void SyncAllLowLevelReqDone();
@@ -190,6 +733,8 @@ void SyncAvailFreeReq();
 void SyncReleaseEraseReq(unsigned int chNo, unsigned int wayNo, unsigned int blockNo);
 void SchedulingNandReq();
 void SchedulingNandReqPerCh(unsigned int chNo);
+void PromoteNandReq(unsigned int chNo, unsigned int wayNo);
+unsigned int GetNandReqClass(unsigned int reqSlotTag);
 
 void PutToNandWayPriorityTable(unsigned int reqSlotTag, unsigned int chNo, unsigned int wayNo);
 void PutToNandIdleList(unsigned int chNo, unsigned int wayNo);
@@ -215,6 +760,11 @@ unsigned int CheckReqStatus(unsigned int chNo, unsigned int wayNo);
 unsigned int CheckEccErrorInfo(unsigned int chNo, unsigned int wayNo);
 
 void ExecuteNandReq(unsigned int chNo, unsigned int wayNo, unsigned int reqStatus);
+void ResetNandUtilStat();
+
+void StartNandCore();
+void CheckDoneNandReq();
+void NandCoreMain();
 
 extern P_COMPLETE_FLAG_TABLE completeFlagTablePtr;
 extern P_STATUS_REPORT_TABLE statusReportTablePtr;
@@ -222,5 +772,24 @@ extern P_ERROR_INFO_TABLE eccErrorInfoTablePtr;
 extern P_RETRY_LIMIT_TABLE retryLimitTablePtr;
 extern P_DIE_STATE_TABLE dieStatusTablePtr;
 extern P_WAY_PRIORITY_TABLE wayPriorityTablePtr;
+extern NAND_READ_PRIO_STAT nandReadPrioStat;
+extern NAND_REQ_DEADLINE_STAT nandReqDeadlineStat;
+extern NAND_CH_ISSUE_STAT nandChIssueStat[USER_CHANNELS];
+extern NAND_SUSPEND_STAT nandSuspendStat;
+extern NAND_MULTI_PLANE_STAT nandMultiPlaneStat;
+extern NAND_CACHE_STAT nandCacheStat;
+extern NAND_READ_RETRY_STAT nandReadRetryStat;
+extern NAND_SCHED_STAT nandSchedStat;
+extern NAND_DIE_UTIL_STAT nandDieUtilStat[USER_CHANNELS][USER_WAYS];
+extern NAND_CH_UTIL_STAT nandChUtilStat[USER_CHANNELS];
+extern XTime nandUtilStartTick;
+extern NAND_ECC_MARGIN_STAT nandEccMarginStat;
+extern unsigned int nandChPendingMap;
+extern unsigned int nandWayPendingMap[USER_CHANNELS];
+extern XTime nandReqDeadline[NAND_REQ_CLASSES];
+extern P_IPC_RING nandReqRingPtr;
+extern P_IPC_RING nandDoneRingPtr;
+extern P_IPC_RING nandRefreshRingPtr;
+extern unsigned int nandCoreRunning;
 
 #endif /* REQUEST_SCHEDULE_H_ */
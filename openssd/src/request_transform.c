@@ -48,6 +48,7 @@
 
 #include "xil_printf.h"
 #include <assert.h>
+#include "string.h"
 #include "debug.h"
 
 #include "nvme/nvme.h"
@@ -59,6 +60,7 @@
 #include "nmc/nmc_requests.h"
 
 P_ROW_ADDR_DEPENDENCY_TABLE rowAddrDependencyTablePtr;
+FUA_CMD_ENTRY fuaCmdTable[NVME_CMD_SLOT_TAG_COUNT];
 
 void InitDependencyTable()
 {
@@ -74,6 +76,11 @@ void InitDependencyTable()
                 rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].permittedProgPage   = 0;
                 rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].blockedReadReqCnt   = 0;
                 rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].blockedEraseReqFlag = 0;
+
+                ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockNo)->headReq       = REQ_SLOT_TAG_NONE;
+                ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockNo)->tailReq       = REQ_SLOT_TAG_NONE;
+                ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockNo)->nextWakeBlock = ROW_ADDR_DEP_BLOCK_NONE;
+                ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockNo)->wakeFlag      = 0;
             }
         }
     }
@@ -124,11 +131,14 @@ void InitDependencyTable()
  * @param startLba address of the first logical NVMe block to read/write.
  * @param nlb number of logical NVMe blocks to read/write.
  * @param cmdCode opcode of the given NVMe command.
+ * @param seqHint whether the host marked this command as a sequential request.
+ * @param fua whether the FUA bit of this command is set, only honored for `IO_NVM_WRITE`.
  */
-void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigned int nlb, unsigned int cmdCode)
+void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigned int nlb, unsigned int cmdCode,
+                         unsigned int seqHint, unsigned int fua)
 {
     unsigned int reqSlotTag, requestedNvmeBlock, tempNumOfNvmeBlock, transCounter, tempLsa, loop, nvmeBlockOffset,
-        nvmeDmaStartIndex, reqCode;
+        nvmeDmaStartIndex, reqCode, bypass;
 
     requestedNvmeBlock = nlb + 1;
     transCounter       = 0;
@@ -197,6 +207,12 @@ void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigne
         break;
     }
 
+    // streaming commands will be served by transient buffers instead of cached buffers
+    bypass = CheckDataBufBypass(cmdCode, startLba, nlb, seqHint);
+
+    // each slice of a FUA write will be programmed before completing the command
+    fua = (fua && (cmdCode == IO_NVM_WRITE)) ? REQ_OPT_FUA_ON : REQ_OPT_FUA_OFF;
+
     // first transform
     nvmeBlockOffset = (startLba % NVME_BLOCKS_PER_SLICE);
     if (loop)
@@ -206,13 +222,16 @@ void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigne
 
     reqSlotTag = GetFromFreeReqQ();
 
-    reqPoolPtr->reqPool[reqSlotTag].reqType                     = REQ_TYPE_SLICE;
-    reqPoolPtr->reqPool[reqSlotTag].reqCode                     = reqCode;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag              = cmdSlotTag;
-    reqPoolPtr->reqPool[reqSlotTag].logicalSliceAddr            = tempLsa;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.startIndex      = nvmeDmaStartIndex;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.nvmeBlockOffset = nvmeBlockOffset;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.numOfNvmeBlock  = tempNumOfNvmeBlock;
+    reqPoolPtr->reqPool[reqSlotTag].reqType              = REQ_TYPE_SLICE;
+    reqPoolPtr->reqPool[reqSlotTag].reqCode              = reqCode;
+    reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag       = cmdSlotTag;
+    REQ_LSA(reqSlotTag)                                  = tempLsa;
+    REQ_NVME_DMA_INFO(reqSlotTag).startIndex             = nvmeDmaStartIndex;
+    REQ_NVME_DMA_INFO(reqSlotTag).nvmeBlockOffset        = nvmeBlockOffset;
+    REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock         = tempNumOfNvmeBlock;
+    reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufBypass = bypass;
+    reqPoolPtr->reqPool[reqSlotTag].reqOpt.fua           = fua;
+    fuaCmdTable[cmdSlotTag].pendingProgCnt += fua;
 
     PutToSliceReqQ(reqSlotTag);
 
@@ -228,13 +247,16 @@ void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigne
 
         reqSlotTag = GetFromFreeReqQ();
 
-        reqPoolPtr->reqPool[reqSlotTag].reqType                     = REQ_TYPE_SLICE;
-        reqPoolPtr->reqPool[reqSlotTag].reqCode                     = reqCode;
-        reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag              = cmdSlotTag;
-        reqPoolPtr->reqPool[reqSlotTag].logicalSliceAddr            = tempLsa;
-        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.startIndex      = nvmeDmaStartIndex;
-        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.nvmeBlockOffset = nvmeBlockOffset;
-        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.numOfNvmeBlock  = tempNumOfNvmeBlock;
+        reqPoolPtr->reqPool[reqSlotTag].reqType              = REQ_TYPE_SLICE;
+        reqPoolPtr->reqPool[reqSlotTag].reqCode              = reqCode;
+        reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag       = cmdSlotTag;
+        REQ_LSA(reqSlotTag)                                  = tempLsa;
+        REQ_NVME_DMA_INFO(reqSlotTag).startIndex             = nvmeDmaStartIndex;
+        REQ_NVME_DMA_INFO(reqSlotTag).nvmeBlockOffset        = nvmeBlockOffset;
+        REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock         = tempNumOfNvmeBlock;
+        reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufBypass = bypass;
+        reqPoolPtr->reqPool[reqSlotTag].reqOpt.fua           = fua;
+        fuaCmdTable[cmdSlotTag].pendingProgCnt += fua;
 
         PutToSliceReqQ(reqSlotTag);
 
@@ -251,13 +273,16 @@ void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigne
 
     reqSlotTag = GetFromFreeReqQ();
 
-    reqPoolPtr->reqPool[reqSlotTag].reqType                     = REQ_TYPE_SLICE;
-    reqPoolPtr->reqPool[reqSlotTag].reqCode                     = reqCode;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag              = cmdSlotTag;
-    reqPoolPtr->reqPool[reqSlotTag].logicalSliceAddr            = tempLsa;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.startIndex      = nvmeDmaStartIndex;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.nvmeBlockOffset = nvmeBlockOffset;
-    reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.numOfNvmeBlock  = tempNumOfNvmeBlock;
+    reqPoolPtr->reqPool[reqSlotTag].reqType              = REQ_TYPE_SLICE;
+    reqPoolPtr->reqPool[reqSlotTag].reqCode              = reqCode;
+    reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag       = cmdSlotTag;
+    REQ_LSA(reqSlotTag)                                  = tempLsa;
+    REQ_NVME_DMA_INFO(reqSlotTag).startIndex             = nvmeDmaStartIndex;
+    REQ_NVME_DMA_INFO(reqSlotTag).nvmeBlockOffset        = nvmeBlockOffset;
+    REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock         = tempNumOfNvmeBlock;
+    reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufBypass = bypass;
+    reqPoolPtr->reqPool[reqSlotTag].reqOpt.fua           = fua;
+    fuaCmdTable[cmdSlotTag].pendingProgCnt += fua;
 
     PutToSliceReqQ(reqSlotTag);
 }
@@ -277,11 +302,15 @@ void EvictDataBufEntry(unsigned int originReqSlotTag)
 {
     unsigned int reqSlotTag, virtualSliceAddr, dataBufEntry;
 
-    dataBufEntry = REQ_ENTRY(originReqSlotTag)->dataBufInfo.entry;
+    dataBufEntry = REQ_DATA_BUF_INFO(originReqSlotTag).entry;
 
     if (BUF_ENTRY(dataBufEntry)->dirty == DATA_BUF_DIRTY &&
         BUF_ENTRY(dataBufEntry)->dontCache == DATA_BUF_KEEP_CACHE)
     {
+        // the slice was only partially written, complete it before programming
+        if (!BUF_SECTOR_IS_FULL(dataBufEntry))
+            FillDataBufEntry(dataBufEntry);
+
         if (BUF_ENTRY(dataBufEntry)->phyReq)
         {
             // FIXME: we should program a page once before that page being erased
@@ -299,20 +328,22 @@ void EvictDataBufEntry(unsigned int originReqSlotTag)
             REQ_ENTRY(reqSlotTag)->reqType                       = REQ_TYPE_NAND;
             REQ_ENTRY(reqSlotTag)->reqCode                       = REQ_CODE_WRITE;
             REQ_ENTRY(reqSlotTag)->nvmeCmdSlotTag                = REQ_ENTRY(originReqSlotTag)->nvmeCmdSlotTag;
-            REQ_ENTRY(reqSlotTag)->logicalSliceAddr              = BUF_LSA(dataBufEntry);
+            REQ_LSA(reqSlotTag)                                  = BUF_LSA(dataBufEntry);
             REQ_ENTRY(reqSlotTag)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_ENTRY;
             REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_PHY_ORG;
             REQ_ENTRY(reqSlotTag)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
             REQ_ENTRY(reqSlotTag)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
             REQ_ENTRY(reqSlotTag)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
             REQ_ENTRY(reqSlotTag)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-            REQ_ENTRY(reqSlotTag)->dataBufInfo.entry             = dataBufEntry;
-            REQ_ENTRY(reqSlotTag)->nandInfo.physicalCh           = iCh;
-            REQ_ENTRY(reqSlotTag)->nandInfo.physicalWay          = iWay;
-            REQ_ENTRY(reqSlotTag)->nandInfo.physicalBlock        = iPBlk;
-            REQ_ENTRY(reqSlotTag)->nandInfo.physicalPage         = iPage;
+            REQ_DATA_BUF_INFO(reqSlotTag).entry                  = dataBufEntry;
+            REQ_NAND_INFO(reqSlotTag).physicalCh                 = iCh;
+            REQ_NAND_INFO(reqSlotTag).physicalWay                = iWay;
+            REQ_NAND_INFO(reqSlotTag).physicalBlock              = iPBlk;
+            REQ_NAND_INFO(reqSlotTag).physicalPage               = iPage;
 
             pr_info("Req[%u]: Write Ch[%u].Way[%u].PBlk[%u].Page[%u]", reqSlotTag, iCh, iWay, iPBlk, iPage);
+
+            ChargeDataBufToDie(dataBufEntry, iDie);
         }
         else
         {
@@ -322,15 +353,17 @@ void EvictDataBufEntry(unsigned int originReqSlotTag)
             REQ_ENTRY(reqSlotTag)->reqType                       = REQ_TYPE_NAND;
             REQ_ENTRY(reqSlotTag)->reqCode                       = REQ_CODE_WRITE;
             REQ_ENTRY(reqSlotTag)->nvmeCmdSlotTag                = REQ_ENTRY(originReqSlotTag)->nvmeCmdSlotTag;
-            REQ_ENTRY(reqSlotTag)->logicalSliceAddr              = BUF_LSA(dataBufEntry);
+            REQ_LSA(reqSlotTag)                                  = BUF_LSA(dataBufEntry);
             REQ_ENTRY(reqSlotTag)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_ENTRY;
             REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_VSA;
             REQ_ENTRY(reqSlotTag)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
             REQ_ENTRY(reqSlotTag)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
             REQ_ENTRY(reqSlotTag)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
             REQ_ENTRY(reqSlotTag)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_MAIN;
-            REQ_ENTRY(reqSlotTag)->dataBufInfo.entry             = dataBufEntry;
-            REQ_ENTRY(reqSlotTag)->nandInfo.virtualSliceAddr     = virtualSliceAddr;
+            REQ_DATA_BUF_INFO(reqSlotTag).entry                  = dataBufEntry;
+            REQ_NAND_INFO(reqSlotTag).virtualSliceAddr           = virtualSliceAddr;
+
+            ChargeDataBufToDie(dataBufEntry, VSA2VDIE(virtualSliceAddr));
         }
 
         UpdateDataBufEntryInfoBlockingReq(dataBufEntry, reqSlotTag);
@@ -384,18 +417,23 @@ void DataReadFromNand(unsigned int originReqSlotTag)
         REQ_ENTRY(reqSlotTag)->reqType                       = REQ_TYPE_NAND;
         REQ_ENTRY(reqSlotTag)->reqCode                       = REQ_CODE_READ;
         REQ_ENTRY(reqSlotTag)->nvmeCmdSlotTag                = REQ_ENTRY(originReqSlotTag)->nvmeCmdSlotTag;
-        REQ_ENTRY(reqSlotTag)->logicalSliceAddr              = REQ_LSA(originReqSlotTag);
+        REQ_LSA(reqSlotTag)                                  = REQ_LSA(originReqSlotTag);
         REQ_ENTRY(reqSlotTag)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_ENTRY;
         REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_VSA;
         REQ_ENTRY(reqSlotTag)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
         REQ_ENTRY(reqSlotTag)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
         REQ_ENTRY(reqSlotTag)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
         REQ_ENTRY(reqSlotTag)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_MAIN;
-        REQ_ENTRY(reqSlotTag)->dataBufInfo.entry             = REQ_ENTRY(originReqSlotTag)->dataBufInfo.entry;
-        REQ_ENTRY(reqSlotTag)->nandInfo.virtualSliceAddr     = vsa;
+        REQ_DATA_BUF_INFO(reqSlotTag).entry                  = REQ_DATA_BUF_INFO(originReqSlotTag).entry;
+        REQ_NAND_INFO(reqSlotTag).virtualSliceAddr           = vsa;
+
+#if (READ_DISTURB_REFRESH)
+        CountReadDisturb(vsa);
+#endif
 
         // dispatch request
-        UpdateDataBufEntryInfoBlockingReq(REQ_ENTRY(reqSlotTag)->dataBufInfo.entry, reqSlotTag);
+        ChargeDataBufToDie(REQ_DATA_BUF_INFO(reqSlotTag).entry, VSA2VDIE(vsa));
+        UpdateDataBufEntryInfoBlockingReq(REQ_DATA_BUF_INFO(reqSlotTag).entry, reqSlotTag);
         SelectLowLevelReqQ(reqSlotTag);
     }
     else if (REQ_CODE_IS(originReqSlotTag, REQ_CODE_OCSSD_PHY_READ))
@@ -411,29 +449,275 @@ void DataReadFromNand(unsigned int originReqSlotTag)
         REQ_ENTRY(reqSlotTag)->reqType                       = REQ_TYPE_NAND;
         REQ_ENTRY(reqSlotTag)->reqCode                       = REQ_CODE_READ;
         REQ_ENTRY(reqSlotTag)->nvmeCmdSlotTag                = REQ_ENTRY(originReqSlotTag)->nvmeCmdSlotTag;
-        REQ_ENTRY(reqSlotTag)->logicalSliceAddr              = REQ_LSA(originReqSlotTag);
+        REQ_LSA(reqSlotTag)                                  = REQ_LSA(originReqSlotTag);
         REQ_ENTRY(reqSlotTag)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_ENTRY;
         REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_PHY_ORG;
         REQ_ENTRY(reqSlotTag)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
         REQ_ENTRY(reqSlotTag)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
         REQ_ENTRY(reqSlotTag)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_NONE;
         REQ_ENTRY(reqSlotTag)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_TOTAL;
-        REQ_ENTRY(reqSlotTag)->dataBufInfo.entry             = REQ_ENTRY(originReqSlotTag)->dataBufInfo.entry;
-        REQ_ENTRY(reqSlotTag)->nandInfo.physicalCh           = iCh;
-        REQ_ENTRY(reqSlotTag)->nandInfo.physicalWay          = iWay;
-        REQ_ENTRY(reqSlotTag)->nandInfo.physicalBlock        = iPBlk;
-        REQ_ENTRY(reqSlotTag)->nandInfo.physicalPage         = iPage;
+        REQ_DATA_BUF_INFO(reqSlotTag).entry                  = REQ_DATA_BUF_INFO(originReqSlotTag).entry;
+        REQ_NAND_INFO(reqSlotTag).physicalCh                 = iCh;
+        REQ_NAND_INFO(reqSlotTag).physicalWay                = iWay;
+        REQ_NAND_INFO(reqSlotTag).physicalBlock              = iPBlk;
+        REQ_NAND_INFO(reqSlotTag).physicalPage               = iPage;
 
         pr_info("Req[%u]: Read Ch[%u].Way[%u].PBlk[%u].Page[%u]", reqSlotTag, iCh, iWay, iPBlk, iPage);
 
         // dispatch request
-        UpdateDataBufEntryInfoBlockingReq(REQ_ENTRY(reqSlotTag)->dataBufInfo.entry, reqSlotTag);
+        ChargeDataBufToDie(REQ_DATA_BUF_INFO(reqSlotTag).entry, VSA2VDIE(REQ_LSA(originReqSlotTag)));
+        UpdateDataBufEntryInfoBlockingReq(REQ_DATA_BUF_INFO(reqSlotTag).entry, reqSlotTag);
         SelectLowLevelReqQ(reqSlotTag);
     }
     else
         ASSERT(0, "Req[%u]: Unexpected reqCode: %u", originReqSlotTag, REQ_ENTRY(originReqSlotTag)->reqCode);
 }
 
+/**
+ * @brief Merge the NAND content into the missing NVMe blocks of a data buffer entry.
+ *
+ * When `DATA_BUF_DEFER_RMW` is enabled, a write that covers only part of a slice will not
+ * read the old page on buffer miss. Instead, only the written NVMe blocks are marked in
+ * `DATA_BUF_ENTRY::sectorValid`, so later writes to the same slice can be merged into the
+ * buffer for free. This function must be called before the entry is programmed or before
+ * a read request accesses a missing NVMe block:
+ *
+ * 1. If the slice has never been mapped, there is nothing to merge and the entry can be
+ *    treated as fully valid directly.
+ *
+ * 2. Otherwise, read the old page into the temp buffer of the target die and wait until
+ *    the read is done, then copy the missing NVMe blocks (and the spare data) to the data
+ *    buffer entry. The host data already received won't be overwritten.
+ *
+ * @note The missing NVMe blocks are never touched by any pending request of this entry,
+ * since the pending DMA requests only access the valid NVMe blocks and a partially valid
+ * entry is never programmed. Therefore, only the temp buffer needs to be synchronized.
+ *
+ * @warning This function spins the scheduler until the read is done, so it should only be
+ * called from the front end, like `SyncAvailFreeReq()`.
+ *
+ * @sa `ReqTransSliceToLowLevel()`, `EvictDataBufEntry()`, `FlushDataBuf()`.
+ *
+ * @param bufEntry The data buffer entry index of the partially written slice.
+ */
+void FillDataBufEntry(unsigned int bufEntry)
+{
+    uint32_t reqSlotTag, vsa, tempBufEntry, iSector, bufAddr, tempBufAddr;
+
+    if (BUF_SECTOR_IS_FULL(bufEntry))
+        return;
+
+    vsa = AddrTransRead(BUF_LSA(bufEntry));
+    if (vsa == VSA_FAIL)
+    {
+        // no old data to be merged
+        BUF_ENTRY(bufEntry)->sectorValid = DATA_BUF_SECTOR_FULL;
+        dataBufFillStat.avoidedCnt++;
+        return;
+    }
+
+    tempBufEntry = AllocateTempDataBuf(VSA2VDIE(vsa));
+    reqSlotTag   = GetFromFreeReqQ();
+
+    REQ_ENTRY(reqSlotTag)->reqType                       = REQ_TYPE_NAND;
+    REQ_ENTRY(reqSlotTag)->reqCode                       = REQ_CODE_READ;
+    REQ_ENTRY(reqSlotTag)->nvmeCmdSlotTag                = REQ_SLOT_TAG_NONE;
+    REQ_LSA(reqSlotTag)                                  = BUF_LSA(bufEntry);
+    REQ_ENTRY(reqSlotTag)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_TEMP_ENTRY;
+    REQ_ENTRY(reqSlotTag)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_VSA;
+    REQ_ENTRY(reqSlotTag)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
+    REQ_ENTRY(reqSlotTag)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
+    REQ_ENTRY(reqSlotTag)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
+    REQ_ENTRY(reqSlotTag)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_MAIN;
+    REQ_DATA_BUF_INFO(reqSlotTag).entry                  = tempBufEntry;
+    REQ_NAND_INFO(reqSlotTag).virtualSliceAddr           = vsa;
+
+    pr_debug("Buf[%u]: Fill sectors 0x%x from VSA[%u]", bufEntry, BUF_ENTRY(bufEntry)->sectorValid, vsa);
+
+    UpdateTempDataBufEntryInfoBlockingReq(tempBufEntry, reqSlotTag);
+    SelectLowLevelReqQ(reqSlotTag);
+
+    // the blocking queue of the temp buffer becomes empty after the read is done
+    while (TEMP_BUF_ENTRY(tempBufEntry)->blockingReqTail != REQ_SLOT_TAG_NONE)
+    {
+        CheckDoneNvmeDmaReq();
+        SchedulingNandReq();
+    }
+
+    // merge the missing NVMe blocks only
+    bufAddr     = BUF_DATA_ENTRY2ADDR(bufEntry);
+    tempBufAddr = TEMP_BUF_DATA_ENTRY2ADDR(tempBufEntry);
+    for (iSector = 0; iSector < NVME_BLOCKS_PER_SLICE; iSector++)
+        if (!(BUF_ENTRY(bufEntry)->sectorValid & (1 << iSector)))
+            memcpy((void *)(bufAddr + iSector * BYTES_PER_NVME_BLOCK),
+                   (void *)(tempBufAddr + iSector * BYTES_PER_NVME_BLOCK), BYTES_PER_NVME_BLOCK);
+    memcpy((void *)BUF_SPARE_ENTRY2ADDR(bufEntry), (void *)TEMP_BUF_SPARE_ENTRY2ADDR(tempBufEntry),
+           BYTES_PER_SPARE_REGION_OF_SLICE);
+
+    BUF_ENTRY(bufEntry)->sectorValid = DATA_BUF_SECTOR_FULL;
+    dataBufFillStat.performedCnt++;
+}
+
+/**
+ * @brief Allocate a program request that writes the data buffer entry of the given slice
+ * request to NAND.
+ *
+ * The returned request is not dispatched yet, the caller should append it to the blocking
+ * request queue of the buffer entry after the Rx DMA request, so that the program will be
+ * issued once the data is received.
+ *
+ * @param reqSlotTag The request pool entry index of the slice request.
+ * @return unsigned int The request pool entry index of the program request.
+ */
+static unsigned int AllocateProgramReq(unsigned int reqSlotTag)
+{
+    unsigned int nandReqSlotTag, virtualSliceAddr, bufEntry;
+
+    bufEntry         = REQ_DATA_BUF_INFO(reqSlotTag).entry;
+    nandReqSlotTag   = GetFromFreeReqQ();
+    virtualSliceAddr = AddrTransWrite(REQ_LSA(reqSlotTag));
+
+    REQ_ENTRY(nandReqSlotTag)->reqType                       = REQ_TYPE_NAND;
+    REQ_ENTRY(nandReqSlotTag)->reqCode                       = REQ_CODE_WRITE;
+    REQ_ENTRY(nandReqSlotTag)->nvmeCmdSlotTag                = REQ_ENTRY(reqSlotTag)->nvmeCmdSlotTag;
+    REQ_LSA(nandReqSlotTag)                                  = REQ_LSA(reqSlotTag);
+    REQ_ENTRY(nandReqSlotTag)->reqOpt.dataBufFormat          = REQ_OPT_DATA_BUF_ENTRY;
+    REQ_ENTRY(nandReqSlotTag)->reqOpt.nandAddr               = REQ_OPT_NAND_ADDR_VSA;
+    REQ_ENTRY(nandReqSlotTag)->reqOpt.nandEcc                = REQ_OPT_NAND_ECC_ON;
+    REQ_ENTRY(nandReqSlotTag)->reqOpt.nandEccWarning         = REQ_OPT_NAND_ECC_WARNING_ON;
+    REQ_ENTRY(nandReqSlotTag)->reqOpt.rowAddrDependencyCheck = REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK;
+    REQ_ENTRY(nandReqSlotTag)->reqOpt.blockSpace             = REQ_OPT_BLOCK_SPACE_MAIN;
+    REQ_ENTRY(nandReqSlotTag)->reqOpt.fua                    = REQ_ENTRY(reqSlotTag)->reqOpt.fua;
+    REQ_DATA_BUF_INFO(nandReqSlotTag).entry                  = bufEntry;
+    REQ_NAND_INFO(nandReqSlotTag).virtualSliceAddr           = virtualSliceAddr;
+
+    ChargeDataBufToDie(bufEntry, VSA2VDIE(virtualSliceAddr));
+
+    return nandReqSlotTag;
+}
+
+/**
+ * @brief Confirm a program request of a FUA write and complete the command if possible.
+ *
+ * Since the Rx DMAs of a FUA write are issued with auto completion off, the NVMe command
+ * must be completed here after the last program of the command is done. If any program
+ * failed, the command will be completed with the status "Write Fault".
+ *
+ * @note This function is called by `GetFromNandReqQ()` before releasing the request.
+ *
+ * @param reqSlotTag The request pool entry index of the finished program request.
+ * @param reqStatus The status of the program request, `REQ_STATUS_FAIL` for failure.
+ */
+void ReleaseFuaProgramReq(unsigned int reqSlotTag, unsigned int reqStatus)
+{
+    unsigned int cmdSlotTag;
+    NVME_COMPLETION nvmeCPL;
+
+    cmdSlotTag = REQ_ENTRY(reqSlotTag)->nvmeCmdSlotTag;
+    ASSERT(fuaCmdTable[cmdSlotTag].pendingProgCnt, "No pending FUA program for cmd %u", cmdSlotTag);
+
+    if (reqStatus == REQ_STATUS_FAIL)
+        fuaCmdTable[cmdSlotTag].programFail = 1;
+
+    fuaCmdTable[cmdSlotTag].pendingProgCnt--;
+    if (fuaCmdTable[cmdSlotTag].pendingProgCnt)
+        return;
+
+    nvmeCPL.dword[0] = 0;
+    nvmeCPL.specific = 0x0;
+    if (fuaCmdTable[cmdSlotTag].programFail)
+    {
+        nvmeCPL.statusField.SCT = SCT_MEDIA_AND_DATA_INTEGRITY_ERRORS;
+        nvmeCPL.statusField.SC  = SC_WRITE_FAULT;
+        pr_warn("FUA write failed (cmdSlotTag = %u)", cmdSlotTag);
+    }
+    set_auto_nvme_cpl(cmdSlotTag, nvmeCPL.specific, nvmeCPL.statusFieldWord);
+
+    fuaCmdTable[cmdSlotTag].programFail = 0;
+}
+
+/**
+ * @brief Serve the given slice request with a transient buffer entry if possible.
+ *
+ * For streaming I/O (check `CheckDataBufBypass()`), the data is staged in a transient
+ * buffer entry that is never inserted into the hash table and the LRU list, so it won't
+ * evict the working set of other workloads:
+ *
+ * - For a read request, the page is read into the transient entry and then sent to the
+ *   host, just like a cache miss.
+ *
+ * - For a write request, the data received from the host is programmed right after the
+ *   Rx DMA is done (write through), since the transient entry cannot be kept dirty.
+ *
+ * The transient entry is returned to the pool once the last request in its blocking
+ * request queue is done (check `ReleaseBlockedByBufDepReq()`).
+ *
+ * @note Only full slice requests can bypass the cache, partial slices need to be merged
+ * with the cached data. Also, the cache must be checked before calling this function, to
+ * avoid reading stale data from flash.
+ *
+ * @warning The program request must be allocated before dispatching the Rx DMA request,
+ * otherwise the transient entry may be released once the Rx DMA is done during the
+ * `SyncAvailFreeReq()` or GC triggered by allocating the program request.
+ *
+ * @param reqSlotTag The request pool entry index of the slice request.
+ * @return unsigned int 1 if the request has been dispatched, 0 if it should be cached.
+ */
+unsigned int ReqTransSliceToBypass(unsigned int reqSlotTag)
+{
+    unsigned int bufEntry, nandReqSlotTag;
+
+    if (REQ_ENTRY(reqSlotTag)->reqOpt.dataBufBypass != REQ_OPT_DATA_BUF_BYPASS_ON)
+        return 0;
+    if (REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock != NVME_BLOCKS_PER_SLICE)
+        return 0;
+    if (!REQ_CODE_IS(reqSlotTag, REQ_CODE_READ) && !REQ_CODE_IS(reqSlotTag, REQ_CODE_WRITE))
+        return 0;
+
+    bufEntry = AllocateBypassDataBuf();
+    if (bufEntry == DATA_BUF_FAIL)
+    {
+        dataBufCacheStat.bypassFallbackCnt++;
+        return 0;
+    }
+    dataBufCacheStat.bypassCnt++;
+    pr_debug("Cache Bypass! Use transient Buffer[%u] for Req[%u]", bufEntry, reqSlotTag);
+
+    BUF_ENTRY(bufEntry)->logicalSliceAddr = REQ_LSA(reqSlotTag);
+    BUF_ENTRY(bufEntry)->dirty            = DATA_BUF_CLEAN;
+    BUF_ENTRY(bufEntry)->phyReq           = DATA_BUF_FOR_LOG_REQ;
+    BUF_ENTRY(bufEntry)->sectorValid      = DATA_BUF_SECTOR_FULL;
+
+    REQ_DATA_BUF_INFO(reqSlotTag).entry         = bufEntry;
+    REQ_ENTRY(reqSlotTag)->reqOpt.dataBufFormat = REQ_OPT_DATA_BUF_ENTRY;
+
+    nandReqSlotTag = REQ_SLOT_TAG_NONE;
+    if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ))
+    {
+        DataReadFromNand(reqSlotTag);
+        REQ_ENTRY(reqSlotTag)->reqCode = REQ_CODE_TxDMA;
+    }
+    else
+    {
+        nandReqSlotTag                 = AllocateProgramReq(reqSlotTag);
+        REQ_ENTRY(reqSlotTag)->reqCode = REQ_CODE_RxDMA;
+    }
+
+    // dispatch the NVMe DMA request
+    REQ_ENTRY(reqSlotTag)->reqType = REQ_TYPE_NVME_DMA;
+    UpdateDataBufEntryInfoBlockingReq(bufEntry, reqSlotTag);
+    SelectLowLevelReqQ(reqSlotTag);
+
+    // program the received data after the Rx DMA is done
+    if (nandReqSlotTag != REQ_SLOT_TAG_NONE)
+    {
+        UpdateDataBufEntryInfoBlockingReq(bufEntry, nandReqSlotTag);
+        SelectLowLevelReqQ(nandReqSlotTag);
+    }
+
+    return 1;
+}
+
 /**
  * @brief Data Buffer Manager. Handle all the pending slice requests.
  *
@@ -459,10 +743,10 @@ void DataReadFromNand(unsigned int originReqSlotTag)
  */
 void ReqTransSliceToLowLevel()
 {
-    unsigned int reqSlotTag, dataBufEntry;
+    unsigned int reqSlotTag, dataBufEntry, sectorMask, nandReqSlotTag;
 
     // consume all pending slice requests in slice request queue
-    while (sliceReqQ.headReq != REQ_SLOT_TAG_NONE)
+    while (sliceReqQ.reqCnt)
     {
         // get the request pool entry index of the slice request
         reqSlotTag = GetFromSliceReqQ();
@@ -477,23 +761,46 @@ void ReqTransSliceToLowLevel()
          * If the data buffer not exists, we must allocate a data buffer entry by calling
          * `AllocateDataBuf()` and initialize the newly created data buffer.
          */
+        sectorMask = DATA_BUF_SECTOR_MASK(REQ_NVME_DMA_INFO(reqSlotTag).nvmeBlockOffset,
+                                          REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock);
         dataBufEntry = CheckDataBufHit(reqSlotTag);
         if (dataBufEntry != DATA_BUF_FAIL)
         {
             // data buffer hit
-            REQ_ENTRY(reqSlotTag)->dataBufInfo.entry = dataBufEntry;
+            dataBufCacheStat.hitCnt++;
+            REQ_DATA_BUF_INFO(reqSlotTag).entry = dataBufEntry;
             pr_debug("Cache Hit! Use Buffer[%u] for Req[%u]", dataBufEntry, reqSlotTag);
+
+            // the buffer may be partially written, merge the old data if needed
+            if (REQ_CODE_IS(reqSlotTag, REQ_CODE_READ))
+            {
+                if ((BUF_ENTRY(dataBufEntry)->sectorValid & sectorMask) != sectorMask)
+                    FillDataBufEntry(dataBufEntry);
+            }
+            else if (REQ_CODE_IS(reqSlotTag, REQ_CODE_WRITE) && !BUF_SECTOR_IS_FULL(dataBufEntry))
+            {
+                BUF_ENTRY(dataBufEntry)->sectorValid |= sectorMask;
+                if (BUF_SECTOR_IS_FULL(dataBufEntry))
+                    dataBufFillStat.avoidedCnt++; // the whole slice is written by host
+            }
+        }
+        else if (ReqTransSliceToBypass(reqSlotTag))
+        {
+            // streaming request, served by a transient buffer without polluting the cache
+            continue;
         }
         else
         {
             // data buffer miss, allocate a new buffer entry
-            dataBufEntry                             = AllocateDataBuf();
-            REQ_ENTRY(reqSlotTag)->dataBufInfo.entry = dataBufEntry;
+            dataBufCacheStat.missCnt++;
+            dataBufEntry                        = AllocateDataBuf();
+            REQ_DATA_BUF_INFO(reqSlotTag).entry = dataBufEntry;
             pr_debug("Cache Miss! Allocate new Buffer[%u] for Req[%u]", dataBufEntry, reqSlotTag);
 
             // initialize the newly allocated data buffer entry for this request
             EvictDataBufEntry(reqSlotTag);
             BUF_ENTRY(dataBufEntry)->logicalSliceAddr = REQ_LSA(reqSlotTag);
+            BUF_ENTRY(dataBufEntry)->sectorValid      = DATA_BUF_SECTOR_FULL;
             PutToDataBufHashList(dataBufEntry);
 
             /*
@@ -510,9 +817,17 @@ void ReqTransSliceToLowLevel()
 
             case REQ_CODE_WRITE:
                 // in case of not overwriting a whole page, read current page content for migration
-                if (REQ_ENTRY(reqSlotTag)->nvmeDmaInfo.numOfNvmeBlock != NVME_BLOCKS_PER_SLICE)
+                if (REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock != NVME_BLOCKS_PER_SLICE)
+                {
+#if (DATA_BUF_DEFER_RMW)
+                    // defer the read until the buffer must be programmed (`FillDataBufEntry()`)
+                    BUF_ENTRY(dataBufEntry)->sectorValid = sectorMask;
+                    dataBufFillStat.deferredCnt++;
+#else
                     // for read modify write
                     DataReadFromNand(reqSlotTag);
+#endif /* DATA_BUF_DEFER_RMW */
+                }
                 break;
 
             default:
@@ -575,10 +890,30 @@ void ReqTransSliceToLowLevel()
 
         pr_debug("NVMe request (%X) generated:", REQ_ENTRY(reqSlotTag)->reqCode);
         pr_debug("\t reqCode = 0x%x", REQ_ENTRY(reqSlotTag)->reqCode);
-        pr_debug("\t dataBufEntry = 0x%x", REQ_ENTRY(reqSlotTag)->dataBufInfo.entry);
+        pr_debug("\t dataBufEntry = 0x%x", REQ_DATA_BUF_INFO(reqSlotTag).entry);
+
+        /*
+         * The data of a FUA write should be programmed right after being received, so the
+         * buffer entry is kept clean and must be filled before the program is issued.
+         */
+        nandReqSlotTag = REQ_SLOT_TAG_NONE;
+        if (REQ_ENTRY(reqSlotTag)->reqOpt.fua == REQ_OPT_FUA_ON)
+        {
+            if (!BUF_SECTOR_IS_FULL(dataBufEntry))
+                FillDataBufEntry(dataBufEntry);
+
+            BUF_ENTRY(dataBufEntry)->dirty = DATA_BUF_CLEAN;
+            nandReqSlotTag                 = AllocateProgramReq(reqSlotTag);
+        }
 
         UpdateDataBufEntryInfoBlockingReq(dataBufEntry, reqSlotTag);
         SelectLowLevelReqQ(reqSlotTag);
+
+        if (nandReqSlotTag != REQ_SLOT_TAG_NONE)
+        {
+            UpdateDataBufEntryInfoBlockingReq(dataBufEntry, nandReqSlotTag);
+            SelectLowLevelReqQ(nandReqSlotTag);
+        }
     }
 }
 
@@ -648,11 +983,11 @@ unsigned int CheckRowAddrDep(unsigned int reqSlotTag, unsigned int checkRowAddrD
 
     if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_VSA)
     {
-        dieNo   = Vsa2VdieTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
+        dieNo   = Vsa2VdieTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
         chNo    = Vdie2PchTranslation(dieNo);
         wayNo   = Vdie2PwayTranslation(dieNo);
-        blockNo = Vsa2VblockTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
-        pageNo  = Vsa2VpageTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
+        blockNo = Vsa2VblockTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
+        pageNo  = Vsa2VpageTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
     }
     else
         assert(!"[WARNING] Not supported reqOpt-nandAddress [WARNING]");
@@ -680,7 +1015,9 @@ unsigned int CheckRowAddrDep(unsigned int reqSlotTag, unsigned int checkRowAddrD
         {
             if (pageNo < rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].permittedProgPage)
             {
+                // the blocked erase may pass now
                 rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].blockedReadReqCnt--;
+                PutToRowAddrDepWakeList(chNo, wayNo, blockNo);
                 return ROW_ADDR_DEPENDENCY_REPORT_PASS;
             }
         }
@@ -694,6 +1031,9 @@ unsigned int CheckRowAddrDep(unsigned int reqSlotTag, unsigned int checkRowAddrD
         {
             rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].permittedProgPage++;
             pr_debug("PASS, permittedProgPage = %u", ROW_ADDR_DEP_ENTRY(chNo, wayNo, blockNo)->permittedProgPage);
+
+            // the blocked reads of this page and the program of the next page may pass now
+            PutToRowAddrDepWakeList(chNo, wayNo, blockNo);
             return ROW_ADDR_DEPENDENCY_REPORT_PASS;
         }
         pr_debug("BLOCKED, permittedProgPage = %u, pageNo = %u",
@@ -703,13 +1043,15 @@ unsigned int CheckRowAddrDep(unsigned int reqSlotTag, unsigned int checkRowAddrD
     {
         // FIXME: why check this
         if (rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].permittedProgPage ==
-            reqPoolPtr->reqPool[reqSlotTag].nandInfo.programmedPageCnt)
+            REQ_NAND_INFO(reqSlotTag).programmedPageCnt)
         {
             if (rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].blockedReadReqCnt == 0)
             {
                 rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].permittedProgPage   = 0;
                 rowAddrDependencyTablePtr->block[chNo][wayNo][blockNo].blockedEraseReqFlag = 0;
 
+                // the blocked programs of the first page may pass now
+                PutToRowAddrDepWakeList(chNo, wayNo, blockNo);
                 return ROW_ADDR_DEPENDENCY_REPORT_PASS;
             }
         }
@@ -756,11 +1098,11 @@ unsigned int UpdateRowAddrDepTableForBufBlockedReq(unsigned int reqSlotTag)
 
     if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_VSA)
     {
-        dieNo   = Vsa2VdieTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
+        dieNo   = Vsa2VdieTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
         chNo    = Vdie2PchTranslation(dieNo);
         wayNo   = Vdie2PwayTranslation(dieNo);
-        blockNo = Vsa2VblockTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
-        pageNo  = Vsa2VpageTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
+        blockNo = Vsa2VblockTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
+        pageNo  = Vsa2VpageTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
     }
     else
         assert(!"[WARNING] Not supported reqOpt-nandAddress [WARNING]");
@@ -841,6 +1183,10 @@ void SelectLowLevelReqQ(unsigned int reqSlotTag)
 {
     unsigned int dieNo, chNo, wayNo, bufDepCheckReport, rowAddrDepCheckReport, rowAddrDepTableUpdateReport;
 
+#if (GROWN_BAD_BLOCK_SALVAGE)
+    UpdateInFlightProgramCnt(reqSlotTag, 1);
+#endif
+
     bufDepCheckReport = CheckBufDep(reqSlotTag);
 
     if (bufDepCheckReport == BUF_DEPENDENCY_REPORT_PASS)
@@ -855,15 +1201,15 @@ void SelectLowLevelReqQ(unsigned int reqSlotTag)
             // get physical organization info from VSA
             if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_VSA)
             {
-                dieNo = Vsa2VdieTranslation(reqPoolPtr->reqPool[reqSlotTag].nandInfo.virtualSliceAddr);
+                dieNo = Vsa2VdieTranslation(REQ_NAND_INFO(reqSlotTag).virtualSliceAddr);
                 chNo  = Vdie2PchTranslation(dieNo);
                 wayNo = Vdie2PwayTranslation(dieNo);
             }
             // if the physical organization info is already specified, use it without translating
             else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_PHY_ORG)
             {
-                chNo  = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalCh;
-                wayNo = reqPoolPtr->reqPool[reqSlotTag].nandInfo.physicalWay;
+                chNo  = REQ_NAND_INFO(reqSlotTag).physicalCh;
+                wayNo = REQ_NAND_INFO(reqSlotTag).physicalWay;
             }
             else
                 assert(!"[WARNING] Not supported reqOpt-nandAddress [WARNING]");
@@ -950,17 +1296,20 @@ void ReleaseBlockedByBufDepReq(unsigned int reqSlotTag)
     // reset blocking request queue if it is the last request blocked by the buffer dependency
     if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_ENTRY)
     {
-        if (dataBufMapPtr->dataBuf[reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry].blockingReqTail ==
-            reqSlotTag)
-            dataBufMapPtr->dataBuf[reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry].blockingReqTail =
-                REQ_SLOT_TAG_NONE;
+        if (dataBufMapPtr->dataBuf[REQ_DATA_BUF_INFO(reqSlotTag).entry].blockingReqTail == reqSlotTag)
+        {
+            dataBufMapPtr->dataBuf[REQ_DATA_BUF_INFO(reqSlotTag).entry].blockingReqTail = REQ_SLOT_TAG_NONE;
+
+            // the buffer entry is no longer used by any request
+            UnchargeDataBuf(REQ_DATA_BUF_INFO(reqSlotTag).entry);
+            if (BUF_ENTRY_IS_BYPASS(REQ_DATA_BUF_INFO(reqSlotTag).entry))
+                ReleaseBypassDataBuf(REQ_DATA_BUF_INFO(reqSlotTag).entry);
+        }
     }
     else if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.dataBufFormat == REQ_OPT_DATA_BUF_TEMP_ENTRY)
     {
-        if (tempDataBufMapPtr->tempDataBuf[reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry].blockingReqTail ==
-            reqSlotTag)
-            tempDataBufMapPtr->tempDataBuf[reqPoolPtr->reqPool[reqSlotTag].dataBufInfo.entry].blockingReqTail =
-                REQ_SLOT_TAG_NONE;
+        if (tempDataBufMapPtr->tempDataBuf[REQ_DATA_BUF_INFO(reqSlotTag).entry].blockingReqTail == reqSlotTag)
+            tempDataBufMapPtr->tempDataBuf[REQ_DATA_BUF_INFO(reqSlotTag).entry].blockingReqTail = REQ_SLOT_TAG_NONE;
     }
 
     /*
@@ -981,7 +1330,7 @@ void ReleaseBlockedByBufDepReq(unsigned int reqSlotTag)
         {
             if (reqPoolPtr->reqPool[targetReqSlotTag].reqOpt.nandAddr == REQ_OPT_NAND_ADDR_VSA)
             {
-                dieNo = Vsa2VdieTranslation(reqPoolPtr->reqPool[targetReqSlotTag].nandInfo.virtualSliceAddr);
+                dieNo = Vsa2VdieTranslation(REQ_NAND_INFO(targetReqSlotTag).virtualSliceAddr);
                 chNo  = Vdie2PchTranslation(dieNo);
                 wayNo = Vdie2PwayTranslation(dieNo);
             }
@@ -1011,50 +1360,55 @@ void ReleaseBlockedByBufDepReq(unsigned int reqSlotTag)
 }
 
 /**
- * @brief Update the row address dependency of all the requests on the specified die.
+ * @brief Update the row address dependency of the blocked requests on the specified die.
  *
- * Traverse the `blockedByRowAddrDepReqQ` of the specified die, and then recheck the row
- * address dependency for all the requests on that die. When a request is found that it
- * can pass the dependency check, it will be dispatched (move to the NAND request queue).
+ * Only the blocks in the wake list of the specified die are rechecked, since the other
+ * blocks didn't change their dependency info after their requests were blocked. When a
+ * request is found that it can pass the dependency check, it will be dispatched (move to
+ * the NAND request queue).
  *
- * By updating the row address dependency info, some requests on the target die may be
- * released.
+ * A released request may relax the dependency of its block again (e.g. the program of the
+ * next page), which puts the block back to the wake list, so the loop ends only when no
+ * more requests can be released.
  *
- * @sa `CheckRowAddrDep()`.
+ * @sa `CheckRowAddrDep()`, `PutToRowAddrDepWakeList()`.
  *
  * @param chNo The channel number of the specified die.
  * @param wayNo The way number of the specified die.
  */
 void ReleaseBlockedByRowAddrDepReq(unsigned int chNo, unsigned int wayNo)
 {
-    unsigned int reqSlotTag, nextReq, rowAddrDepCheckReport;
-
-    reqSlotTag = blockedByRowAddrDepReqQ[chNo][wayNo].headReq;
+    unsigned int blockNo, reqSlotTag, nextReq, rowAddrDepCheckReport;
 
-    while (reqSlotTag != REQ_SLOT_TAG_NONE)
+    while ((blockNo = GetFromRowAddrDepWakeList(chNo, wayNo)) != ROW_ADDR_DEP_BLOCK_NONE)
     {
-        nextReq = reqPoolPtr->reqPool[reqSlotTag].nextReq;
+        reqSlotTag = ROW_ADDR_DEP_QUEUE(chNo, wayNo, blockNo)->headReq;
 
-        if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck == REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK)
+        while (reqSlotTag != REQ_SLOT_TAG_NONE)
         {
-            rowAddrDepCheckReport = CheckRowAddrDep(reqSlotTag, ROW_ADDR_DEPENDENCY_CHECK_OPT_RELEASE);
+            nextReq = reqPoolPtr->reqPool[reqSlotTag].nextReq;
 
-            if (rowAddrDepCheckReport == ROW_ADDR_DEPENDENCY_REPORT_PASS)
-            {
-                SelectiveGetFromBlockedByRowAddrDepReqQ(reqSlotTag, chNo, wayNo);
-                PutToNandReqQ(reqSlotTag, chNo, wayNo);
-            }
-            else if (rowAddrDepCheckReport == ROW_ADDR_DEPENDENCY_REPORT_BLOCKED)
+            if (reqPoolPtr->reqPool[reqSlotTag].reqOpt.rowAddrDependencyCheck == REQ_OPT_ROW_ADDR_DEPENDENCY_CHECK)
             {
-                // pass, go to while loop
+                rowAddrDepCheckReport = CheckRowAddrDep(reqSlotTag, ROW_ADDR_DEPENDENCY_CHECK_OPT_RELEASE);
+
+                if (rowAddrDepCheckReport == ROW_ADDR_DEPENDENCY_REPORT_PASS)
+                {
+                    SelectiveGetFromBlockedByRowAddrDepReqQ(reqSlotTag, chNo, wayNo);
+                    PutToNandReqQ(reqSlotTag, chNo, wayNo);
+                }
+                else if (rowAddrDepCheckReport == ROW_ADDR_DEPENDENCY_REPORT_BLOCKED)
+                {
+                    // pass, go to while loop
+                }
+                else
+                    assert(!"[WARNING] Not supported report [WARNING]");
             }
             else
-                assert(!"[WARNING] Not supported report [WARNING]");
-        }
-        else
-            assert(!"[WARNING] Not supported reqOpt [WARNING]");
+                assert(!"[WARNING] Not supported reqOpt [WARNING]");
 
-        reqSlotTag = nextReq;
+            reqSlotTag = nextReq;
+        }
     }
 }
 
@@ -1085,29 +1439,33 @@ void ReleaseBlockedByRowAddrDepReq(unsigned int chNo, unsigned int wayNo)
  */
 void IssueNvmeDmaReq(unsigned int reqSlotTag)
 {
-    unsigned int devAddr, dmaIndex, numOfNvmeBlock;
+    unsigned int devAddr, dmaIndex, numOfNvmeBlock, autoCompletion;
 
-    dmaIndex       = reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.startIndex;
+    dmaIndex       = REQ_NVME_DMA_INFO(reqSlotTag).startIndex;
     devAddr        = GenerateDataBufAddr(reqSlotTag);
     numOfNvmeBlock = 0;
 
     if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_RxDMA)
     {
-        while (numOfNvmeBlock < reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.numOfNvmeBlock)
+        // FUA writes will be completed after programmed, check `ReleaseFuaProgramReq()`
+        autoCompletion = (reqPoolPtr->reqPool[reqSlotTag].reqOpt.fua == REQ_OPT_FUA_ON)
+                             ? NVME_COMMAND_AUTO_COMPLETION_OFF
+                             : NVME_COMMAND_AUTO_COMPLETION_ON;
+
+        while (numOfNvmeBlock < REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock)
         {
-            set_auto_rx_dma(reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag, dmaIndex, devAddr,
-                            NVME_COMMAND_AUTO_COMPLETION_ON);
+            set_auto_rx_dma(reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag, dmaIndex, devAddr, autoCompletion);
 
             numOfNvmeBlock++;
             dmaIndex++;
             devAddr += BYTES_PER_NVME_BLOCK;
         }
-        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.reqTail     = g_hostDmaStatus.fifoTail.autoDmaRx;
-        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.overFlowCnt = g_hostDmaAssistStatus.autoDmaRxOverFlowCnt;
+        REQ_NVME_DMA_INFO(reqSlotTag).reqTail     = g_hostDmaStatus.fifoTail.autoDmaRx;
+        REQ_NVME_DMA_INFO(reqSlotTag).overFlowCnt = g_hostDmaAssistStatus.autoDmaRxOverFlowCnt;
     }
     else if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_TxDMA)
     {
-        while (numOfNvmeBlock < reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.numOfNvmeBlock)
+        while (numOfNvmeBlock < REQ_NVME_DMA_INFO(reqSlotTag).numOfNvmeBlock)
         {
             set_auto_tx_dma(reqPoolPtr->reqPool[reqSlotTag].nvmeCmdSlotTag, dmaIndex, devAddr,
                             NVME_COMMAND_AUTO_COMPLETION_ON);
@@ -1116,8 +1474,8 @@ void IssueNvmeDmaReq(unsigned int reqSlotTag)
             dmaIndex++;
             devAddr += BYTES_PER_NVME_BLOCK;
         }
-        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.reqTail     = g_hostDmaStatus.fifoTail.autoDmaTx;
-        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.overFlowCnt = g_hostDmaAssistStatus.autoDmaTxOverFlowCnt;
+        REQ_NVME_DMA_INFO(reqSlotTag).reqTail     = g_hostDmaStatus.fifoTail.autoDmaTx;
+        REQ_NVME_DMA_INFO(reqSlotTag).overFlowCnt = g_hostDmaAssistStatus.autoDmaTxOverFlowCnt;
     }
     else
         assert(!"[WARNING] Not supported reqCode [WARNING]");
@@ -1139,8 +1497,8 @@ void CheckDoneNvmeDmaReq()
         if (reqPoolPtr->reqPool[reqSlotTag].reqCode == REQ_CODE_RxDMA)
         {
             if (!rxDone)
-                rxDone = check_auto_rx_dma_partial_done(reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.reqTail,
-                                                        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.overFlowCnt);
+                rxDone = check_auto_rx_dma_partial_done(REQ_NVME_DMA_INFO(reqSlotTag).reqTail,
+                                                        REQ_NVME_DMA_INFO(reqSlotTag).overFlowCnt);
 
             if (rxDone)
                 SelectiveGetFromNvmeDmaReqQ(reqSlotTag);
@@ -1148,8 +1506,8 @@ void CheckDoneNvmeDmaReq()
         else
         {
             if (!txDone)
-                txDone = check_auto_tx_dma_partial_done(reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.reqTail,
-                                                        reqPoolPtr->reqPool[reqSlotTag].nvmeDmaInfo.overFlowCnt);
+                txDone = check_auto_tx_dma_partial_done(REQ_NVME_DMA_INFO(reqSlotTag).reqTail,
+                                                        REQ_NVME_DMA_INFO(reqSlotTag).overFlowCnt);
 
             if (txDone)
                 SelectiveGetFromNvmeDmaReqQ(reqSlotTag);
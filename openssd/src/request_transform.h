@@ -48,10 +48,13 @@
 
 #include "ftl_config.h"
 #include "nvme/nvme.h"
+#include "nvme/host_lld.h"
 
 #define NVME_COMMAND_AUTO_COMPLETION_OFF 0
 #define NVME_COMMAND_AUTO_COMPLETION_ON  1
 
+#define NVME_CMD_SLOT_TAG_COUNT (1 << P_SLOT_TAG_WIDTH)
+
 #define ROW_ADDR_DEPENDENCY_CHECK_OPT_SELECT  0 // may need to increase the count of block info
 #define ROW_ADDR_DEPENDENCY_CHECK_OPT_RELEASE 1 // may need to decrease the count of block info
 
@@ -83,19 +86,55 @@ typedef struct _ROW_ADDR_DEPENDENCY_ENTRY
     unsigned int reserved0 : 3;
 } ROW_ADDR_DEPENDENCY_ENTRY, *P_ROW_ADDR_DEPENDENCY_ENTRY;
 
+/**
+ * @brief The completion info of a NVMe write command with FUA set.
+ *
+ * The Rx DMAs of a FUA write are issued without auto completion, and the command will be
+ * completed manually by `ReleaseFuaProgramReq()` once all of its programs are done.
+ */
+typedef struct _FUA_CMD_ENTRY
+{
+    unsigned short pendingProgCnt : 15; // number of slice programs not confirmed yet
+    unsigned short programFail : 1;     // 1 if any program of this command failed
+} FUA_CMD_ENTRY, *P_FUA_CMD_ENTRY;
+
+#define ROW_ADDR_DEP_BLOCK_NONE 0xffff
+
+/**
+ * @brief The requests blocked by the row address dependency of this block.
+ *
+ * The requests are linked through `prevReq` and `nextReq` in FIFO order. A block is put to
+ * the wake list of its die when one of its requests passes `CheckRowAddrDep()`, since that
+ * is the only way the dependency info of the block can be relaxed.
+ *
+ * @sa `PutToBlockedByRowAddrDepReqQ()`, `PutToRowAddrDepWakeList()`.
+ */
+typedef struct _ROW_ADDR_DEPENDENCY_QUEUE
+{
+    unsigned short headReq;       // the oldest request blocked on this block
+    unsigned short tailReq;       // the newest request blocked on this block
+    unsigned short nextWakeBlock; // the next block in the wake list of the die
+    unsigned short wakeFlag;      // 1 if this block is in the wake list of the die
+} ROW_ADDR_DEPENDENCY_QUEUE, *P_ROW_ADDR_DEPENDENCY_QUEUE;
+
 /**
  * @brief The row address dependency table for all the user blocks.
  *
- * @sa `ROW_ADDR_DEPENDENCY_ENTRY`.
+ * @sa `ROW_ADDR_DEPENDENCY_ENTRY`, `ROW_ADDR_DEPENDENCY_QUEUE`.
  */
 typedef struct _ROW_ADDR_DEPENDENCY_TABLE
 {
     ROW_ADDR_DEPENDENCY_ENTRY block[USER_CHANNELS][USER_WAYS][MAIN_BLOCKS_PER_DIE];
+    ROW_ADDR_DEPENDENCY_QUEUE blockedReqQ[USER_CHANNELS][USER_WAYS][MAIN_BLOCKS_PER_DIE];
 } ROW_ADDR_DEPENDENCY_TABLE, *P_ROW_ADDR_DEPENDENCY_TABLE;
 
 void InitDependencyTable();
-void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigned int nlb, unsigned int cmdCode);
+void ReqTransNvmeToSlice(unsigned int cmdSlotTag, unsigned int startLba, unsigned int nlb, unsigned int cmdCode,
+                         unsigned int seqHint, unsigned int fua);
 void ReqTransSliceToLowLevel();
+unsigned int ReqTransSliceToBypass(unsigned int reqSlotTag);
+void ReleaseFuaProgramReq(unsigned int reqSlotTag, unsigned int reqStatus);
+void FillDataBufEntry(unsigned int bufEntry);
 void IssueNvmeDmaReq(unsigned int reqSlotTag);
 void CheckDoneNvmeDmaReq();
 
@@ -104,11 +143,13 @@ void ReleaseBlockedByBufDepReq(unsigned int reqSlotTag);
 void ReleaseBlockedByRowAddrDepReq(unsigned int chNo, unsigned int wayNo);
 
 extern P_ROW_ADDR_DEPENDENCY_TABLE rowAddrDependencyTablePtr;
+extern FUA_CMD_ENTRY fuaCmdTable[NVME_CMD_SLOT_TAG_COUNT];
 
 /* -------------------------------------------------------------------------- */
 /*                     util macros for request scheduling                     */
 /* -------------------------------------------------------------------------- */
 
 #define ROW_ADDR_DEP_ENTRY(iCh, iWay, iBlk) (&rowAddrDependencyTablePtr->block[(iCh)][(iWay)][(iBlk)])
+#define ROW_ADDR_DEP_QUEUE(iCh, iWay, iBlk) (&rowAddrDependencyTablePtr->blockedReqQ[(iCh)][(iWay)][(iBlk)])
 
 #endif /* REQUEST_TRANSFORM_H_ */